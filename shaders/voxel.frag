@@ -2,13 +2,14 @@
 
 in vec3 vNormal;
 in vec2 vUV;
+flat in uint vLayer;
 in float vSunlight;
 in float vEmissive;
 
 out vec4 FragColor;
 
 uniform vec3 uLightDir;
-uniform sampler2D uTexture;
+uniform sampler2DArray uTexture;
 
 void main() {
     vec3 normal = normalize(vNormal);
@@ -17,7 +18,7 @@ void main() {
     float sunlight = clamp(vSunlight, 0.0, 1.0);
     float emissive = clamp(vEmissive, 0.0, 1.0);
 
-    vec3 baseColor = texture(uTexture, vUV).rgb;
+    vec3 baseColor = texture(uTexture, vec3(vUV, float(vLayer))).rgb;
     float ambient = mix(0.05, 0.2, sunlight);
     float diffuse = light * sunlight;
     vec3 litColor = baseColor * (ambient + diffuse * (1.0 - ambient));
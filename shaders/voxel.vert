@@ -1,13 +1,14 @@
 #version 450 core
 
 layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
-layout (location = 2) in vec2 aUV;
+layout (location = 1) in vec4 aNormal;
+layout (location = 2) in uint aLayer;
 layout (location = 3) in float aSunlight;
 layout (location = 4) in float aEmissive;
 
 out vec3 vNormal;
 out vec2 vUV;
+flat out uint vLayer;
 out float vSunlight;
 out float vEmissive;
 
@@ -15,8 +16,19 @@ uniform mat4 uView;
 uniform mat4 uProjection;
 
 void main() {
-    vNormal = aNormal;
-    vUV = aUV;
+    vec3 normal = aNormal.xyz;
+    // Project the position onto the face plane: one texture repeat per block, matching the old
+    // per-face UVs (X faces use zy, Y faces xz, Z faces xy).
+    vec3 axis = abs(normal);
+    if (axis.x >= axis.y && axis.x >= axis.z) {
+        vUV = aPos.zy;
+    } else if (axis.y >= axis.z) {
+        vUV = aPos.xz;
+    } else {
+        vUV = aPos.xy;
+    }
+    vNormal = normal;
+    vLayer = aLayer;
     vSunlight = aSunlight;
     vEmissive = aEmissive;
     gl_Position = uProjection * uView * vec4(aPos, 1.0);
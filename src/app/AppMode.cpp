@@ -15,20 +15,25 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
-#include "stb_image.h"
-
 #include "app/AppInput.h"
 #include "app/GameState.h"
 #include "app/MenuModel.h"
 #include "core/Profiler.h"
+#include "core/Trace.h"
 #include "core/WorkerPool.h"
 #include "game/Player.h"
 #include "math/Frustum.h"
 #include "persistence/ChunkStorage.h"
+#include "renderer/BlockTextures.h"
+#include "renderer/ChunkCuller.h"
 #include "renderer/DebugDraw.h"
+#include "renderer/FarTerrain.h"
+#include "renderer/MeshArena.h"
 #include "Shader.h"
 #include "voxel/BlockEdit.h"
+#include "voxel/BlockRegistry.h"
 #include "voxel/ChunkMesher.h"
+#include "voxel/ChunkPools.h"
 #include "voxel/ChunkRegistry.h"
 #include "voxel/ChunkStreaming.h"
 #include "voxel/ChunkBounds.h"
@@ -53,197 +58,16 @@ constexpr float kSmokeDeltaTime = 1.0f / 60.0f;
 constexpr int kWorkerThreadsDefault = 2;
 constexpr int kSmokeMenuWorldFrames = 60;
 constexpr std::string_view kWorldPrefix = "world_";
-const glm::vec3 kPlayerSpawn = []() {
-    const int surfaceHeight = voxel::GetSurfaceHeight(0, 0);
-    const int spawnY = std::clamp(surfaceHeight + 2, voxel::kWorldMinY + 2, voxel::kWorldMaxY - 2);
-    return glm::vec3(0.0f, static_cast<float>(spawnY), 0.0f);
-}();
 const glm::vec3 kEyeOffset(0.0f, 1.6f, 0.0f);
 
-GLuint CreateTextureFromPixels(int width, int height, const std::vector<std::uint8_t>& pixels) {
-    if (width <= 0 || height <= 0 || pixels.empty()) {
-        return 0;
-    }
-
-    GLuint texture = 0;
-    glad_glGenTextures(1, &texture);
-    glad_glBindTexture(GL_TEXTURE_2D, texture);
-    glad_glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
-    glad_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glad_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glad_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glad_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    return texture;
-}
-
-struct TexturePixels {
-    int width = 0;
-    int height = 0;
-    std::vector<std::uint8_t> pixels;
-    bool IsValid() const { return width > 0 && height > 0 && !pixels.empty(); }
-};
-
-std::vector<std::uint8_t> BuildProceduralDirtPixels(int width, int height) {
-    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u);
-    std::uint32_t state = 0x1234abcd;
-    auto nextRandom = [&state]() {
-        state = state * 1664525u + 1013904223u;
-        return state;
-    };
-
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            const std::uint32_t noiseSeed =
-                nextRandom() + static_cast<std::uint32_t>(x * 374761393u) + static_cast<std::uint32_t>(y * 668265263u);
-            const int noise = static_cast<int>((noiseSeed >> 24) & 0xFF) % 37 - 18;
-            int r = 110 + noise + static_cast<int>((noiseSeed >> 16) & 0xF) - 7;
-            int g = 80 + noise;
-            int b = 50 + noise + static_cast<int>((noiseSeed >> 12) & 0x7) - 3;
-            if (((noiseSeed >> 8) & 0xFF) < 15) {
-                r += 20;
-                g += 20;
-                b += 20;
-            }
-            r = std::clamp(r, 0, 255);
-            g = std::clamp(g, 0, 255);
-            b = std::clamp(b, 0, 255);
-
-            const std::size_t index = (static_cast<std::size_t>(y) * static_cast<std::size_t>(width) +
-                                       static_cast<std::size_t>(x)) *
-                                      4u;
-            pixels[index + 0] = static_cast<std::uint8_t>(r);
-            pixels[index + 1] = static_cast<std::uint8_t>(g);
-            pixels[index + 2] = static_cast<std::uint8_t>(b);
-            pixels[index + 3] = 255;
-        }
-    }
-    return pixels;
-}
-
-std::vector<std::uint8_t> BuildProceduralStonePixels(int width, int height) {
-    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u);
-    std::uint32_t state = 0x7f4a7c15u;
-    auto nextRandom = [&state]() {
-        state = state * 1103515245u + 12345u;
-        return state;
-    };
-
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            const std::uint32_t noiseSeed =
-                nextRandom() + static_cast<std::uint32_t>(x * 2654435761u) + static_cast<std::uint32_t>(y * 1013904223u);
-            const int noise = static_cast<int>((noiseSeed >> 24) & 0xFF) % 25 - 12;
-            int shade = 130 + noise;
-            shade = std::clamp(shade, 80, 200);
-            const std::size_t index = (static_cast<std::size_t>(y) * static_cast<std::size_t>(width) +
-                                       static_cast<std::size_t>(x)) *
-                                      4u;
-            pixels[index + 0] = static_cast<std::uint8_t>(shade);
-            pixels[index + 1] = static_cast<std::uint8_t>(shade);
-            pixels[index + 2] = static_cast<std::uint8_t>(shade);
-            pixels[index + 3] = 255;
-        }
-    }
-    return pixels;
-}
-
-TexturePixels LoadTexturePixels(const std::string& path) {
-    TexturePixels result;
-    int channels = 0;
-    stbi_uc* data = stbi_load(path.c_str(), &result.width, &result.height, &channels, 4);
-    if (!data) {
-        return result;
-    }
-    result.pixels.assign(data, data + (result.width * result.height * 4));
-    stbi_image_free(data);
-    return result;
-}
-
-GLuint LoadTexture2D(const std::string& path) {
-    int width = 0;
-    int height = 0;
-    int channels = 0;
-    stbi_uc* data = stbi_load(path.c_str(), &width, &height, &channels, 4);
-    if (!data) {
-        return 0;
-    }
-
-    std::vector<std::uint8_t> pixels(data, data + (width * height * 4));
-    stbi_image_free(data);
-    return CreateTextureFromPixels(width, height, pixels);
-}
-
-GLuint CreateBlockAtlasTexture() {
-    constexpr int kFallbackSize = 32;
-    TexturePixels dirt = LoadTexturePixels("textures/dirt.png");
-    if (!dirt.IsValid()) {
-        dirt.width = kFallbackSize;
-        dirt.height = kFallbackSize;
-        dirt.pixels = BuildProceduralDirtPixels(kFallbackSize, kFallbackSize);
-        std::cout << "[Texture] Using procedurally generated dirt texture.\n";
-    }
-
-    TexturePixels stone = LoadTexturePixels("textures/stone.png");
-    if (!stone.IsValid()) {
-        stone.width = kFallbackSize;
-        stone.height = kFallbackSize;
-        stone.pixels = BuildProceduralStonePixels(kFallbackSize, kFallbackSize);
-        std::cout << "[Texture] Using procedurally generated stone texture.\n";
-    }
-
-    if (dirt.width != stone.width || dirt.height != stone.height) {
-        std::cout << "[Texture] Mismatched block texture sizes, falling back to procedural 32x32 atlas.\n";
-        dirt.width = kFallbackSize;
-        dirt.height = kFallbackSize;
-        dirt.pixels = BuildProceduralDirtPixels(kFallbackSize, kFallbackSize);
-        stone.width = kFallbackSize;
-        stone.height = kFallbackSize;
-        stone.pixels = BuildProceduralStonePixels(kFallbackSize, kFallbackSize);
-    }
-
-    const int atlasWidth = dirt.width * 2;
-    const int atlasHeight = dirt.height;
-    std::vector<std::uint8_t> atlas(static_cast<std::size_t>(atlasWidth) * atlasHeight * 4u);
-
-    auto blit = [&](const TexturePixels& src, int dstX) {
-        for (int y = 0; y < src.height; ++y) {
-            for (int x = 0; x < src.width; ++x) {
-                const std::size_t srcIndex =
-                    (static_cast<std::size_t>(y) * src.width + static_cast<std::size_t>(x)) * 4u;
-                const std::size_t dstIndex =
-                    (static_cast<std::size_t>(y) * atlasWidth + static_cast<std::size_t>(x + dstX)) * 4u;
-                atlas[dstIndex + 0] = src.pixels[srcIndex + 0];
-                atlas[dstIndex + 1] = src.pixels[srcIndex + 1];
-                atlas[dstIndex + 2] = src.pixels[srcIndex + 2];
-                atlas[dstIndex + 3] = src.pixels[srcIndex + 3];
-            }
-        }
-    };
-
-    blit(dirt, 0);
-    blit(stone, dirt.width);
-    return CreateTextureFromPixels(atlasWidth, atlasHeight, atlas);
+glm::vec3 PlayerSpawn(const voxel::WorldGenerator& generator) {
+    const int surfaceHeight = generator.SurfaceHeight(0, 0);
+    const int spawnY = std::clamp(surfaceHeight + 2, voxel::kWorldMinY + 2, voxel::kWorldMaxY - 2);
+    return glm::vec3(0.0f, static_cast<float>(spawnY), 0.0f);
 }
 
 const char* BlockLabel(voxel::BlockId id) {
-    switch (id) {
-    case voxel::kBlockStone:
-        return "Stone";
-    case voxel::kBlockDirt:
-        return "Dirt";
-    case voxel::kBlockTorch:
-        return "Torch";
-    case voxel::kBlockLava:
-        return "Lava";
-    case voxel::kBlockAir:
-    default:
-        return "Air";
-    }
-}
-
-GLuint CreateProceduralDirtTexture(int width, int height) {
-    auto pixels = BuildProceduralDirtPixels(width, height);
-    return CreateTextureFromPixels(width, height, pixels);
+    return voxel::BlockRegistry::Default().Get(id).name.c_str();
 }
 
 std::string FormatWorldId(std::time_t timestamp) {
@@ -276,10 +100,12 @@ bool WorldHasChunkFiles(const std::filesystem::path& root) {
 struct AppMode::WorldRuntime {
     explicit WorldRuntime(const std::filesystem::path& storageRoot, int workerThreads)
         : chunkStorage(storageRoot),
+          chunkRegistry(chunkStorage.ResolveWorldGen({})),
           streaming(BuildStreamingConfig(workerThreads)),
-          player(kPlayerSpawn) {
+          player(PlayerSpawn(chunkRegistry.Generator())) {
         chunkRegistry.SetStorage(&chunkStorage);
         streaming.SetStorage(&chunkStorage);
+        streaming.SetMeshStore(&meshArena);
         streaming.SetProfiler(&profiler);
         StartWorkers(workerThreads);
     }
@@ -290,7 +116,6 @@ struct AppMode::WorldRuntime {
         config.loadRadius = kLoadRadiusDefault;
         config.maxChunkCreatesPerFrame = 3;
         config.maxChunkMeshesPerFrame = 2;
-        config.maxGpuUploadsPerFrame = 3;
         config.workerThreads = workerThreads;
         return config;
     }
@@ -315,7 +140,9 @@ struct AppMode::WorldRuntime {
     }
 
     persistence::ChunkStorage chunkStorage;
+    renderer::MeshArena meshArena;
     voxel::ChunkRegistry chunkRegistry;
+    renderer::FarTerrain farTerrain{chunkRegistry.Generator(), meshArena};
     voxel::ChunkMesher mesher;
     voxel::ChunkStreaming streaming;
     core::Profiler profiler;
@@ -344,12 +171,19 @@ struct AppMode::WorldRuntime {
     bool statsPrintTogglePressed = false;
     bool frustumTogglePressed = false;
     bool distanceTogglePressed = false;
+    bool occlusionTogglePressed = false;
+    bool farTerrainTogglePressed = false;
+    bool traceDumpPressed = false;
     bool spacePressed = false;
 #ifndef NDEBUG
     bool resetPressed = false;
 #endif
     bool frustumCullingEnabled = true;
     bool distanceCullingEnabled = true;
+    bool occlusionCullingEnabled = true;
+    bool farTerrainEnabled = true;
+    renderer::ChunkCuller chunkCuller;
+    std::vector<std::uint32_t> visibleChunks;
     bool statsTitleEnabled = true;
     bool statsPrintEnabled = false;
 
@@ -361,6 +195,8 @@ struct AppMode::WorldRuntime {
     std::size_t lastDrawnChunks = 0;
     std::size_t lastFrustumCulled = 0;
     std::size_t lastDistanceCulled = 0;
+    std::size_t lastOcclusionCulled = 0;
+    renderer::ChunkCullResult lastCull;
     std::size_t lastDrawCalls = 0;
     std::size_t lastGpuReadyChunks = 0;
     std::size_t lastGeneratedChunks = 0;
@@ -438,9 +274,9 @@ void AppMode::InitializeShaders() {
 }
 
 void AppMode::InitializeTextures() {
-    blockTexture_ = CreateBlockAtlasTexture();
+    blockTexture_ = renderer::CreateBlockTextureArray(voxel::BlockRegistry::Default());
     if (blockTexture_ == 0) {
-        initError_ = "[Texture] Failed to create block atlas texture.";
+        initError_ = "[Texture] Failed to create block texture array.";
         initialized_ = false;
     }
 }
@@ -626,7 +462,7 @@ void AppMode::StartNewWorld(const std::string& worldId) {
     world_->lastStatsPrint = world_->fpsTimer - std::chrono::seconds(5);
     world_->lastClampLogTime = world_->fpsTimer - std::chrono::seconds(1);
 
-    gCamera.setPosition(kPlayerSpawn + kEyeOffset);
+    gCamera.setPosition(PlayerSpawn(world_->chunkRegistry.Generator()) + kEyeOffset);
     loadMissing_ = false;
     SetState(GameState::Playing);
 }
@@ -653,6 +489,7 @@ void AppMode::StopWorldAndReturnToMenu() {
     if (saved > 0) {
         std::cout << "[Storage] Saved " << saved << " dirty chunk(s).\n";
     }
+    world_->streaming.ClearCache(world_->chunkRegistry);
     world_->chunkRegistry.DestroyAll();
     world_.reset();
     SetState(GameState::MainMenu);
@@ -737,6 +574,7 @@ void AppMode::TickWorld(float deltaTime, const std::chrono::steady_clock::time_p
     if (!world_) {
         return;
     }
+    core::ScopedTimer frameTimer(&world_->profiler, core::Metric::Frame);
 
     glm::vec3 desiredDir(0.0f);
     bool jumpPressed = false;
@@ -838,6 +676,39 @@ void AppMode::TickWorld(float deltaTime, const std::chrono::steady_clock::time_p
             world_->distanceTogglePressed = false;
         }
 
+        int occlusionToggleState = glfwGetKey(window_, GLFW_KEY_F7);
+        if (occlusionToggleState == GLFW_PRESS && !world_->occlusionTogglePressed) {
+            world_->occlusionTogglePressed = true;
+            world_->occlusionCullingEnabled = !world_->occlusionCullingEnabled;
+            std::cout << "[Culling] Occlusion culling " << (world_->occlusionCullingEnabled ? "enabled" : "disabled")
+                      << ".\n";
+        } else if (occlusionToggleState == GLFW_RELEASE) {
+            world_->occlusionTogglePressed = false;
+        }
+
+        int farTerrainToggleState = glfwGetKey(window_, GLFW_KEY_F8);
+        if (farTerrainToggleState == GLFW_PRESS && !world_->farTerrainTogglePressed) {
+            world_->farTerrainTogglePressed = true;
+            world_->farTerrainEnabled = !world_->farTerrainEnabled;
+            if (!world_->farTerrainEnabled) {
+                world_->farTerrain.Clear();
+            }
+            std::cout << "[Far] Far terrain " << (world_->farTerrainEnabled ? "enabled" : "disabled") << ".\n";
+        } else if (farTerrainToggleState == GLFW_RELEASE) {
+            world_->farTerrainTogglePressed = false;
+        }
+
+        int traceDumpState = glfwGetKey(window_, GLFW_KEY_F9);
+        if (traceDumpState == GLFW_PRESS && !world_->traceDumpPressed) {
+            world_->traceDumpPressed = true;
+            std::string traceError;
+            if (!core::Tracer::Global().WriteChromeJsonFile(core::NextTraceDumpPath(), traceError)) {
+                std::cerr << "[Trace] " << traceError << '\n';
+            }
+        } else if (traceDumpState == GLFW_RELEASE) {
+            world_->traceDumpPressed = false;
+        }
+
         if (gMouseCaptured) {
             float yawRadians = glm::radians(gCamera.getYaw());
             glm::vec3 forward(std::cos(yawRadians), 0.0f, std::sin(yawRadians));
@@ -875,7 +746,7 @@ void AppMode::TickWorld(float deltaTime, const std::chrono::steady_clock::time_p
         int resetState = glfwGetKey(window_, GLFW_KEY_R);
         if (resetState == GLFW_PRESS && !world_->resetPressed) {
             world_->resetPressed = true;
-            world_->player.SetPosition(kPlayerSpawn);
+            world_->player.SetPosition(PlayerSpawn(world_->chunkRegistry.Generator()));
             world_->player.ResetVelocity();
             std::cout << "[Debug] Player reset to spawn.\n";
         } else if (resetState == GLFW_RELEASE) {
@@ -906,7 +777,9 @@ void AppMode::TickWorld(float deltaTime, const std::chrono::steady_clock::time_p
         world_->crosshairDraw.Clear();
     }
 
-    world_->projection = glm::perspective(glm::radians(kFov), aspect, 0.1f, 500.0f);
+    const float farPlane =
+        world_->farTerrainEnabled ? std::max(500.0f, world_->farTerrain.ViewDistance()) : 500.0f;
+    world_->projection = glm::perspective(glm::radians(kFov), aspect, 0.1f, farPlane);
     world_->view = gCamera.getViewMatrix();
     world_->frustum = Frustum::FromMatrix(world_->projection * world_->view);
     world_->lightDir = glm::normalize(glm::vec3(-0.4f, -1.0f, -0.3f));
@@ -971,7 +844,7 @@ void AppMode::TickWorld(float deltaTime, const std::chrono::steady_clock::time_p
     shader_.setVec3("uLightDir", world_->lightDir);
     shader_.setInt("uTexture", 0);
     glad_glActiveTexture(GL_TEXTURE0);
-    glad_glBindTexture(GL_TEXTURE_2D, blockTexture_);
+    glad_glBindTexture(GL_TEXTURE_2D_ARRAY, blockTexture_);
 
     glm::vec3 playerPosition = world_->player.Position();
     voxel::WorldBlockCoord playerBlock{
@@ -980,43 +853,53 @@ void AppMode::TickWorld(float deltaTime, const std::chrono::steady_clock::time_p
         static_cast<int>(std::floor(playerPosition.z))};
     voxel::ChunkCoord playerChunk = voxel::WorldToChunkCoord(playerBlock, voxel::kChunkSize);
 
+    world_->meshArena.BeginFrame();
     if (updateStreaming) {
+        world_->streaming.SetWorkerIdleRatio(world_->workerPool.SampleIdleRatio());
+        world_->streaming.SetMotion(voxel::StreamingMotion{world_->player.Velocity(), gCamera.getFront()});
         world_->streaming.Tick(playerChunk, world_->chunkRegistry, world_->mesher);
         world_->workerPool.NotifyWork();
     }
 
     std::size_t distanceCulled = 0;
     std::size_t frustumCulled = 0;
+    std::size_t occlusionCulled = 0;
     std::size_t drawn = 0;
 
     const int renderRadiusChunks = world_->streaming.RenderRadius();
 
-    world_->chunkRegistry.ForEachEntry([&](const voxel::ChunkCoord& coord,
-                                           const std::shared_ptr<voxel::ChunkEntry>& entry) {
-        if (entry->gpuState.load(std::memory_order_acquire) != voxel::GpuState::Uploaded) {
-            return;
-        }
-
-        if (world_->distanceCullingEnabled) {
-            const int dx = std::abs(coord.x - playerChunk.x);
-            const int dz = std::abs(coord.z - playerChunk.z);
-            if (std::max(dx, dz) > renderRadiusChunks) {
-                ++distanceCulled;
-                return;
-            }
-        }
-
-        if (world_->frustumCullingEnabled) {
-            const voxel::ChunkBounds bounds = voxel::GetChunkBounds(coord);
-            if (!world_->frustum.IntersectsAabb(bounds.min, bounds.max)) {
-                ++frustumCulled;
-                return;
-            }
-        }
-
-        entry->mesh.Draw();
+    const glm::vec3 eye = gCamera.getPosition();
+    const std::vector<renderer::RenderChunk>& renderChunks = world_->streaming.RenderList().Chunks();
+
+    renderer::ChunkCullOptions cullOptions;
+    cullOptions.distance = world_->distanceCullingEnabled;
+    cullOptions.frustum = world_->frustumCullingEnabled;
+    cullOptions.occlusion = world_->occlusionCullingEnabled;
+    cullOptions.renderRadius = renderRadiusChunks;
+    cullOptions.verticalRadius = world_->streaming.Config().verticalRadius + 1;
+    cullOptions.playerChunk = playerChunk;
+    cullOptions.eye = eye;
+    const renderer::ChunkCullResult cull =
+        world_->chunkCuller.Cull(world_->streaming.RenderList(), world_->frustum, cullOptions, world_->visibleChunks);
+    world_->lastCull = cull;
+    distanceCulled = cull.distanceCulled;
+    frustumCulled = cull.frustumCulled;
+    occlusionCulled = cull.occlusionCulled;
+
+    world_->meshArena.BeginBatch();
+    for (std::uint32_t index : world_->visibleChunks) {
+        const renderer::RenderChunk& chunk = renderChunks[index];
+        chunk.entry->mesh.QueueDraw(voxel::FacingDirectionMask(voxel::GetChunkBounds(chunk.coord), eye));
         ++drawn;
-    });
+    }
+    if (world_->farTerrainEnabled) {
+        // The hole follows whatever the chunk pass can draw, so the two never overlap.
+        world_->farTerrain.Update(playerChunk, world_->distanceCullingEnabled
+                                                   ? renderRadiusChunks
+                                                   : world_->streaming.Config().loadRadius);
+        world_->farTerrain.QueueVisible(world_->frustum);
+    }
+    const std::size_t drawCalls = world_->meshArena.SubmitBatch();
 
     if (world_->debugDraw.HasGeometry()) {
         debugShader_.use();
@@ -1035,6 +918,7 @@ void AppMode::TickWorld(float deltaTime, const std::chrono::steady_clock::time_p
         world_->crosshairDraw.Draw();
         glEnable(GL_DEPTH_TEST);
     }
+    world_->meshArena.EndFrame();
 
     const voxel::ChunkStreamingStats& streamStats = world_->streaming.Stats();
     world_->lastLoadedChunks = streamStats.loadedChunks;
@@ -1050,7 +934,8 @@ void AppMode::TickWorld(float deltaTime, const std::chrono::steady_clock::time_p
     world_->lastDrawnChunks = drawn;
     world_->lastFrustumCulled = frustumCulled;
     world_->lastDistanceCulled = distanceCulled;
-    world_->lastDrawCalls = drawn;
+    world_->lastOcclusionCulled = occlusionCulled;
+    world_->lastDrawCalls = drawCalls;
     world_->lastWorkerThreads = streamStats.workerThreads;
 
     if (updateTitle) {
@@ -1079,8 +964,10 @@ void AppMode::TickWorld(float deltaTime, const std::chrono::steady_clock::time_p
             }
 
             if (world_->statsTitleEnabled) {
-                title << " | frame " << ms(core::Metric::Frame)
-                      << "ms | upd " << ms(core::Metric::Update)
+                const core::LatencyPercentiles& frameLatency = snapshot.latency[metricIndex(core::Metric::Frame)];
+                title << " | frame " << ms(core::Metric::Frame) << "ms (p99 " << frameLatency.p99Ms << " max "
+                      << frameLatency.maxMs << ")"
+                      << " | upd " << ms(core::Metric::Update)
                       << "ms | up " << ms(core::Metric::Upload)
                       << "ms | rnd " << ms(core::Metric::Render) << "ms";
 
@@ -1095,7 +982,8 @@ void AppMode::TickWorld(float deltaTime, const std::chrono::steady_clock::time_p
                       << " | GPU: " << world_->lastGpuReadyChunks
                       << " | Q: " << world_->lastCreateQueue << "/" << world_->lastMeshQueue << "/"
                       << world_->lastUploadQueue
-                      << " | Drawn: " << world_->lastDrawnChunks;
+                      << " | Drawn: " << world_->lastDrawnChunks
+                      << " | Draws: " << world_->lastDrawCalls;
             }
 
             if (!world_->statsTitleEnabled) {
@@ -1110,6 +998,8 @@ void AppMode::TickWorld(float deltaTime, const std::chrono::steady_clock::time_p
             if (world_->statsPrintEnabled) {
                 std::chrono::duration<double> printElapsed = now - world_->lastStatsPrint;
                 if (printElapsed.count() >= 5.0) {
+                    const double memoryMiB =
+                        static_cast<double>(world_->streaming.Stats().memory.totalBytes) / (1024.0 * 1024.0);
                     std::ostringstream perfLine;
                     perfLine << "[Perf] fps " << std::fixed << std::setprecision(1) << fps
                              << " frame " << ms(core::Metric::Frame) << "ms"
@@ -1124,8 +1014,22 @@ void AppMode::TickWorld(float deltaTime, const std::chrono::steady_clock::time_p
                              << " loaded " << world_->lastLoadedChunks
                              << " gpu " << world_->lastGpuReadyChunks
                              << " q " << world_->lastCreateQueue << "/" << world_->lastMeshQueue << "/"
-                             << world_->lastUploadQueue;
+                             << world_->lastUploadQueue
+                             << " drawn " << world_->lastDrawnChunks << " draws " << world_->lastDrawCalls
+                             << " cull d/f/o " << world_->lastDistanceCulled << "/" << world_->lastFrustumCulled
+                             << "/" << world_->lastOcclusionCulled
+                             << " mem " << std::setprecision(1) << memoryMiB << "MiB";
                     std::cout << perfLine.str() << '\n';
+                    std::cout << voxel::DescribePools(world_->chunkRegistry.Pools()) << '\n';
+                    std::cout << renderer::DescribeArena(world_->meshArena.Stats()) << '\n';
+                    std::cout << renderer::DescribeLodRings(world_->lastCull) << '\n';
+                    std::cout << voxel::DescribeUploads(world_->streaming.Stats()) << '\n';
+                    std::cout << voxel::DescribeBudgets(world_->streaming.Stats()) << '\n';
+                    std::cout << voxel::DescribeCache(world_->streaming.Stats()) << '\n';
+                    std::cout << voxel::DescribePipeline(world_->streaming.Stats()) << '\n';
+                    std::cout << renderer::DescribeFarTerrain(world_->farTerrain.Stats()) << '\n';
+                    std::cout << core::DescribeLatency(snapshot) << '\n';
+                    std::cout << core::DescribeMemory(world_->streaming.Stats().memory) << '\n';
                     world_->lastStatsPrint = now;
                 }
             }
@@ -0,0 +1,166 @@
+#include "bench/BenchHarness.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace bench {
+
+namespace {
+
+std::string FormatNs(double ns) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(ns < 100.0 ? 2 : 1);
+    if (ns >= 1.0e6) {
+        out << ns / 1.0e6 << " ms";
+    } else if (ns >= 1.0e3) {
+        out << ns / 1.0e3 << " us";
+    } else {
+        out << ns << " ns";
+    }
+    return out.str();
+}
+
+// Value of "key": in one line of our own output; strings are returned without quotes.
+bool FindField(const std::string& line, const std::string& key, std::string& value) {
+    const std::string pattern = "\"" + key + "\":";
+    const std::size_t start = line.find(pattern);
+    if (start == std::string::npos) {
+        return false;
+    }
+    std::size_t begin = start + pattern.size();
+    if (begin < line.size() && line[begin] == '"') {
+        const std::size_t end = line.find('"', begin + 1);
+        if (end == std::string::npos) {
+            return false;
+        }
+        value = line.substr(begin + 1, end - begin - 1);
+        return true;
+    }
+    const std::size_t end = line.find_first_of(",}", begin);
+    value = line.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+    return !value.empty();
+}
+
+} // namespace
+
+std::vector<BenchResult> RunBenches(const std::vector<BenchCase>& cases, const BenchConfig& config) {
+    std::vector<BenchResult> results;
+    const int iterations = std::max(1, config.iterations);
+    std::vector<double> samples;
+    for (const BenchCase& benchCase : cases) {
+        if (!config.filter.empty() && benchCase.name.find(config.filter) == std::string::npos) {
+            continue;
+        }
+        for (int i = 0; i < config.warmupIterations; ++i) {
+            if (benchCase.setup) {
+                benchCase.setup();
+            }
+            benchCase.body();
+        }
+        samples.clear();
+        for (int i = 0; i < iterations; ++i) {
+            if (benchCase.setup) {
+                benchCase.setup();
+            }
+            const auto start = std::chrono::steady_clock::now();
+            benchCase.body();
+            const auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        std::sort(samples.begin(), samples.end());
+
+        BenchResult result;
+        result.name = benchCase.name;
+        result.opsPerIteration = std::max<std::uint64_t>(1, benchCase.opsPerIteration);
+        result.iterations = iterations;
+        result.minNs = samples.front();
+        result.medianNs = samples[samples.size() / 2];
+        std::cout << "[Bench] " << std::left << std::setw(24) << result.name << " min " << std::setw(10)
+                  << FormatNs(result.minNs) << " median " << std::setw(10) << FormatNs(result.medianNs) << " | "
+                  << FormatNs(result.MinNsPerOp()) << "/op (" << result.opsPerIteration << " ops)\n";
+        results.push_back(result);
+    }
+    return results;
+}
+
+void WriteJson(std::ostream& out, const std::vector<BenchResult>& results, const core::MemorySnapshot& memory) {
+    out << "{\"benchmarks\":[";
+    out << std::fixed << std::setprecision(3);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& result = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "{\"name\":\"" << result.name << "\",\"iterations\":" << result.iterations
+            << ",\"ops\":" << result.opsPerIteration << ",\"min_ns\":" << result.minNs
+            << ",\"median_ns\":" << result.medianNs << ",\"min_ns_per_op\":" << result.MinNsPerOp()
+            << ",\"median_ns_per_op\":" << result.MedianNsPerOp() << '}';
+    }
+    out << "\n],\"memory\":[";
+    for (std::size_t i = 0; i < core::kMemoryCategoryCount; ++i) {
+        out << (i == 0 ? "\n" : ",\n") << "{\"category\":\""
+            << core::MemoryCategoryName(static_cast<core::MemoryCategory>(i)) << "\",\"bytes\":" << memory.bytes[i]
+            << ",\"peak_bytes\":" << memory.peakBytes[i] << '}';
+    }
+    out << ",\n{\"category\":\"total\",\"bytes\":" << memory.totalBytes << ",\"peak_bytes\":" << memory.peakTotalBytes
+        << "}\n]}\n";
+}
+
+bool ReadBaselineJson(const std::string& path, std::map<std::string, double>& minNsPerOp, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "Failed to open baseline " + path;
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        std::string name;
+        std::string value;
+        if (!FindField(line, "name", name) || !FindField(line, "min_ns_per_op", value)) {
+            continue;
+        }
+        try {
+            minNsPerOp[name] = std::stod(value);
+        } catch (const std::exception&) {
+            error = "Bad min_ns_per_op for " + name + " in " + path;
+            return false;
+        }
+    }
+    if (minNsPerOp.empty()) {
+        error = "No benchmarks found in baseline " + path;
+        return false;
+    }
+    return true;
+}
+
+bool CompareWithBaseline(const std::vector<BenchResult>& results, const std::map<std::string, double>& baseline,
+                         double thresholdPercent) {
+    bool ok = true;
+    std::cout << "+--------------------------+------------+------------+---------+\n";
+    std::cout << "| Case                     | Baseline   | Current    | Change  |\n";
+    std::cout << "+--------------------------+------------+------------+---------+\n";
+    for (const BenchResult& result : results) {
+        const auto it = baseline.find(result.name);
+        std::ostringstream change;
+        std::string verdict;
+        if (it == baseline.end() || it->second <= 0.0) {
+            change << "new";
+        } else {
+            const double percent = (result.MinNsPerOp() / it->second - 1.0) * 100.0;
+            change << std::showpos << std::fixed << std::setprecision(1) << percent << '%';
+            if (percent > thresholdPercent) {
+                verdict = " REGRESSION";
+                ok = false;
+            }
+        }
+        std::cout << "| " << std::left << std::setw(25) << result.name << "| " << std::setw(11)
+                  << (it == baseline.end() ? std::string("-") : FormatNs(it->second)) << "| " << std::setw(11)
+                  << FormatNs(result.MinNsPerOp()) << "| " << std::setw(8) << change.str() << '|' << verdict
+                  << '\n';
+    }
+    std::cout << "+--------------------------+------------+------------+---------+\n";
+    return ok;
+}
+
+} // namespace bench
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "core/MemoryLedger.h"
+
+namespace bench {
+
+struct BenchConfig {
+    int warmupIterations = 3;
+    int iterations = 15;
+    std::string filter; // substring of the case name; empty runs everything
+};
+
+struct BenchResult {
+    std::string name;
+    std::uint64_t opsPerIteration = 1;
+    int iterations = 0;
+    double minNs = 0.0;    // fastest iteration
+    double medianNs = 0.0; // median iteration
+    double MinNsPerOp() const { return minNs / static_cast<double>(opsPerIteration); }
+    double MedianNsPerOp() const { return medianNs / static_cast<double>(opsPerIteration); }
+};
+
+// A body performs opsPerIteration operations per call. Setup runs before every timed call, untimed, so
+// bodies that consume state (queues, fresh coordinates) start from the same point each iteration.
+struct BenchCase {
+    std::string name;
+    std::uint64_t opsPerIteration = 1;
+    std::function<void()> body;
+    std::function<void()> setup;
+};
+
+// Runs the cases matching config.filter in order and prints one line per case.
+std::vector<BenchResult> RunBenches(const std::vector<BenchCase>& cases, const BenchConfig& config);
+
+// One benchmark object per line so ReadBaselineJson can parse it back without a JSON library, followed by
+// a "memory" array with the current and peak bytes of each MemoryLedger category.
+void WriteJson(std::ostream& out, const std::vector<BenchResult>& results, const core::MemorySnapshot& memory);
+
+// Reads min ns/op per case name from a file written by WriteJson.
+bool ReadBaselineJson(const std::string& path, std::map<std::string, double>& minNsPerOp, std::string& error);
+
+// Compares min ns/op (the least noisy statistic on a shared machine) against the baseline; prints a
+// table and returns false if any case got slower by more than thresholdPercent. Cases missing from
+// the baseline are reported but never fail.
+bool CompareWithBaseline(const std::vector<BenchResult>& results, const std::map<std::string, double>& baseline,
+                         double thresholdPercent);
+
+} // namespace bench
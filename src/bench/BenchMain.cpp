@@ -0,0 +1,359 @@
+// mineclone_bench: microbenchmarks for the voxel hot paths. Runs headless; nothing here touches GL.
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "bench/BenchHarness.h"
+#include "bench/FlightBench.h"
+#include "core/Assert.h"
+#include "core/MemoryLedger.h"
+#include "core/MpmcQueue.h"
+#include "core/ThreadSafeQueue.h"
+#include "persistence/ChunkStorage.h"
+#include "physics/VoxelCollision.h"
+#include "voxel/Chunk.h"
+#include "voxel/ChunkJobs.h"
+#include "voxel/ChunkMesher.h"
+#include "voxel/ChunkRegistry.h"
+#include "voxel/Raycast.h"
+#include "voxel/VoxelCoords.h"
+#include "voxel/WorldGen.h"
+
+namespace {
+
+struct BenchOptions {
+    bench::BenchConfig config;
+    std::string jsonPath;
+    std::string baselinePath;
+    double thresholdPercent = 10.0;
+    double flightSeconds = 0.0;
+    bool help = false;
+};
+
+// Results feed this so the optimizer cannot drop the measured work.
+volatile std::uint64_t g_sink = 0;
+
+void Consume(std::uint64_t value) {
+    g_sink = g_sink + value;
+}
+
+std::string Usage(const char* argv0) {
+    std::ostringstream out;
+    out << "Usage: " << argv0 << " [options]\n"
+        << "  --filter <text>       Run only cases whose name contains text\n"
+        << "  --iterations <n>      Timed iterations per case (default 15)\n"
+        << "  --warmup <n>          Untimed iterations per case (default 3)\n"
+        << "  --json <path>         Write results as JSON\n"
+        << "  --baseline <path>     Compare min ns/op with a previous --json file\n"
+        << "  --threshold <pct>     Slowdown that counts as a regression (default 10)\n"
+        << "  --flight <seconds>    Fly through streamed terrain with prefetch off and on instead\n"
+        << "  --help                Show this help\n";
+    return out.str();
+}
+
+bool ParseNumber(const std::string& text, double& value) {
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtod(text.c_str(), &end);
+    return !text.empty() && errno == 0 && end != text.c_str() && *end == '\0';
+}
+
+bool ParseOptions(int argc, char** argv, BenchOptions& options, std::string& error) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            options.help = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            error = arg.rfind("--", 0) == 0 ? "Missing value for " + arg : "Unknown argument: " + arg;
+            return false;
+        }
+        const std::string value = argv[++i];
+        double number = 0.0;
+        if (arg == "--filter") {
+            options.config.filter = value;
+        } else if (arg == "--json") {
+            options.jsonPath = value;
+        } else if (arg == "--baseline") {
+            options.baselinePath = value;
+        } else if (arg == "--iterations" || arg == "--warmup") {
+            if (!ParseNumber(value, number) || number < (arg == "--iterations" ? 1.0 : 0.0) || number > 1.0e6) {
+                error = "Invalid value for " + arg + ": " + value;
+                return false;
+            }
+            (arg == "--iterations" ? options.config.iterations : options.config.warmupIterations) =
+                static_cast<int>(number);
+        } else if (arg == "--threshold") {
+            if (!ParseNumber(value, number) || number < 0.0) {
+                error = "Invalid value for --threshold: " + value;
+                return false;
+            }
+            options.thresholdPercent = number;
+        } else if (arg == "--flight") {
+            if (!ParseNumber(value, number) || number <= 0.0 || number > 600.0) {
+                error = "Invalid value for --flight: " + value;
+                return false;
+            }
+            options.flightSeconds = number;
+        } else {
+            error = "Unknown argument: " + arg;
+            return false;
+        }
+    }
+    return true;
+}
+
+void LoadGenerated(voxel::ChunkRegistry& registry, const voxel::ChunkCoord& coord) {
+    auto entry = registry.GetOrCreateEntry(coord);
+    auto chunk = registry.Pools().chunks.Acquire();
+    registry.GenerateChunkData(coord, *chunk);
+    std::unique_lock<std::shared_mutex> lock(entry->dataMutex);
+    entry->chunk = std::move(chunk);
+    entry->generationState.store(voxel::GenerationState::Ready, std::memory_order_release);
+    entry->dirty.store(false, std::memory_order_release);
+}
+
+// Deterministic values in [0, 1) so every run measures the same work.
+float Hash01(std::uint32_t value) {
+    value ^= value >> 16;
+    value *= 0x7feb352dU;
+    value ^= value >> 15;
+    value *= 0x846ca68bU;
+    value ^= value >> 16;
+    return static_cast<float>(value & 0xffffffU) / static_cast<float>(0x1000000);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    using namespace voxel;
+
+    BenchOptions options;
+    std::string error;
+    if (!ParseOptions(argc, argv, options, error)) {
+        std::cerr << "[Bench] " << error << "\n" << Usage(argv[0]);
+        return 2;
+    }
+    if (options.help) {
+        std::cout << Usage(argv[0]);
+        return 0;
+    }
+    if (options.flightSeconds > 0.0) {
+        // The flight uploads meshes from this thread like the game loop does.
+        core::InitMainThread();
+        bench::FlightConfig flight;
+        flight.seconds = options.flightSeconds;
+        flight.prefetch = false;
+        const bench::FlightResult off = bench::RunFlight(flight);
+        std::cout << bench::DescribeFlight(off, flight) << '\n';
+        flight.prefetch = true;
+        const bench::FlightResult on = bench::RunFlight(flight);
+        std::cout << bench::DescribeFlight(on, flight) << '\n';
+        if (off.holesPerSecond > 0.0) {
+            std::cout << "[Flight] Prefetch changed visible holes per second by " << std::fixed
+                      << std::setprecision(1) << (on.holesPerSecond / off.holesPerSecond - 1.0) * 100.0 << "%.\n";
+        }
+        return 0;
+    }
+
+    // A 3x3 block of columns around the origin, fully generated; the centre chunk holds the surface.
+    ChunkRegistry registry;
+    const int surface = registry.Generator().SurfaceHeight(kChunkSize / 2, kChunkSize / 2);
+    const int minChunkY = WorldToChunkCoord(WorldBlockCoord{0, kWorldMinY, 0}, kChunkSize).y;
+    const int maxChunkY = WorldToChunkCoord(WorldBlockCoord{0, kWorldMaxY, 0}, kChunkSize).y;
+    std::vector<ChunkCoord> loaded;
+    for (int y = minChunkY; y <= maxChunkY; ++y) {
+        for (int z = -1; z <= 1; ++z) {
+            for (int x = -1; x <= 1; ++x) {
+                loaded.push_back(ChunkCoord{x, y, z});
+                LoadGenerated(registry, loaded.back());
+            }
+        }
+    }
+    const ChunkCoord center = WorldToChunkCoord(WorldBlockCoord{0, surface, 0}, kChunkSize);
+    registry.EnsureLightForNeighborhood(center);
+
+    const ChunkMesher mesher;
+    ChunkMeshCpu mesh;
+
+    int nextColumn = 1000;
+
+    std::vector<std::pair<glm::vec3, glm::vec3>> rays;
+    std::vector<physics::Aabb> boxes;
+    std::vector<WorldBlockCoord> blocks;
+    for (std::uint32_t i = 0; i < 4096; ++i) {
+        const float x = (Hash01(i * 3U) * 3.0f - 1.5f) * static_cast<float>(kChunkSize);
+        const float z = (Hash01(i * 3U + 1U) * 3.0f - 1.5f) * static_cast<float>(kChunkSize);
+        const float y = static_cast<float>(surface) + Hash01(i * 3U + 2U) * 8.0f - 4.0f;
+        if (i < 256) {
+            const float angle = Hash01(i * 7U) * 6.2831853f;
+            rays.emplace_back(glm::vec3{x, static_cast<float>(surface + 6), z},
+                              glm::normalize(glm::vec3{std::cos(angle), -0.6f, std::sin(angle)}));
+        }
+        boxes.push_back(physics::Aabb{glm::vec3{x - 0.3f, y, z - 0.3f}, glm::vec3{x + 0.3f, y + 1.8f, z + 0.3f}});
+        blocks.push_back(WorldBlockCoord{static_cast<int>(std::floor(x)), static_cast<int>(std::floor(y)),
+                                         static_cast<int>(std::floor(z))});
+    }
+
+    const std::filesystem::path storageRoot = std::filesystem::temp_directory_path() / "mineclone_bench";
+    std::error_code ec;
+    std::filesystem::remove_all(storageRoot, ec);
+    persistence::ChunkStorage storage(storageRoot);
+    storage.SetLogSuccess(false);
+    const std::size_t storageChunks = 16;
+    Chunk scratch;
+
+    core::ThreadSafeQueue<GenerateJob> lockedQueue;
+    core::MpmcQueue<GenerateJob> ringQueue(4096);
+    const std::size_t queueItems = 4096;
+
+    std::vector<bench::BenchCase> cases;
+    cases.push_back({"generate_column", static_cast<std::uint64_t>(maxChunkY - minChunkY + 1), [&] {
+                         // A column the cache has never seen: the first chunk pays for the heights.
+                         ++nextColumn;
+                         for (int y = minChunkY; y <= maxChunkY; ++y) {
+                             registry.GenerateChunkData(ChunkCoord{nextColumn, y, 7}, scratch);
+                             Consume(scratch.Get(0, 0, 0));
+                         }
+                     },
+                     nullptr});
+    cases.push_back({"rebuild_light", 1, [&] { registry.RebuildLightForChunk(center); }, nullptr});
+    cases.push_back({"build_mesh", 1, [&] {
+                         auto handle = registry.AcquireChunkRead(center);
+                         mesh.Clear();
+                         mesher.BuildMesh(center, *handle->chunk, registry, mesh);
+                         Consume(mesh.indices.size());
+                     },
+                     nullptr});
+    cases.push_back({"build_lod_mesh", 1, [&] {
+                         auto handle = registry.AcquireChunkRead(center);
+                         mesh.Clear();
+                         mesher.BuildLodMesh(center, *handle->chunk, 1, registry, mesh);
+                         Consume(mesh.indices.size());
+                     },
+                     nullptr});
+    cases.push_back({"raycast", rays.size(), [&] {
+                         for (const auto& [origin, direction] : rays) {
+                             const RaycastHit hit = RaycastBlocks(registry, origin, direction, 64.0f);
+                             Consume(static_cast<std::uint64_t>(hit.block.y));
+                         }
+                     },
+                     nullptr});
+    cases.push_back({"aabb_intersects_solid", boxes.size(), [&] {
+                         std::uint64_t hits = 0;
+                         for (const physics::Aabb& box : boxes) {
+                             hits += physics::AabbIntersectsSolid(registry, box) ? 1u : 0u;
+                         }
+                         Consume(hits);
+                     },
+                     nullptr});
+    cases.push_back({"storage_save", storageChunks, [&] {
+                         for (std::size_t i = 0; i < storageChunks; ++i) {
+                             auto handle = registry.AcquireChunkRead(loaded[i % loaded.size()]);
+                             const ChunkCoord coord{static_cast<int>(i), 0, 0};
+                             Consume(storage.SaveChunk(coord, *handle->chunk) ? 1u : 0u);
+                         }
+                     },
+                     nullptr});
+    cases.push_back({"storage_load", storageChunks, [&] {
+                         for (std::size_t i = 0; i < storageChunks; ++i) {
+                             const ChunkCoord coord{static_cast<int>(i), 0, 0};
+                             Consume(storage.LoadChunk(coord, scratch) ? 1u : 0u);
+                         }
+                     },
+                     [&] {
+                         if (!storage.ChunkFileExists(ChunkCoord{0, 0, 0})) {
+                             for (std::size_t i = 0; i < storageChunks; ++i) {
+                                 storage.SaveChunk(ChunkCoord{static_cast<int>(i), 0, 0}, scratch);
+                             }
+                         }
+                     }});
+    cases.push_back({"thread_safe_queue", queueItems, [&] {
+                         GenerateJob job;
+                         for (std::size_t i = 0; i < queueItems; ++i) {
+                             job.coord.x = static_cast<int>(i);
+                             lockedQueue.push(job);
+                         }
+                         std::uint64_t sum = 0;
+                         while (lockedQueue.try_pop(job)) {
+                             sum += static_cast<std::uint64_t>(job.coord.x);
+                         }
+                         Consume(sum);
+                     },
+                     nullptr});
+    cases.push_back({"mpmc_queue", queueItems, [&] {
+                         GenerateJob job;
+                         for (std::size_t i = 0; i < queueItems; ++i) {
+                             job.coord.x = static_cast<int>(i);
+                             ringQueue.push(job);
+                         }
+                         std::uint64_t sum = 0;
+                         while (ringQueue.try_pop(job)) {
+                             sum += static_cast<std::uint64_t>(job.coord.x);
+                         }
+                         Consume(sum);
+                     },
+                     nullptr});
+    cases.push_back({"registry_try_get_entry", loaded.size() * 64, [&] {
+                         std::uint64_t found = 0;
+                         for (int pass = 0; pass < 64; ++pass) {
+                             for (const ChunkCoord& coord : loaded) {
+                                 found += registry.TryGetEntry(coord) ? 1u : 0u;
+                             }
+                         }
+                         Consume(found);
+                     },
+                     nullptr});
+    cases.push_back({"registry_get_block", blocks.size(), [&] {
+                         std::uint64_t sum = 0;
+                         for (const WorldBlockCoord& block : blocks) {
+                             sum += registry.GetBlockOrAir(block);
+                         }
+                         Consume(sum);
+                     },
+                     nullptr});
+
+    const std::vector<bench::BenchResult> results = bench::RunBenches(cases, options.config);
+    std::filesystem::remove_all(storageRoot, ec);
+    const core::MemorySnapshot memory = core::MemoryLedger::Global().Snapshot();
+    std::cout << core::DescribeMemory(memory) << '\n';
+
+    if (!options.jsonPath.empty()) {
+        std::ofstream out(options.jsonPath);
+        bench::WriteJson(out, results, memory);
+        if (!out) {
+            std::cerr << "[Bench] Failed to write " << options.jsonPath << '\n';
+            return 1;
+        }
+        std::cout << "[Bench] Wrote " << results.size() << " results to " << options.jsonPath << ".\n";
+    }
+
+    if (!options.baselinePath.empty()) {
+        std::map<std::string, double> baseline;
+        if (!bench::ReadBaselineJson(options.baselinePath, baseline, error)) {
+            std::cerr << "[Bench] " << error << '\n';
+            return 1;
+        }
+        if (!bench::CompareWithBaseline(results, baseline, options.thresholdPercent)) {
+            std::cout << "[Bench] Regressions beyond " << options.thresholdPercent << "% found.\n";
+            return 1;
+        }
+        std::cout << "[Bench] No regressions beyond " << options.thresholdPercent << "%.\n";
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include "bench/FlightBench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+#include <glm/glm.hpp>
+
+#include "core/MemoryLedger.h"
+#include "core/WorkerPool.h"
+#include "voxel/ChunkMesh.h"
+#include "voxel/ChunkMesher.h"
+#include "voxel/ChunkRegistry.h"
+#include "voxel/ChunkStreaming.h"
+#include "voxel/VoxelCoords.h"
+#include "voxel/WorldGen.h"
+
+namespace bench {
+
+namespace {
+
+constexpr double kWarmupTimeoutSeconds = 30.0;
+
+// Accepts every upload so the flight measures the streaming pipeline, not a GPU.
+class NullMeshStore final : public voxel::MeshStore {
+public:
+    Handle Upload(Handle handle, const voxel::VoxelVertex*, std::size_t, const std::uint32_t*, std::size_t) override {
+        return handle == kInvalidHandle ? 0 : handle;
+    }
+    void Free(Handle) override {}
+    void Queue(Handle, std::uint32_t, std::uint32_t) override {}
+};
+
+voxel::ChunkCoord ChunkAt(const glm::vec3& position) {
+    return voxel::WorldToChunkCoord(voxel::WorldBlockCoord{static_cast<int>(std::floor(position.x)),
+                                                           static_cast<int>(std::floor(position.y)),
+                                                           static_cast<int>(std::floor(position.z))},
+                                    voxel::kChunkSize);
+}
+
+} // namespace
+
+FlightResult RunFlight(const FlightConfig& config) {
+    using namespace voxel;
+    using Clock = std::chrono::steady_clock;
+
+    ChunkStreamingConfig streamingConfig;
+    streamingConfig.renderRadius = config.renderRadius;
+    streamingConfig.loadRadius = config.loadRadius;
+    streamingConfig.verticalRadius = config.verticalRadius;
+    streamingConfig.workerThreads = config.workerThreads;
+    streamingConfig.prefetch.enabled = config.prefetch;
+
+    NullMeshStore store;
+    ChunkRegistry registry;
+    ChunkMesher mesher;
+    ChunkStreaming streaming(streamingConfig);
+    streaming.SetMeshStore(&store);
+    streaming.SetWorkerThreads(static_cast<std::size_t>(config.workerThreads));
+    core::WorkerPool pool;
+    pool.Start(static_cast<std::size_t>(config.workerThreads), streaming.GenerateQueue(), streaming.MeshQueue(),
+               streaming.UploadQueue(), registry, mesher, nullptr);
+
+    const glm::vec3 heading = glm::normalize(glm::vec3{1.0f, 0.0f, 0.2f});
+    const StreamingMotion motion{heading * config.speed, heading};
+    glm::vec3 position{0.5f, static_cast<float>(registry.Generator().SurfaceHeight(0, 0) + 24), 0.5f};
+    const auto frameTime = std::chrono::duration<double, std::milli>(config.frameMs);
+
+    auto tick = [&](const StreamingMotion& frameMotion) {
+        streaming.SetWorkerIdleRatio(pool.SampleIdleRatio());
+        streaming.SetMotion(frameMotion);
+        streaming.Tick(ChunkAt(position), registry, mesher);
+        pool.NotifyWork();
+    };
+
+    // Start from a settled region so both runs fly out of the same state.
+    const auto warmupStart = Clock::now();
+    do {
+        tick(StreamingMotion{});
+        std::this_thread::sleep_for(frameTime);
+    } while (streaming.Stats().pendingChunks > 0 &&
+             std::chrono::duration<double>(Clock::now() - warmupStart).count() < kWarmupTimeoutSeconds);
+
+    const int minChunkY = WorldToChunkCoord(WorldBlockCoord{0, kWorldMinY, 0}, kChunkSize).y;
+    const int maxChunkY = WorldToChunkCoord(WorldBlockCoord{0, kWorldMaxY, 0}, kChunkSize).y;
+    const float minDot = std::cos(glm::radians(config.viewHalfAngleDegrees));
+    std::unordered_set<ChunkCoord, ChunkCoordHash> seenHoles;
+    std::size_t holeFrames = 0;
+
+    core::MemoryLedger::Global().ResetPeaks();
+    FlightResult result;
+    result.prefetch = config.prefetch;
+    const auto start = Clock::now();
+    auto last = start;
+    auto nextFrame = start;
+    while (std::chrono::duration<double>(last - start).count() < config.seconds) {
+        const auto now = Clock::now();
+        position += motion.velocity * static_cast<float>(std::chrono::duration<double>(now - last).count());
+        last = now;
+        tick(motion);
+
+        const ChunkCoord center = ChunkAt(position);
+        const int minY = std::max(center.y - config.verticalRadius, minChunkY);
+        const int maxY = std::min(center.y + config.verticalRadius, maxChunkY);
+        for (int dz = -config.renderRadius; dz <= config.renderRadius; ++dz) {
+            for (int dx = -config.renderRadius; dx <= config.renderRadius; ++dx) {
+                const glm::vec3 toChunk{static_cast<float>(dx), 0.0f, static_cast<float>(dz)};
+                if ((dx != 0 || dz != 0) && glm::dot(glm::normalize(toChunk), heading) < minDot) {
+                    continue;
+                }
+                for (int y = minY; y <= maxY; ++y) {
+                    const ChunkCoord coord{center.x + dx, y, center.z + dz};
+                    auto entry = registry.TryGetEntry(coord);
+                    if (entry && entry->gpuState.load(std::memory_order_acquire) == GpuState::Uploaded) {
+                        continue;
+                    }
+                    ++holeFrames;
+                    seenHoles.insert(coord);
+                }
+            }
+        }
+        ++result.frames;
+        nextFrame += std::chrono::duration_cast<Clock::duration>(frameTime);
+        std::this_thread::sleep_until(nextFrame);
+    }
+    pool.Stop();
+    streaming.ClearCache(registry);
+
+    result.seconds = std::chrono::duration<double>(last - start).count();
+    result.holesPerSecond = result.seconds > 0.0 ? static_cast<double>(seenHoles.size()) / result.seconds : 0.0;
+    result.holesPerFrame =
+        result.frames > 0 ? static_cast<double>(holeFrames) / static_cast<double>(result.frames) : 0.0;
+    result.peakBytes = core::MemoryLedger::Global().Snapshot().peakTotalBytes;
+    return result;
+}
+
+std::string DescribeFlight(const FlightResult& result, const FlightConfig& config) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << "[Flight] prefetch " << (result.prefetch ? "on" : "off") << ": "
+        << result.seconds << " s, " << result.frames << " frames at " << config.speed << " blocks/s | holes "
+        << result.holesPerSecond << "/s, " << result.holesPerFrame << " per frame | peak "
+        << static_cast<double>(result.peakBytes) / (1024.0 * 1024.0) << " MiB";
+    return out.str();
+}
+
+} // namespace bench
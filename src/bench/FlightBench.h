@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace bench {
+
+// A headless straight-line flight over generated terrain with the real streamer and worker pool, paced
+// at a fixed frame rate. Uploads go to a null mesh store, so only generation and meshing limit it.
+struct FlightConfig {
+    double seconds = 6.0;
+    // Blocks per second along +X, bent slightly toward +Z so both prefetch axes get exercised.
+    float speed = 48.0f;
+    int renderRadius = 6;
+    int loadRadius = 8;
+    int verticalRadius = 1;
+    int workerThreads = 2;
+    double frameMs = 16.6;
+    // Chunks inside the render radius and within this angle of the view direction count as visible.
+    float viewHalfAngleDegrees = 45.0f;
+    bool prefetch = true;
+};
+
+struct FlightResult {
+    bool prefetch = false;
+    int frames = 0;
+    double seconds = 0.0;
+    // Distinct chunks seen missing while visible, per second of flight.
+    double holesPerSecond = 0.0;
+    double holesPerFrame = 0.0;
+    std::size_t peakBytes = 0;
+};
+
+// Loads the start region fully, then flies for config.seconds.
+FlightResult RunFlight(const FlightConfig& config);
+
+// "[Flight] prefetch on: 6.0 s, 360 frames at 48 blocks/s | holes 3.2/s, 0.8 per frame | peak 90.1 MiB"
+std::string DescribeFlight(const FlightResult& result, const FlightConfig& config);
+
+} // namespace bench
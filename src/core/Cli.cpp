@@ -58,6 +58,12 @@ bool ParseCli(int argc, char** argv, CliOptions& options, std::string& error) {
             options.soakTestLong = true;
         } else if (arg == "--world-test") {
             options.worldTest = true;
+        } else if (arg == "--queue-bench") {
+            options.queueBench = true;
+        } else if (arg == "--height-bench") {
+            options.heightBench = true;
+        } else if (arg == "--contention-bench") {
+            options.contentionBench = true;
         } else if (arg == "--render-test") {
             options.renderTest = true;
         } else if (arg == "--seed" || arg.rfind("--seed=", 0) == 0) {
@@ -125,6 +131,12 @@ bool ParseCli(int argc, char** argv, CliOptions& options, std::string& error) {
             }
             options.renderTestCompare = true;
             options.renderTestComparePath = argv[++i];
+        } else if (arg == "--trace") {
+            if (i + 1 >= argc) {
+                error = "Missing value for --trace";
+                return false;
+            }
+            options.tracePath = argv[++i];
         } else if (arg == "--no-gl-debug") {
             options.noGlDebug = true;
         } else if (arg == "-h" || arg == "--help") {
@@ -148,6 +160,10 @@ std::string Usage(const char* argv0) {
         << "  --soak-test-long Run deterministic long soak test and exit.\n"
         << "  --seed <u32>     Soak test seed override (default: 1337).\n"
         << "  --world-test     Run deterministic world logic test and exit.\n"
+        << "  --queue-bench    Run job queue producer/consumer throughput benchmark and exit.\n"
+        << "  --height-bench   Run scalar vs batched terrain height sampling benchmark and exit.\n"
+        << "  --contention-bench\n"
+        << "                  Run worker chunk lookup stalls vs render walk benchmark and exit.\n"
         << "  --render-test    Run deterministic offscreen render test and exit.\n"
         << "  --render-test-out <path>\n"
         << "                  Output PNG path (default: render_test.png).\n"
@@ -159,6 +175,7 @@ std::string Usage(const char* argv0) {
         << "                  Render test seed (default: 1337).\n"
         << "  --render-test-compare <path>\n"
         << "                  Compare output against PNG (exact pixel match).\n"
+        << "  --trace <path>   Write the trace buffers as Chrome trace JSON on exit.\n"
         << "  --no-gl-debug    Disable OpenGL debug context/output.\n"
         << "  -h, --help       Show this help message.\n";
     return out.str();
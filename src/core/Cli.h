@@ -11,6 +11,9 @@ struct CliOptions {
     bool soakTest = false;
     bool soakTestLong = false;
     bool worldTest = false;
+    bool queueBench = false;
+    bool heightBench = false;
+    bool contentionBench = false;
     bool noGlDebug = false;
     bool help = false;
     bool renderTest = false;
@@ -22,6 +25,7 @@ struct CliOptions {
     bool renderTestCompare = false;
     std::string renderTestComparePath;
     std::uint32_t soakTestSeed = 1337;
+    std::string tracePath;
 };
 
 bool ParseCli(int argc, char** argv, CliOptions& options, std::string& error);
@@ -0,0 +1,179 @@
+#include "core/ContentionBench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "renderer/ChunkRenderList.h"
+#include "voxel/Chunk.h"
+#include "voxel/ChunkRegistry.h"
+#include "voxel/VoxelCoords.h"
+
+namespace core {
+
+namespace {
+
+constexpr int kRadius = 8;
+constexpr int kLayers = 3;
+constexpr int kFrames = 120;
+constexpr std::size_t kMaxWorkers = 4;
+// Stand-in for the per-chunk cost of culling and queueing a draw.
+constexpr auto kPerChunkWork = std::chrono::nanoseconds(1000);
+// Lookups slower than this count as stalled.
+constexpr auto kStallThreshold = std::chrono::microseconds(50);
+
+struct WorkerStats {
+    std::uint64_t lookups = 0;
+    std::uint64_t stalls = 0;
+    std::chrono::nanoseconds total{0};
+    std::chrono::nanoseconds stalled{0};
+    std::chrono::nanoseconds worst{0};
+};
+
+struct ModeResult {
+    WorkerStats workers;
+    double seconds = 0.0;
+    std::size_t visits = 0;
+};
+
+void SpinFor(std::chrono::nanoseconds duration) {
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+template <typename Walk>
+ModeResult RunMode(voxel::ChunkRegistry& registry, std::size_t workers, Walk&& walk) {
+    std::atomic<bool> stop{false};
+    std::vector<WorkerStats> perWorker(workers);
+    std::vector<std::thread> threads;
+    threads.reserve(workers);
+    for (std::size_t w = 0; w < workers; ++w) {
+        threads.emplace_back([&, w]() {
+            WorkerStats& stats = perWorker[w];
+            std::uint32_t seed = 0x9E3779B9u * static_cast<std::uint32_t>(w + 1);
+            while (!stop.load(std::memory_order_relaxed)) {
+                seed = seed * 1664525u + 1013904223u;
+                const int span = (kRadius * 2 + 1) * voxel::kChunkSize;
+                const voxel::WorldBlockCoord block{static_cast<int>(seed % static_cast<std::uint32_t>(span)) -
+                                                       kRadius * voxel::kChunkSize,
+                                                   static_cast<int>((seed >> 8) % static_cast<std::uint32_t>(
+                                                                        kLayers * voxel::kChunkSize)),
+                                                   static_cast<int>((seed >> 16) % static_cast<std::uint32_t>(span)) -
+                                                       kRadius * voxel::kChunkSize};
+                const auto start = std::chrono::steady_clock::now();
+                (void)registry.GetBlock(block);
+                const auto elapsed = std::chrono::steady_clock::now() - start;
+                ++stats.lookups;
+                stats.total += elapsed;
+                stats.worst = std::max(stats.worst, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed));
+                if (elapsed > kStallThreshold) {
+                    ++stats.stalls;
+                    stats.stalled += elapsed;
+                }
+            }
+        });
+    }
+
+    ModeResult result;
+    const auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+        result.visits += walk();
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const WorkerStats& stats : perWorker) {
+        result.workers.lookups += stats.lookups;
+        result.workers.stalls += stats.stalls;
+        result.workers.total += stats.total;
+        result.workers.stalled += stats.stalled;
+        result.workers.worst = std::max(result.workers.worst, stats.worst);
+    }
+    return result;
+}
+
+void PrintMode(const char* label, const ModeResult& mode) {
+    const WorkerStats& workers = mode.workers;
+    const double meanNs = workers.lookups > 0 ? static_cast<double>(workers.total.count()) /
+                                                    static_cast<double>(workers.lookups)
+                                              : 0.0;
+    std::cout << "[ContentionBench] " << std::left << std::setw(12) << label << std::right << std::fixed
+              << std::setprecision(2) << " lookups " << static_cast<double>(workers.lookups) / mode.seconds / 1.0e6
+              << " M/s mean " << std::setprecision(0) << meanNs << " ns worst " << std::setprecision(1)
+              << static_cast<double>(workers.worst.count()) / 1000.0 << " us stalls " << workers.stalls << " ("
+              << static_cast<double>(workers.stalled.count()) / 1.0e6 << " ms) frame "
+              << mode.seconds * 1000.0 / kFrames << " ms\n";
+}
+
+} // namespace
+
+ContentionBenchResult RunContentionBench() {
+    ContentionBenchResult result;
+    result.ok = true;
+
+    // Leave a core for the main thread so stalls come from the lock rather than preemption.
+    const std::size_t hardwareThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 2);
+    const std::size_t workers = std::min(kMaxWorkers, hardwareThreads - 1);
+
+    voxel::ChunkRegistry registry;
+    renderer::ChunkRenderList renderList;
+    for (int y = 0; y < kLayers; ++y) {
+        for (int z = -kRadius; z <= kRadius; ++z) {
+            for (int x = -kRadius; x <= kRadius; ++x) {
+                const voxel::ChunkCoord coord{x, y, z};
+                auto entry = registry.GetOrCreateEntry(coord);
+                entry->chunk = registry.Pools().chunks.Acquire();
+                entry->chunk->Fill(voxel::kBlockStone);
+                entry->generationState.store(voxel::GenerationState::Ready, std::memory_order_release);
+                entry->gpuState.store(voxel::GpuState::Uploaded, std::memory_order_release);
+                renderList.Upsert(coord, entry);
+            }
+        }
+    }
+
+    const ModeResult locked = RunMode(registry, workers, [&registry]() {
+        std::size_t visits = 0;
+        registry.ForEachEntry([&visits](const voxel::ChunkCoord& coord,
+                                        const std::shared_ptr<voxel::ChunkEntry>& entry) {
+            (void)coord;
+            if (entry->gpuState.load(std::memory_order_acquire) == voxel::GpuState::Uploaded) {
+                SpinFor(kPerChunkWork);
+                ++visits;
+            }
+        });
+        return visits;
+    });
+    const ModeResult listed = RunMode(registry, workers, [&renderList]() {
+        std::size_t visits = 0;
+        for (const renderer::RenderChunk& chunk : renderList.Chunks()) {
+            (void)chunk;
+            SpinFor(kPerChunkWork);
+            ++visits;
+        }
+        return visits;
+    });
+
+    std::cout << "[ContentionBench] " << renderList.Size() << " chunks, " << workers << " workers, " << kFrames
+              << " frames\n";
+    PrintMode("registry", locked);
+    PrintMode("render-list", listed);
+
+    if (locked.visits != listed.visits) {
+        result.ok = false;
+        result.message = "Render list and registry walks visited different chunk counts";
+    }
+    return result;
+}
+
+} // namespace core
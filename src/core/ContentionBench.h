@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string>
+
+namespace core {
+
+struct ContentionBenchResult {
+    bool ok = false;
+    std::string message;
+};
+
+// Worker chunk lookups while the main thread walks every uploaded chunk once per frame, either
+// inside ChunkRegistry::ForEachEntry (registry lock held) or over the streaming render list.
+ContentionBenchResult RunContentionBench();
+
+} // namespace core
@@ -0,0 +1,81 @@
+#include "core/HeightBench.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+#include "voxel/Chunk.h"
+#include "voxel/WorldGen.h"
+
+namespace core {
+
+namespace {
+
+constexpr int kChunksPerSide = 32;
+constexpr int kColumnsPerChunk = voxel::kChunkSize * voxel::kChunkSize;
+constexpr int kRegionOrigin = -(kChunksPerSide / 2) * voxel::kChunkSize;
+
+using ColumnHeights = std::array<int, kColumnsPerChunk>;
+
+template <typename Fill>
+double TimeRegion(Fill&& fill, std::uint64_t& checksum) {
+    ColumnHeights heights{};
+    const auto start = std::chrono::steady_clock::now();
+    for (int cz = 0; cz < kChunksPerSide; ++cz) {
+        for (int cx = 0; cx < kChunksPerSide; ++cx) {
+            fill(kRegionOrigin + cx * voxel::kChunkSize, kRegionOrigin + cz * voxel::kChunkSize, heights);
+            for (int height : heights) {
+                checksum = checksum * 31u + static_cast<std::uint32_t>(height);
+            }
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+} // namespace
+
+HeightBenchResult RunHeightBench() {
+    HeightBenchResult result;
+    result.ok = true;
+    const voxel::WorldGenerator generator;
+
+    std::uint64_t scalarChecksum = 0;
+    const double scalarSeconds = TimeRegion(
+        [&generator](int x0, int z0, ColumnHeights& heights) {
+            for (int z = 0; z < voxel::kChunkSize; ++z) {
+                for (int x = 0; x < voxel::kChunkSize; ++x) {
+                    heights[static_cast<std::size_t>(x + voxel::kChunkSize * z)] = generator.SurfaceHeight(x0 + x, z0 + z);
+                }
+            }
+        },
+        scalarChecksum);
+
+    std::uint64_t batchedChecksum = 0;
+    const double batchedSeconds = TimeRegion(
+        [&generator](int x0, int z0, ColumnHeights& heights) {
+            generator.SampleHeightColumns(x0, z0, voxel::kChunkSize, voxel::kChunkSize, heights.data());
+        },
+        batchedChecksum);
+
+    if (scalarChecksum != batchedChecksum) {
+        result.ok = false;
+        result.message = "Batched heights differ from SurfaceHeight";
+    }
+
+    const double columns = static_cast<double>(kChunksPerSide) * kChunksPerSide * kColumnsPerChunk;
+    const double scalarRate = columns / scalarSeconds;
+    const double batchedRate = columns / batchedSeconds;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "[HeightBench] " << kChunksPerSide << "x" << kChunksPerSide << " chunk columns ("
+              << static_cast<std::int64_t>(columns) << " heights), backend " << voxel::HeightColumnsBackend() << '\n';
+    std::cout << "[HeightBench] scalar  " << scalarRate / 1.0e6 << " M heights/s\n";
+    std::cout << "[HeightBench] batched " << batchedRate / 1.0e6 << " M heights/s (" << batchedRate / scalarRate
+              << "x)\n";
+    return result;
+}
+
+} // namespace core
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <string>
+
+namespace core {
+
+struct HeightBenchResult {
+    bool ok = false;
+    std::string message;
+};
+
+HeightBenchResult RunHeightBench();
+
+} // namespace core
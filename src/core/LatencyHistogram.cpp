@@ -0,0 +1,104 @@
+#include "core/LatencyHistogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <iomanip>
+#include <sstream>
+
+namespace core {
+
+std::size_t LatencyCounts::BucketIndex(std::uint64_t us) {
+    if (us < kSubBuckets) {
+        return static_cast<std::size_t>(us);
+    }
+    const auto magnitude = static_cast<std::size_t>(std::bit_width(us)) - kSubBucketBits;
+    const std::size_t index =
+        magnitude * kSubBuckets + static_cast<std::size_t>((us >> (magnitude - 1)) & (kSubBuckets - 1));
+    return std::min(index, kBucketCount - 1);
+}
+
+std::uint64_t LatencyCounts::BucketHighestUs(std::size_t index) {
+    const std::size_t magnitude = index / kSubBuckets;
+    const std::uint64_t sub = index % kSubBuckets;
+    if (magnitude == 0) {
+        return sub;
+    }
+    return ((kSubBuckets + sub + 1) << (magnitude - 1)) - 1;
+}
+
+void LatencyCounts::Record(std::uint64_t us) {
+    ++buckets[BucketIndex(us)];
+    ++count;
+    maxUs = std::max(maxUs, us);
+}
+
+void LatencyCounts::Merge(const LatencyCounts& other) {
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    count += other.count;
+    maxUs = std::max(maxUs, other.maxUs);
+}
+
+void LatencyCounts::Clear() {
+    buckets.fill(0);
+    count = 0;
+    maxUs = 0;
+}
+
+LatencyPercentiles LatencyCounts::Percentiles() const {
+    LatencyPercentiles result;
+    result.count = count;
+    if (count == 0) {
+        return result;
+    }
+    const double quantiles[4] = {0.5, 0.9, 0.99, 0.999};
+    double* outputs[4] = {&result.p50Ms, &result.p90Ms, &result.p99Ms, &result.p999Ms};
+    std::size_t next = 0;
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBucketCount && next < 4; ++i) {
+        seen += buckets[i];
+        while (next < 4 && static_cast<double>(seen) >= quantiles[next] * static_cast<double>(count)) {
+            *outputs[next] = static_cast<double>(std::min(BucketHighestUs(i), maxUs)) / 1000.0;
+            ++next;
+        }
+    }
+    result.maxMs = static_cast<double>(maxUs) / 1000.0;
+    return result;
+}
+
+void LatencyHistogram::Record(std::uint64_t us) {
+    buckets_[LatencyCounts::BucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+    std::uint64_t previous = maxUs_.load(std::memory_order_relaxed);
+    while (us > previous && !maxUs_.compare_exchange_weak(previous, us, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::DrainInto(LatencyCounts& into) {
+    for (std::size_t i = 0; i < LatencyCounts::kBucketCount; ++i) {
+        const std::uint64_t value = buckets_[i].exchange(0, std::memory_order_relaxed);
+        into.buckets[i] += value;
+        into.count += value;
+    }
+    into.maxUs = std::max(into.maxUs, maxUs_.exchange(0, std::memory_order_relaxed));
+}
+
+LatencyPercentiles LatencyWindow::Percentiles(bool rotate) {
+    LatencyCounts combined = previous_;
+    combined.Merge(current_);
+    if (rotate) {
+        previous_ = current_;
+        current_.Clear();
+    }
+    return combined.Percentiles();
+}
+
+std::string FormatPercentiles(const LatencyPercentiles& percentiles) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2) << "p50/p90/p99/p999/max " << percentiles.p50Ms << '/'
+        << percentiles.p90Ms << '/' << percentiles.p99Ms << '/' << percentiles.p999Ms << '/' << percentiles.maxMs
+        << " ms";
+    return out.str();
+}
+
+} // namespace core
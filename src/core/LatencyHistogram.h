@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace core {
+
+struct LatencyPercentiles {
+    std::uint64_t count = 0;
+    double p50Ms = 0.0;
+    double p90Ms = 0.0;
+    double p99Ms = 0.0;
+    double p999Ms = 0.0;
+    double maxMs = 0.0;
+};
+
+// Log-linear buckets over microseconds, HdrHistogram style: values below 16 us are exact, and every
+// power of two above that is split into 16 linear sub-buckets, so a reported value is within 1/16
+// (about 6%) of the true one. The last bucket absorbs anything past ~9 hours.
+struct LatencyCounts {
+    static constexpr std::size_t kSubBucketBits = 4;
+    static constexpr std::size_t kSubBuckets = std::size_t{1} << kSubBucketBits;
+    static constexpr std::size_t kBucketCount = kSubBuckets * 32;
+
+    std::array<std::uint64_t, kBucketCount> buckets{};
+    std::uint64_t count = 0;
+    std::uint64_t maxUs = 0;
+
+    static std::size_t BucketIndex(std::uint64_t us);
+    // Largest value that lands in the bucket.
+    static std::uint64_t BucketHighestUs(std::size_t index);
+
+    void Record(std::uint64_t us);
+    void Merge(const LatencyCounts& other);
+    void Clear();
+    // Highest-equivalent value of each quantile, clamped to the exact max.
+    LatencyPercentiles Percentiles() const;
+};
+
+// Lock-free recorder: any thread may Record; one thread drains. A sample racing a drain lands in
+// either window, never both.
+class LatencyHistogram {
+public:
+    void Record(std::uint64_t us);
+    // Moves everything recorded since the last drain into `into`.
+    void DrainInto(LatencyCounts& into);
+
+private:
+    std::array<std::atomic<std::uint64_t>, LatencyCounts::kBucketCount> buckets_{};
+    std::atomic<std::uint64_t> maxUs_{0};
+};
+
+// Counts split into a current and a previous window so percentiles always cover the last one to two
+// windows: tails stay visible between frequent reads without growing stale. Owners decide when to
+// rotate. Single-threaded.
+class LatencyWindow {
+public:
+    void Record(std::uint64_t us) { current_.Record(us); }
+    LatencyCounts& Current() { return current_; }
+    // Percentiles over both windows; rotating then makes the current window the previous one.
+    LatencyPercentiles Percentiles(bool rotate);
+
+private:
+    LatencyCounts current_{};
+    LatencyCounts previous_{};
+};
+
+// "p50/p90/p99/p999/max a/b/c/d/e ms"
+std::string FormatPercentiles(const LatencyPercentiles& percentiles);
+
+} // namespace core
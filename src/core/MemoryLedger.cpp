@@ -0,0 +1,101 @@
+#include "core/MemoryLedger.h"
+
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace core {
+
+namespace {
+
+constexpr double kBytesPerMiB = 1024.0 * 1024.0;
+
+double ToMiB(std::size_t bytes) {
+    return static_cast<double>(bytes) / kBytesPerMiB;
+}
+
+} // namespace
+
+const char* MemoryCategoryName(MemoryCategory category) {
+    switch (category) {
+    case MemoryCategory::BlockData:
+        return "block_data";
+    case MemoryCategory::Light:
+        return "light";
+    case MemoryCategory::CpuMesh:
+        return "cpu_mesh";
+    case MemoryCategory::GpuMesh:
+        return "gpu_mesh";
+    case MemoryCategory::Queues:
+        return "queues";
+    case MemoryCategory::PoolFree:
+        return "pool_free";
+    case MemoryCategory::Count:
+        break;
+    }
+    return "unknown";
+}
+
+MemoryLedger& MemoryLedger::Global() {
+    static MemoryLedger ledger;
+    return ledger;
+}
+
+void MemoryLedger::Add(MemoryCategory category, std::size_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+    const std::size_t index = static_cast<std::size_t>(category);
+    RaisePeak(peakBytes_[index], bytes_[index].fetch_add(bytes, std::memory_order_relaxed) + bytes);
+    RaisePeak(peakTotalBytes_, totalBytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+}
+
+void MemoryLedger::Remove(MemoryCategory category, std::size_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+    bytes_[static_cast<std::size_t>(category)].fetch_sub(bytes, std::memory_order_relaxed);
+    totalBytes_.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+MemorySnapshot MemoryLedger::Snapshot() const {
+    MemorySnapshot snapshot;
+    for (std::size_t i = 0; i < kMemoryCategoryCount; ++i) {
+        snapshot.bytes[i] = bytes_[i].load(std::memory_order_relaxed);
+        snapshot.peakBytes[i] = peakBytes_[i].load(std::memory_order_relaxed);
+    }
+    snapshot.totalBytes = totalBytes_.load(std::memory_order_relaxed);
+    snapshot.peakTotalBytes = peakTotalBytes_.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+void MemoryLedger::ResetPeaks() {
+    for (std::size_t i = 0; i < kMemoryCategoryCount; ++i) {
+        peakBytes_[i].store(bytes_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    peakTotalBytes_.store(totalBytes_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void MemoryLedger::RaisePeak(std::atomic<std::size_t>& peak, std::size_t value) {
+    std::size_t current = peak.load(std::memory_order_relaxed);
+    while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+std::string DescribeMemory(const MemorySnapshot& snapshot) {
+    static constexpr std::pair<MemoryCategory, const char*> kColumns[] = {
+        {MemoryCategory::BlockData, "blocks"}, {MemoryCategory::Light, "light"},
+        {MemoryCategory::CpuMesh, "cpu mesh"}, {MemoryCategory::GpuMesh, "gpu mesh"},
+        {MemoryCategory::Queues, "queues"},    {MemoryCategory::PoolFree, "pool free"},
+    };
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << "[Memory] MiB now/peak total " << ToMiB(snapshot.totalBytes)
+        << '/' << ToMiB(snapshot.peakTotalBytes);
+    for (const auto& [category, label] : kColumns) {
+        const std::size_t index = static_cast<std::size_t>(category);
+        out << " | " << label << ' ' << ToMiB(snapshot.bytes[index]) << '/' << ToMiB(snapshot.peakBytes[index]);
+    }
+    return out.str();
+}
+
+} // namespace core
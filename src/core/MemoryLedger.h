@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+namespace core {
+
+enum class MemoryCategory : std::size_t {
+    BlockData = 0, // live Chunk voxel arrays
+    Light,         // live LightChunk sunlight/emissive arrays
+    CpuMesh,       // built meshes waiting for upload, with their scratch buffers
+    GpuMesh,       // vertex and index bytes of uploaded meshes
+    Queues,        // job ring buffers
+    PoolFree,      // recycled objects parked in ObjectPool free lists
+    Count
+};
+
+inline constexpr std::size_t kMemoryCategoryCount = static_cast<std::size_t>(MemoryCategory::Count);
+
+// Also the key in the benchmark JSON.
+const char* MemoryCategoryName(MemoryCategory category);
+
+struct MemorySnapshot {
+    std::array<std::size_t, kMemoryCategoryCount> bytes{};
+    std::array<std::size_t, kMemoryCategoryCount> peakBytes{};
+    std::size_t totalBytes = 0;
+    // High-water mark of the sum, which is lower than the sum of the per-category peaks.
+    std::size_t peakTotalBytes = 0;
+};
+
+// Byte counters per category with high-water marks. Owners of the big allocations report them as they
+// come and go (pools, meshes, queues), so the numbers cover the memory that scales with loadRadius
+// rather than every heap allocation. Lock-free; callable from any thread.
+class MemoryLedger {
+public:
+    static MemoryLedger& Global();
+
+    MemoryLedger() = default;
+    MemoryLedger(const MemoryLedger&) = delete;
+    MemoryLedger& operator=(const MemoryLedger&) = delete;
+
+    void Add(MemoryCategory category, std::size_t bytes);
+    // Must match earlier Add calls; the ledger does not know which object the bytes belonged to.
+    void Remove(MemoryCategory category, std::size_t bytes);
+
+    MemorySnapshot Snapshot() const;
+    // Restarts the high-water marks at the current values.
+    void ResetPeaks();
+
+private:
+    static void RaisePeak(std::atomic<std::size_t>& peak, std::size_t value);
+
+    std::array<std::atomic<std::size_t>, kMemoryCategoryCount> bytes_{};
+    std::array<std::atomic<std::size_t>, kMemoryCategoryCount> peakBytes_{};
+    std::atomic<std::size_t> totalBytes_{0};
+    std::atomic<std::size_t> peakTotalBytes_{0};
+};
+
+// "[Memory] MiB now/peak total x/y | blocks a/b | light a/b | cpu mesh a/b | gpu mesh a/b | queues a/b |
+// pool free a/b"
+std::string DescribeMemory(const MemorySnapshot& snapshot);
+
+} // namespace core
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "core/MemoryLedger.h"
+
+namespace core {
+
+// Bounded multi-producer/multi-consumer ring buffer (per-slot sequence numbers).
+// try_push() leaves the value untouched when the ring is full; push() yields until a slot frees up, so
+// it is only safe where the consumer can never be waiting on the producer (tests, benchmarks). The
+// streaming pipeline uses try_push(). The ring is reported to the MemoryLedger as Queues.
+template <typename T>
+class MpmcQueue {
+public:
+    static constexpr std::size_t kDefaultCapacity = 4096;
+
+    explicit MpmcQueue(std::size_t capacity = kDefaultCapacity)
+        : capacity_(RoundUpPow2(capacity)), mask_(capacity_ - 1), slots_(new Slot[capacity_]) {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        MemoryLedger::Global().Add(MemoryCategory::Queues, StorageBytes());
+    }
+
+    ~MpmcQueue() {
+        MemoryLedger::Global().Remove(MemoryCategory::Queues, StorageBytes());
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    bool try_push(T&& value) {
+        std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & mask_];
+            const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = std::move(value);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void push(T value) {
+        while (!try_push(std::move(value))) {
+            std::this_thread::yield();
+        }
+    }
+
+    bool try_pop(T& out) {
+        std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & mask_];
+            const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff =
+                static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(slot.value);
+                    slot.sequence.store(pos + capacity_, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    // Approximate under concurrent push/pop; exact when the queue is quiescent.
+    std::size_t size() const {
+        const std::size_t dequeued = dequeuePos_.load(std::memory_order_acquire);
+        const std::size_t enqueued = enqueuePos_.load(std::memory_order_acquire);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    std::size_t capacity() const {
+        return capacity_;
+    }
+
+    std::size_t StorageBytes() const {
+        return capacity_ * sizeof(Slot);
+    }
+
+private:
+    static constexpr std::size_t kCacheLine = 64;
+
+    struct alignas(kCacheLine) Slot {
+        std::atomic<std::size_t> sequence{0};
+        T value{};
+    };
+
+    static std::size_t RoundUpPow2(std::size_t value) {
+        std::size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(kCacheLine) std::atomic<std::size_t> enqueuePos_{0};
+    alignas(kCacheLine) std::atomic<std::size_t> dequeuePos_{0};
+};
+
+} // namespace core
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "core/MemoryLedger.h"
+
+namespace core {
+
+struct PoolStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::size_t inUse = 0;
+    std::size_t freeCount = 0;
+    std::size_t bytes = 0;
+    std::size_t peakBytes = 0;
+};
+
+// Thread-safe free list of heap objects. Released objects keep their storage (and any vector
+// capacity) so steady-state acquire/release cycles do not touch the allocator.
+template <typename T>
+class ObjectPool {
+public:
+    using FootprintFn = std::size_t (*)(const T&);
+    using FactoryFn = std::unique_ptr<T> (*)();
+
+    explicit ObjectPool(std::size_t maxFree, FootprintFn footprint = nullptr, FactoryFn factory = nullptr,
+                        MemoryCategory liveCategory = MemoryCategory::Count)
+        : maxFree_(maxFree), footprint_(footprint), factory_(factory), liveCategory_(liveCategory) {
+        free_.reserve(maxFree_);
+    }
+
+    ~ObjectPool() {
+        MemoryLedger::Global().Remove(MemoryCategory::PoolFree, freeBytes_);
+        if (liveCategory_ != MemoryCategory::Count) {
+            MemoryLedger::Global().Remove(liveCategory_, inUse_ * sizeof(T));
+        }
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    std::unique_ptr<T> Acquire() {
+        std::unique_ptr<T> object;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!free_.empty()) {
+                object = std::move(free_.back());
+                free_.pop_back();
+                const std::size_t footprint = Footprint(*object);
+                freeBytes_ -= footprint;
+                MemoryLedger::Global().Remove(MemoryCategory::PoolFree, footprint);
+                outstanding_.insert(object.get());
+            }
+            ++inUse_;
+            UpdatePeakLocked();
+            if (liveCategory_ != MemoryCategory::Count) {
+                MemoryLedger::Global().Add(liveCategory_, sizeof(T));
+            }
+        }
+        if (object) {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return object;
+        }
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        object = factory_ ? factory_() : std::make_unique<T>();
+        std::lock_guard<std::mutex> lock(mutex_);
+        outstanding_.insert(object.get());
+        return object;
+    }
+
+    // Objects the pool never handed out (e.g. tests building chunks directly) are adopted into the free
+    // list without touching the live count.
+    void Release(std::unique_ptr<T> object) {
+        if (!object) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (outstanding_.erase(object.get()) > 0) {
+            --inUse_;
+            if (liveCategory_ != MemoryCategory::Count) {
+                MemoryLedger::Global().Remove(liveCategory_, sizeof(T));
+            }
+        }
+        if (free_.size() >= maxFree_) {
+            return;
+        }
+        const std::size_t footprint = Footprint(*object);
+        freeBytes_ += footprint;
+        MemoryLedger::Global().Add(MemoryCategory::PoolFree, footprint);
+        free_.push_back(std::move(object));
+        UpdatePeakLocked();
+    }
+
+    PoolStats Stats() const {
+        PoolStats stats;
+        stats.hits = hits_.load(std::memory_order_relaxed);
+        stats.misses = misses_.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats.inUse = inUse_;
+        stats.freeCount = free_.size();
+        stats.bytes = BytesLocked();
+        stats.peakBytes = peakBytes_;
+        return stats;
+    }
+
+private:
+    std::size_t Footprint(const T& object) const {
+        return footprint_ ? footprint_(object) : sizeof(T);
+    }
+
+    std::size_t BytesLocked() const {
+        return freeBytes_ + inUse_ * sizeof(T);
+    }
+
+    void UpdatePeakLocked() {
+        const std::size_t bytes = BytesLocked();
+        if (bytes > peakBytes_) {
+            peakBytes_ = bytes;
+        }
+    }
+
+    const std::size_t maxFree_;
+    const FootprintFn footprint_;
+    const FactoryFn factory_;
+    const MemoryCategory liveCategory_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<T>> free_;
+    std::unordered_set<const T*> outstanding_;
+    std::size_t inUse_ = 0;
+    std::size_t freeBytes_ = 0;
+    std::size_t peakBytes_ = 0;
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> misses_{0};
+};
+
+} // namespace core
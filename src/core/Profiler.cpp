@@ -1,8 +1,36 @@
 #include "core/Profiler.h"
 
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <utility>
+
+#include "core/Trace.h"
+
 namespace core {
 
-Profiler::Profiler() : lastWindow_(std::chrono::steady_clock::now()) {
+const char* MetricName(Metric metric) {
+    switch (metric) {
+    case Metric::Frame:
+        return "Frame";
+    case Metric::Update:
+        return "Update";
+    case Metric::Upload:
+        return "Upload";
+    case Metric::Render:
+        return "Render";
+    case Metric::Generate:
+        return "Generate";
+    case Metric::Mesh:
+        return "Mesh";
+    case Metric::Count:
+        break;
+    }
+    return "Unknown";
+}
+
+Profiler::Profiler()
+    : lastWindow_(std::chrono::steady_clock::now()), latencyWindowStart_(lastWindow_) {
     for (auto& value : totalsUs_) {
         value.store(0, std::memory_order_relaxed);
     }
@@ -16,6 +44,7 @@ void Profiler::AddSample(Metric metric, std::chrono::microseconds duration) {
     const std::size_t index = static_cast<std::size_t>(metric);
     totalsUs_[index].fetch_add(duration.count(), std::memory_order_relaxed);
     counts_[index].fetch_add(1, std::memory_order_relaxed);
+    histograms_[index].Record(static_cast<std::uint64_t>(std::max<std::int64_t>(duration.count(), 0)));
 }
 
 ProfilerSnapshot Profiler::CollectSnapshot(double emaAlpha) {
@@ -43,16 +72,42 @@ ProfilerSnapshot Profiler::CollectSnapshot(double emaAlpha) {
         snapshot.emaMs[i] = emaMs_[i];
     }
 
+    const bool rotate = std::chrono::duration<double>(now - latencyWindowStart_).count() >= kLatencyWindowSeconds;
+    for (std::size_t i = 0; i < kMetricCount; ++i) {
+        histograms_[i].DrainInto(latency_[i].Current());
+        snapshot.latency[i] = latency_[i].Percentiles(rotate);
+    }
+    if (rotate) {
+        latencyWindowStart_ = now;
+    }
+
     return snapshot;
 }
 
+std::string DescribeLatency(const ProfilerSnapshot& snapshot) {
+    static constexpr std::pair<Metric, const char*> kColumns[] = {
+        {Metric::Frame, "frame"},  {Metric::Update, "upd"},     {Metric::Upload, "up"},
+        {Metric::Render, "rnd"},   {Metric::Generate, "gen"},   {Metric::Mesh, "mesh"},
+    };
+    std::ostringstream out;
+    out << "[Latency]";
+    for (std::size_t i = 0; i < std::size(kColumns); ++i) {
+        out << (i == 0 ? " " : " | ") << kColumns[i].second << ' '
+            << FormatPercentiles(snapshot.latency[static_cast<std::size_t>(kColumns[i].first)]);
+    }
+    return out.str();
+}
+
 ScopedTimer::ScopedTimer(Profiler* profiler, Metric metric)
     : profiler_(profiler),
       metric_(metric),
       start_(std::chrono::steady_clock::now()),
-      active_(profiler != nullptr) {}
+      active_(profiler != nullptr) {
+    Tracer::Global().Record(TracePhase::Begin, MetricName(metric_));
+}
 
 ScopedTimer::~ScopedTimer() {
+    Tracer::Global().Record(TracePhase::End, MetricName(metric_));
     if (!active_) {
         return;
     }
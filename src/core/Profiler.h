@@ -5,6 +5,9 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <string>
+
+#include "core/LatencyHistogram.h"
 
 namespace core {
 
@@ -18,27 +21,46 @@ enum class Metric : std::size_t {
     Count
 };
 
+// Also the scope name ScopedTimer records into the trace.
+const char* MetricName(Metric metric);
+
 struct ProfilerSnapshot {
     double windowSeconds = 0.0;
     std::array<double, static_cast<std::size_t>(Metric::Count)> avgMs{};
     std::array<double, static_cast<std::size_t>(Metric::Count)> emaMs{};
     std::array<std::int64_t, static_cast<std::size_t>(Metric::Count)> counts{};
+    // Over the last one to two latency windows, so tails stay visible between frequent snapshots.
+    std::array<LatencyPercentiles, static_cast<std::size_t>(Metric::Count)> latency{};
 };
 
 class Profiler {
 public:
+    static constexpr double kLatencyWindowSeconds = 5.0;
+
     Profiler();
 
+    // Lock-free; callable from any thread.
     void AddSample(Metric metric, std::chrono::microseconds duration);
     ProfilerSnapshot CollectSnapshot(double emaAlpha = 0.2);
 
 private:
+    static constexpr std::size_t kMetricCount = static_cast<std::size_t>(Metric::Count);
+
     std::array<std::atomic<std::int64_t>, static_cast<std::size_t>(Metric::Count)> totalsUs_{};
     std::array<std::atomic<std::int64_t>, static_cast<std::size_t>(Metric::Count)> counts_{};
     std::array<double, static_cast<std::size_t>(Metric::Count)> emaMs_{};
     std::chrono::steady_clock::time_point lastWindow_;
+
+    std::array<LatencyHistogram, kMetricCount> histograms_;
+    // Drained on the collecting thread.
+    std::array<LatencyWindow, kMetricCount> latency_{};
+    std::chrono::steady_clock::time_point latencyWindowStart_;
 };
 
+// "[Latency] frame p50/p90/p99/p999/max ... | upd ... | up ... | rnd ... | gen ... | mesh ..."
+std::string DescribeLatency(const ProfilerSnapshot& snapshot);
+
+// Times a scope into the profiler (when non-null) and records it as a trace slice.
 class ScopedTimer {
 public:
     ScopedTimer(Profiler* profiler, Metric metric);
@@ -0,0 +1,141 @@
+#include "core/QueueBench.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "core/MpmcQueue.h"
+#include "core/ThreadSafeQueue.h"
+#include "voxel/ChunkJobs.h"
+
+namespace core {
+
+namespace {
+
+constexpr std::size_t kItemsPerRun = 1'000'000;
+
+struct BenchCase {
+    std::size_t producers;
+    std::size_t consumers;
+};
+
+constexpr std::array<BenchCase, 4> kCases = {{
+    {1, 1},
+    {1, 2},
+    {2, 2},
+    {4, 4},
+}};
+
+struct RunResult {
+    double seconds = 0.0;
+    std::int64_t checksum = 0;
+};
+
+template <typename Queue>
+RunResult RunCase(Queue& queue, const BenchCase& benchCase) {
+    const std::size_t itemsPerProducer = kItemsPerRun / benchCase.producers;
+    const std::size_t totalItems = itemsPerProducer * benchCase.producers;
+    std::atomic<std::size_t> consumed{0};
+    std::atomic<std::int64_t> checksum{0};
+    std::atomic<bool> go{false};
+
+    std::vector<std::thread> threads;
+    threads.reserve(benchCase.producers + benchCase.consumers);
+    for (std::size_t p = 0; p < benchCase.producers; ++p) {
+        threads.emplace_back([&, p]() {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (std::size_t i = 0; i < itemsPerProducer; ++i) {
+                voxel::GenerateJob job;
+                job.coord.x = static_cast<std::int32_t>(i);
+                job.coord.z = static_cast<std::int32_t>(p);
+                queue.push(std::move(job));
+            }
+        });
+    }
+    for (std::size_t c = 0; c < benchCase.consumers; ++c) {
+        threads.emplace_back([&]() {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            std::int64_t localSum = 0;
+            voxel::GenerateJob job;
+            while (consumed.load(std::memory_order_relaxed) < totalItems) {
+                if (queue.try_pop(job)) {
+                    localSum += job.coord.x;
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            checksum.fetch_add(localSum, std::memory_order_relaxed);
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    RunResult result;
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    result.checksum = checksum.load();
+    return result;
+}
+
+std::int64_t ExpectedChecksum(const BenchCase& benchCase) {
+    const auto itemsPerProducer = static_cast<std::int64_t>(kItemsPerRun / benchCase.producers);
+    return static_cast<std::int64_t>(benchCase.producers) * (itemsPerProducer * (itemsPerProducer - 1) / 2);
+}
+
+std::string FormatRate(double itemsPerSecond) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2) << itemsPerSecond / 1.0e6 << " M/s";
+    return out.str();
+}
+
+} // namespace
+
+QueueBenchResult RunQueueBench() {
+    QueueBenchResult result;
+    result.ok = true;
+
+    std::cout << "+----------+------------------+------------------+---------+\n";
+    std::cout << "| P x C    | ThreadSafeQueue  | MpmcQueue        | Speedup |\n";
+    std::cout << "+----------+------------------+------------------+---------+\n";
+    for (const auto& benchCase : kCases) {
+        ThreadSafeQueue<voxel::GenerateJob> lockedQueue;
+        MpmcQueue<voxel::GenerateJob> ringQueue;
+        const RunResult locked = RunCase(lockedQueue, benchCase);
+        const RunResult ring = RunCase(ringQueue, benchCase);
+
+        const std::int64_t expected = ExpectedChecksum(benchCase);
+        if (locked.checksum != expected || ring.checksum != expected) {
+            result.ok = false;
+            result.message = "Queue bench checksum mismatch for " + std::to_string(benchCase.producers) + "x" +
+                             std::to_string(benchCase.consumers);
+        }
+
+        const auto items = static_cast<double>((kItemsPerRun / benchCase.producers) * benchCase.producers);
+        const double lockedRate = items / locked.seconds;
+        const double ringRate = items / ring.seconds;
+        std::ostringstream label;
+        label << benchCase.producers << " x " << benchCase.consumers;
+        std::cout << "| " << std::left << std::setw(9) << label.str() << "| " << std::setw(17)
+                  << FormatRate(lockedRate) << "| " << std::setw(17) << FormatRate(ringRate) << "| "
+                  << std::setw(8) << std::fixed << std::setprecision(2) << ringRate / lockedRate << "|\n";
+    }
+    std::cout << "+----------+------------------+------------------+---------+\n";
+    return result;
+}
+
+} // namespace core
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <string>
+
+namespace core {
+
+struct QueueBenchResult {
+    bool ok = false;
+    std::string message;
+};
+
+QueueBenchResult RunQueueBench();
+
+} // namespace core
@@ -0,0 +1,107 @@
+#include "core/RangeAllocator.h"
+
+#include <iterator>
+
+#include "core/Assert.h"
+
+namespace core {
+
+RangeAllocator::RangeAllocator(std::size_t capacity) {
+    Reset(capacity);
+}
+
+void RangeAllocator::Reset(std::size_t capacity) {
+    capacity_ = capacity;
+    used_ = 0;
+    freeByOffset_.clear();
+    freeBySize_.clear();
+    if (capacity_ > 0) {
+        InsertFree(0, capacity_);
+    }
+}
+
+std::optional<Range> RangeAllocator::Allocate(std::size_t size) {
+    if (size == 0) {
+        return Range{0, 0};
+    }
+    auto fit = freeBySize_.lower_bound(size);
+    if (fit == freeBySize_.end()) {
+        return std::nullopt;
+    }
+    const std::size_t blockSize = fit->first;
+    const std::size_t blockOffset = fit->second;
+    EraseFree(freeByOffset_.find(blockOffset));
+    if (blockSize > size) {
+        InsertFree(blockOffset + size, blockSize - size);
+    }
+    used_ += size;
+    return Range{blockOffset, size};
+}
+
+void RangeAllocator::Free(const Range& range) {
+    if (range.size == 0) {
+        return;
+    }
+    MC_ASSERT(range.offset + range.size <= capacity_, "RangeAllocator::Free out of bounds.");
+    MC_ASSERT(used_ >= range.size, "RangeAllocator::Free more than allocated.");
+    used_ -= range.size;
+
+    std::size_t offset = range.offset;
+    std::size_t size = range.size;
+    auto next = freeByOffset_.lower_bound(offset);
+    if (next != freeByOffset_.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            size += prev->second;
+            EraseFree(prev);
+        }
+    }
+    if (next != freeByOffset_.end() && offset + size == next->first) {
+        size += next->second;
+        EraseFree(next);
+    }
+    InsertFree(offset, size);
+}
+
+void RangeAllocator::Grow(std::size_t newCapacity) {
+    if (newCapacity <= capacity_) {
+        return;
+    }
+    const std::size_t oldCapacity = capacity_;
+    capacity_ = newCapacity;
+    // Account the new tail as used so Free() can coalesce it with a trailing free block.
+    used_ += newCapacity - oldCapacity;
+    Free(Range{oldCapacity, newCapacity - oldCapacity});
+}
+
+RangeAllocatorStats RangeAllocator::Stats() const {
+    RangeAllocatorStats stats;
+    stats.capacity = capacity_;
+    stats.used = used_;
+    stats.freeBlocks = freeByOffset_.size();
+    stats.largestFree = freeBySize_.empty() ? 0 : freeBySize_.rbegin()->first;
+    const std::size_t totalFree = capacity_ - used_;
+    if (totalFree > 0) {
+        stats.fragmentation = 1.0f - static_cast<float>(stats.largestFree) / static_cast<float>(totalFree);
+    }
+    return stats;
+}
+
+void RangeAllocator::InsertFree(std::size_t offset, std::size_t size) {
+    freeByOffset_.emplace(offset, size);
+    freeBySize_.emplace(size, offset);
+}
+
+void RangeAllocator::EraseFree(std::map<std::size_t, std::size_t>::iterator it) {
+    auto [first, last] = freeBySize_.equal_range(it->second);
+    for (auto sizeIt = first; sizeIt != last; ++sizeIt) {
+        if (sizeIt->second == it->first) {
+            freeBySize_.erase(sizeIt);
+            break;
+        }
+    }
+    freeByOffset_.erase(it);
+}
+
+} // namespace core
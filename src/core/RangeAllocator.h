@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <optional>
+
+namespace core {
+
+struct Range {
+    std::size_t offset = 0;
+    std::size_t size = 0;
+};
+
+struct RangeAllocatorStats {
+    std::size_t capacity = 0;
+    std::size_t used = 0;
+    std::size_t freeBlocks = 0;
+    std::size_t largestFree = 0;
+    // 0 when all free space is one block, approaching 1 as it splinters.
+    float fragmentation = 0.0f;
+};
+
+// Best-fit free-list allocator over an abstract [0, capacity) space (units are up to the caller).
+// Freed neighbours coalesce immediately. Not thread-safe.
+class RangeAllocator {
+public:
+    explicit RangeAllocator(std::size_t capacity = 0);
+
+    std::optional<Range> Allocate(std::size_t size);
+    void Free(const Range& range);
+
+    // Extends the space at the top; existing ranges keep their offsets.
+    void Grow(std::size_t newCapacity);
+    void Reset(std::size_t capacity);
+
+    std::size_t Capacity() const { return capacity_; }
+    std::size_t Used() const { return used_; }
+    RangeAllocatorStats Stats() const;
+
+private:
+    void InsertFree(std::size_t offset, std::size_t size);
+    void EraseFree(std::map<std::size_t, std::size_t>::iterator it);
+
+    std::size_t capacity_ = 0;
+    std::size_t used_ = 0;
+    std::map<std::size_t, std::size_t> freeByOffset_;
+    std::multimap<std::size_t, std::size_t> freeBySize_;
+};
+
+} // namespace core
@@ -0,0 +1,258 @@
+#include "core/Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace core {
+
+namespace {
+
+const char* PhaseCode(TracePhase phase) {
+    switch (phase) {
+    case TracePhase::Begin:
+        return "B";
+    case TracePhase::End:
+        return "E";
+    case TracePhase::Counter:
+        return "C";
+    case TracePhase::FlowStart:
+        return "s";
+    case TracePhase::FlowStep:
+        return "t";
+    case TracePhase::FlowEnd:
+        return "f";
+    case TracePhase::AsyncBegin:
+        return "b";
+    case TracePhase::AsyncEnd:
+        return "e";
+    }
+    return "i";
+}
+
+void WriteJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text ? text : ""; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+std::int64_t SteadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+struct Tracer::Ring {
+    std::vector<TraceEvent> events = std::vector<TraceEvent>(kRingCapacity);
+    std::atomic<std::uint64_t> head{0};
+    std::atomic<bool> writing{false};
+    std::atomic<bool> owned{true};
+    std::string threadName;
+    std::uint32_t threadId = 0;
+};
+
+Tracer& Tracer::Global() {
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::Tracer() : epochNs_(SteadyNowNs()) {}
+
+Tracer::~Tracer() = default;
+
+void Tracer::SetEnabled(bool enabled) {
+    enabled_.store(enabled);
+}
+
+Tracer::Ring& Tracer::ThreadRing() {
+    // Rings outlive their threads; a thread that exits hands its ring to the next new thread.
+    struct Handle {
+        Ring* ring = nullptr;
+        ~Handle() {
+            if (ring) {
+                ring->owned.store(false, std::memory_order_release);
+            }
+        }
+    };
+    thread_local Handle handle;
+    if (handle.ring) {
+        return *handle.ring;
+    }
+
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    for (const auto& ring : rings_) {
+        bool expected = false;
+        if (ring->owned.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            // The previous owner has exited; drop its name and unexported events.
+            ring->head.store(0, std::memory_order_relaxed);
+            ring->threadName = "Thread " + std::to_string(ring->threadId);
+            handle.ring = ring.get();
+            return *handle.ring;
+        }
+    }
+    rings_.push_back(std::make_unique<Ring>());
+    rings_.back()->threadId = static_cast<std::uint32_t>(rings_.size());
+    rings_.back()->threadName = "Thread " + std::to_string(rings_.size());
+    handle.ring = rings_.back().get();
+    return *handle.ring;
+}
+
+void Tracer::Record(TracePhase phase, const char* name, std::uint64_t arg) {
+    RecordAt(phase, name, arg, SteadyNowNs());
+}
+
+void Tracer::RecordAt(TracePhase phase, const char* name, std::uint64_t arg, std::int64_t steadyNs) {
+    if (!enabled_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    Ring& ring = ThreadRing();
+    // Dekker-style handshake with Pause(): either the exporter sees `writing` or we see it disabled.
+    ring.writing.store(true);
+    if (enabled_.load()) {
+        const std::uint64_t head = ring.head.load(std::memory_order_relaxed);
+        ring.events[head % kRingCapacity] = TraceEvent{steadyNs - epochNs_, name, arg, phase};
+        ring.head.store(head + 1, std::memory_order_release);
+    }
+    ring.writing.store(false, std::memory_order_release);
+}
+
+void Tracer::SetThreadName(const std::string& name) {
+    Ring& ring = ThreadRing();
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    ring.threadName = name;
+}
+
+std::uint64_t Tracer::NextFlowId() {
+    return nextFlow_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool Tracer::Pause() {
+    const bool wasEnabled = enabled_.exchange(false);
+    for (const auto& ring : rings_) {
+        while (ring->writing.load()) {
+            std::this_thread::yield();
+        }
+    }
+    return wasEnabled;
+}
+
+void Tracer::Clear() {
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    const bool wasEnabled = Pause();
+    for (const auto& ring : rings_) {
+        ring->head.store(0, std::memory_order_relaxed);
+    }
+    enabled_.store(wasEnabled);
+}
+
+TraceStats Tracer::Stats() const {
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    TraceStats stats;
+    stats.threads = rings_.size();
+    for (const auto& ring : rings_) {
+        const std::uint64_t head = ring->head.load(std::memory_order_acquire);
+        stats.recordedEvents += head;
+        stats.bufferedEvents += static_cast<std::size_t>(std::min<std::uint64_t>(head, kRingCapacity));
+    }
+    return stats;
+}
+
+std::size_t Tracer::WriteChromeJson(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    const bool wasEnabled = Pause();
+
+    std::size_t written = 0;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&] {
+        out << (first ? "\n" : ",\n");
+        first = false;
+    };
+    out << std::fixed << std::setprecision(3);
+    for (const auto& ring : rings_) {
+        separator();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->threadId
+            << ",\"args\":{\"name\":";
+        WriteJsonString(out, ring->threadName.c_str());
+        out << "}}";
+
+        const std::uint64_t head = ring->head.load(std::memory_order_acquire);
+        const std::uint64_t begin = head > kRingCapacity ? head - kRingCapacity : 0;
+        for (std::uint64_t i = begin; i < head; ++i) {
+            const TraceEvent& event = ring->events[i % kRingCapacity];
+            separator();
+            out << "{\"name\":";
+            WriteJsonString(out, event.name);
+            out << ",\"ph\":\"" << PhaseCode(event.phase) << "\",\"pid\":1,\"tid\":" << ring->threadId
+                << ",\"ts\":" << static_cast<double>(event.timestampNs) / 1000.0;
+            switch (event.phase) {
+            case TracePhase::Counter:
+                out << ",\"args\":{\"value\":" << static_cast<std::int64_t>(event.arg) << '}';
+                break;
+            case TracePhase::FlowEnd:
+                out << ",\"cat\":\"flow\",\"id\":" << event.arg << ",\"bp\":\"e\"";
+                break;
+            case TracePhase::FlowStart:
+            case TracePhase::FlowStep:
+                out << ",\"cat\":\"flow\",\"id\":" << event.arg;
+                break;
+            case TracePhase::AsyncBegin:
+            case TracePhase::AsyncEnd:
+                out << ",\"cat\":\"async\",\"id\":" << event.arg;
+                break;
+            default:
+                break;
+            }
+            out << '}';
+            ++written;
+        }
+    }
+    out << "\n]}\n";
+
+    enabled_.store(wasEnabled);
+    return written;
+}
+
+bool Tracer::WriteChromeJsonFile(const std::filesystem::path& path, std::string& error) {
+    std::error_code ec;
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path(), ec);
+        if (ec) {
+            error = "Failed to create " + path.parent_path().string() + ": " + ec.message();
+            return false;
+        }
+    }
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        error = "Failed to open " + path.string();
+        return false;
+    }
+    const std::size_t events = WriteChromeJson(out);
+    if (!out) {
+        error = "Failed to write " + path.string();
+        return false;
+    }
+    std::cout << "[Trace] Wrote " << events << " events to " << path.string() << ".\n";
+    return true;
+}
+
+std::filesystem::path NextTraceDumpPath() {
+    static std::atomic<int> counter{0};
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+                             std::chrono::system_clock::now().time_since_epoch())
+                             .count();
+    return std::filesystem::path("traces") /
+           ("trace_" + std::to_string(seconds) + "_" + std::to_string(counter.fetch_add(1)) + ".json");
+}
+
+} // namespace core
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace core {
+
+enum class TracePhase : std::uint8_t {
+    Begin,
+    End,
+    Counter,
+    FlowStart,
+    FlowStep,
+    FlowEnd,
+    AsyncBegin,
+    AsyncEnd
+};
+
+// Names must outlive the tracer (string literals); only the pointer is recorded.
+struct TraceEvent {
+    std::int64_t timestampNs = 0;
+    const char* name = nullptr;
+    std::uint64_t arg = 0; // flow or async id, or counter value
+    TracePhase phase = TracePhase::Begin;
+};
+
+struct TraceStats {
+    std::size_t threads = 0;
+    std::size_t bufferedEvents = 0;
+    std::uint64_t recordedEvents = 0;
+};
+
+// Steady-clock nanoseconds; the time base of trace events, also used for timestamps kept elsewhere.
+std::int64_t SteadyNowNs();
+
+// Flight recorder for scopes, counters and flows. Every thread writes into its own fixed ring, so
+// recording is a few stores with no shared cache lines; old events are overwritten. Export briefly
+// pauses recording and writes the buffered window as Chrome trace JSON (chrome://tracing, Perfetto).
+// There is one process-wide tracer because each thread caches its ring in a thread_local.
+class Tracer {
+public:
+    static constexpr std::size_t kRingCapacity = 1u << 15;
+
+    static Tracer& Global();
+
+    ~Tracer();
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    void SetEnabled(bool enabled);
+    bool Enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    void Record(TracePhase phase, const char* name, std::uint64_t arg = 0);
+    // Records an event stamped with an earlier SteadyNowNs() reading instead of the current time.
+    void RecordAt(TracePhase phase, const char* name, std::uint64_t arg, std::int64_t steadyNs);
+    // Labels the calling thread in exported traces.
+    void SetThreadName(const std::string& name);
+    std::uint64_t NextFlowId();
+
+    void Clear();
+    TraceStats Stats() const;
+
+    // Returns the number of events written.
+    std::size_t WriteChromeJson(std::ostream& out);
+    bool WriteChromeJsonFile(const std::filesystem::path& path, std::string& error);
+
+private:
+    struct Ring;
+
+    Tracer();
+    Ring& ThreadRing();
+    // Stops recording and waits for in-flight writes; returns the previous enabled state.
+    bool Pause();
+
+    std::atomic<bool> enabled_{true};
+    std::atomic<std::uint64_t> nextFlow_{1};
+    std::int64_t epochNs_ = 0;
+    mutable std::mutex ringsMutex_;
+    std::vector<std::unique_ptr<Ring>> rings_;
+};
+
+inline void TraceCounter(const char* name, std::int64_t value) {
+    Tracer::Global().Record(TracePhase::Counter, name, static_cast<std::uint64_t>(value));
+}
+
+// Flows draw arrows between slices on different threads; each call must sit inside an open scope.
+inline void TraceFlow(TracePhase phase, const char* name, std::uint64_t id) {
+    if (id != 0) {
+        Tracer::Global().Record(phase, name, id);
+    }
+}
+
+// A slice on the async track `id` (one row per id in the viewer) covering a span measured earlier,
+// e.g. a chunk's time in a queue. Empty or unmeasured spans are skipped.
+inline void TraceAsyncSpan(const char* name, std::uint64_t id, std::int64_t beginNs, std::int64_t endNs) {
+    if (beginNs > 0 && endNs >= beginNs) {
+        Tracer::Global().RecordAt(TracePhase::AsyncBegin, name, id, beginNs);
+        Tracer::Global().RecordAt(TracePhase::AsyncEnd, name, id, endNs);
+    }
+}
+
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) : name_(name) { Tracer::Global().Record(TracePhase::Begin, name_); }
+    ~TraceScope() { Tracer::Global().Record(TracePhase::End, name_); }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name_;
+};
+
+// traces/trace_<unix seconds>_<n>.json, unique within the process.
+std::filesystem::path NextTraceDumpPath();
+
+} // namespace core
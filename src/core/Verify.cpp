@@ -3,19 +3,45 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
+#include <cmath>
 #include <filesystem>
 #include <iostream>
+#include <optional>
 #include <shared_mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "core/LatencyHistogram.h"
+#include "core/MemoryLedger.h"
+#include "core/MpmcQueue.h"
+#include "core/Profiler.h"
+#include "core/RangeAllocator.h"
+#include "core/Trace.h"
 #include "core/WorkerPool.h"
+#include "math/Frustum.h"
 #include "persistence/ChunkStorage.h"
+#include "renderer/ChunkCuller.h"
+#include "renderer/ChunkRenderList.h"
+#include "renderer/FarTerrain.h"
 #include "voxel/BlockEdit.h"
+#include "voxel/BlockFaces.h"
+#include "voxel/BlockRegistry.h"
 #include "voxel/Chunk.h"
+#include "voxel/ChunkBounds.h"
 #include "voxel/ChunkMesher.h"
 #include "voxel/ChunkRegistry.h"
 #include "voxel/ChunkStreaming.h"
+#include "voxel/ChunkVisibility.h"
 #include "voxel/Raycast.h"
+#include "voxel/StreamingBudget.h"
+#include "voxel/UploadBudget.h"
 #include "voxel/VoxelCoords.h"
+#include "voxel/WorldGen.h"
 
 namespace core {
 
@@ -142,6 +168,99 @@ void CheckEditNeighborRemesh(VerifyState& state) {
     Require(streaming.MeshQueue().size() == 2, "Expected two remesh jobs queued.", state);
 }
 
+void CheckColumnGeneration(VerifyState& state) {
+    using namespace voxel;
+    WorldGenConfig config;
+    config.seed = 4242u;
+    const WorldGenerator generator(config);
+    const std::array<ChunkCoord, 4> coords = {{{0, 0, 0}, {-3, -1, 2}, {5, -2, -7}, {1, 1, 1}}};
+    for (const ChunkCoord& coord : coords) {
+        Chunk chunk(Chunk::kUninitialized);
+        generator.GenerateChunk(coord, chunk);
+        bool matches = true;
+        for (int z = 0; z < kChunkSize && matches; ++z) {
+            for (int y = 0; y < kChunkSize && matches; ++y) {
+                for (int x = 0; x < kChunkSize && matches; ++x) {
+                    const WorldBlockCoord world = ChunkLocalToWorld(coord, LocalCoord{x, y, z}, kChunkSize);
+                    matches = chunk.Get(x, y, z) == generator.SampleBlock(world);
+                }
+            }
+        }
+        Require(matches, "Column-wise chunk generation differs from per-voxel sampling.", state);
+    }
+}
+
+void CheckWorldGenPipeline(VerifyState& state) {
+    using namespace voxel;
+    WorldGenConfig config;
+    config.seed = 1u;
+    const WorldGenerator first(config);
+    config.seed = 2u;
+    const WorldGenerator second(config);
+
+    bool seedsDiffer = false;
+    for (int x = 0; x < 64 && !seedsDiffer; ++x) {
+        seedsDiffer = first.SurfaceHeight(x, -x) != second.SurfaceHeight(x, -x);
+    }
+    Require(seedsDiffer, "World seed does not affect terrain.", state);
+
+    // Vertically stacked chunks share one column computation.
+    for (int y = -1; y <= 1; ++y) {
+        Chunk chunk(Chunk::kUninitialized);
+        first.GenerateChunk(ChunkCoord{3, y, -4}, chunk);
+    }
+    const ColumnCacheStats cache = first.CacheStats();
+    Require(cache.misses == 1 && cache.hits == 2, "Stacked chunks did not share the cached column.", state);
+
+    bool carved = false;
+    for (int cx = 0; cx < 4 && !carved; ++cx) {
+        Chunk chunk(Chunk::kUninitialized);
+        const ChunkCoord coord{cx, -1, 0};
+        first.GenerateChunk(coord, chunk);
+        for (int i = 0; i < kChunkVolume && !carved; ++i) {
+            carved = chunk.Data()[i] == kBlockAir;
+        }
+    }
+    Require(carved, "Cave stage carved nothing below the surface.", state);
+
+    // Heights recorded from the generator that wrote pre-versioned saves.
+    const WorldGenerator legacy(WorldGenConfigForVersion(kWorldGenLegacy, kDefaultWorldSeed));
+    const std::array<std::array<int, 3>, 5> legacyHeights = {
+        {{0, 0, 3}, {17, -5, 8}, {-300, 411, 6}, {1000, -1000, 11}, {-64, 64, 13}}};
+    for (const std::array<int, 3>& sample : legacyHeights) {
+        Require(legacy.SurfaceHeight(sample[0], sample[1]) == sample[2], "Legacy generator terrain changed.", state);
+    }
+}
+
+void CheckBatchedHeights(VerifyState& state) {
+    using namespace voxel;
+    // Odd widths exercise the scalar tail after the vector lanes; the strided grid is the far terrain's.
+    struct Region {
+        int x0;
+        int z0;
+        int width;
+        int depth;
+        int step;
+    };
+    const WorldGenerator generator;
+    const std::array<Region, 5> regions = {
+        {{0, 0, 32, 32, 1}, {-517, -33, 37, 5, 1}, {100003, -250001, 19, 7, 1}, {-3, 9, 3, 3, 1}, {-8, -8, 19, 19, 8}}};
+    for (const Region& region : regions) {
+        std::vector<int> heights(static_cast<std::size_t>(region.width * region.depth));
+        generator.SampleHeightColumns(region.x0, region.z0, region.width, region.depth, heights.data(), nullptr,
+                                      region.step);
+        bool matches = true;
+        for (int z = 0; z < region.depth && matches; ++z) {
+            for (int x = 0; x < region.width && matches; ++x) {
+                matches = heights[static_cast<std::size_t>(x + region.width * z)] ==
+                          generator.SurfaceHeight(region.x0 + x * region.step, region.z0 + z * region.step);
+            }
+        }
+        Require(matches, std::string("Batched height sampling (") + HeightColumnsBackend() + ") differs from scalar.",
+                state);
+    }
+}
+
 void CheckMesherVerticalNeighbors(VerifyState& state) {
     using namespace voxel;
     ChunkRegistry registry;
@@ -163,6 +282,7 @@ void CheckMesherVerticalNeighbors(VerifyState& state) {
     baseEntry->chunk->Set(0, kChunkSize - 1, 0, kBlockStone);
     aboveEntry->chunk->Set(0, 0, 0, kBlockStone);
 
+    registry.EnsureLightForNeighborhood(base);
     ChunkMeshCpu mesh;
     mesher.BuildMesh(base, *baseEntry->chunk, registry, mesh);
 
@@ -175,6 +295,598 @@ void CheckMesherVerticalNeighbors(VerifyState& state) {
             "Mesher index count mismatch for vertical neighbor face culling.", state);
 }
 
+void CheckMeshFaceRanges(VerifyState& state) {
+    using namespace voxel;
+    ChunkRegistry registry;
+    ChunkMesher mesher;
+    ChunkCoord coord{0, 0, 0};
+    auto entry = registry.GetOrCreateEntry(coord);
+    entry->chunk = std::make_unique<Chunk>();
+    entry->chunk->Fill(kBlockAir);
+    entry->chunk->Set(4, 4, 4, kBlockStone);
+    entry->chunk->Set(5, 4, 4, kBlockStone);
+    entry->generationState.store(GenerationState::Ready, std::memory_order_release);
+
+    registry.EnsureLightForNeighborhood(coord);
+    ChunkMeshCpu mesh;
+    mesher.BuildMesh(coord, *entry->chunk, registry, mesh);
+
+    // Two blocks side by side along X: 1 face each for +X/-X, 2 for the other directions.
+    std::uint32_t nextIndex = 0;
+    bool normalsMatch = true;
+    for (std::size_t direction = 0; direction < kFaceDirectionCount; ++direction) {
+        const FaceRange& range = mesh.faces[direction];
+        const std::uint32_t expected = direction < 2 ? 6u : 12u;
+        Require(range.firstIndex == nextIndex && range.indexCount == expected,
+                "Mesher face ranges should be contiguous and bucketed by direction.", state);
+        nextIndex = range.firstIndex + range.indexCount;
+        for (std::uint32_t i = range.firstIndex; i < nextIndex && i < mesh.indices.size(); ++i) {
+            normalsMatch =
+                normalsMatch && mesh.vertices[mesh.indices[i]].normal == PackNormal(kBlockFaces[direction].normal);
+        }
+    }
+    Require(nextIndex == mesh.indices.size(), "Mesher face ranges do not cover every index.", state);
+    Require(normalsMatch, "Mesher face range contains a quad from another direction.", state);
+
+    const ChunkBounds bounds = GetChunkBounds(coord);
+    const std::uint8_t mask = FacingDirectionMask(bounds, glm::vec3(100.0f, 16.0f, 16.0f));
+    Require(mask == (kAllFaceDirections & ~0x02u), "Facing mask should drop only -X for an eye far along +X.", state);
+}
+
+void CheckBlockRegistry(VerifyState& state) {
+    using namespace voxel;
+    const BlockRegistry& blocks = BlockRegistry::Default();
+    Require(!blocks.IsOpaque(kBlockAir) && !blocks.IsSolid(kBlockAir), "Air should be neither opaque nor solid.",
+            state);
+    Require(blocks.IsOpaque(kBlockStone) && blocks.IsSolid(kBlockDirt), "Stone and dirt should be opaque and solid.",
+            state);
+    Require(!blocks.IsOpaque(kBlockTorch) && blocks.IsSolid(kBlockTorch) && blocks.Emissive(kBlockTorch) == 14,
+            "Torches should pass light, collide and emit level 14.", state);
+    Require(blocks.IsOpaque(kBlockLava) && blocks.Emissive(kBlockLava) == kLightMax,
+            "Lava should be opaque and emit full light.", state);
+    Require(blocks.IsOpaque(200) && blocks.IsSolid(200) && blocks.Get(200).name == "Unknown",
+            "Unregistered ids should read as an opaque, solid unknown block.", state);
+    Require(blocks.FaceLayer(kBlockStone, 2) != blocks.FaceLayer(kBlockDirt, 2),
+            "Stone and dirt should sample different texture layers.", state);
+
+    BlockRegistry custom;
+    const TextureLayer side = custom.AddLayer("side", {});
+    const TextureLayer top = custom.AddLayer("top", {});
+    Require(custom.AddLayer("side", {}) == side && custom.Layers().size() == 2,
+            "Adding an existing layer name should reuse its layer.", state);
+    BlockDefinition grass;
+    grass.name = "Grass";
+    grass.faceLayers = AllFaces(side);
+    grass.faceLayers[2] = top;
+    custom.Register(7, grass);
+    Require(custom.FaceLayer(7, 2) == top && custom.FaceLayer(7, 0) == side && custom.BlockCount() == 8,
+            "Registered blocks should keep their per-face layers.", state);
+    Require(custom.Get(3).name == "Unknown", "Ids skipped by Register should stay unknown.", state);
+
+    ChunkRegistry registry;
+    ChunkMesher mesher;
+    ChunkCoord coord{0, 0, 0};
+    auto entry = registry.GetOrCreateEntry(coord);
+    entry->chunk = std::make_unique<Chunk>();
+    entry->chunk->Fill(kBlockAir);
+    entry->chunk->Set(4, 4, 4, kBlockStone);
+    entry->chunk->Set(8, 4, 4, kBlockDirt);
+    entry->generationState.store(GenerationState::Ready, std::memory_order_release);
+    registry.EnsureLightForNeighborhood(coord);
+    ChunkMeshCpu mesh;
+    mesher.BuildMesh(coord, *entry->chunk, registry, mesh);
+
+    bool layersMatch = !mesh.vertices.empty();
+    for (const VoxelVertex& vertex : mesh.vertices) {
+        const BlockId block = vertex.position.x < 6.0f ? kBlockStone : kBlockDirt;
+        layersMatch = layersMatch && vertex.layer == blocks.FaceLayer(block, 0);
+    }
+    Require(layersMatch, "Mesh vertices should carry their block's texture layer.", state);
+}
+
+void CheckLodMeshes(VerifyState& state) {
+    using namespace voxel;
+    const ChunkLodConfig config;
+    const int edge = config.maxDistance[0];
+    Require(LodForDistance(edge, config) == 0 && LodForDistance(edge + 1, config) == 1,
+            "LOD rings should start past each ring's max distance.", state);
+    Require(SelectLod(edge + config.hysteresis, 0, config) == 0 &&
+                SelectLod(edge + config.hysteresis + 1, 0, config) == 1,
+            "LOD should only coarsen past the hysteresis band.", state);
+    Require(SelectLod(edge, 1, config) == 0, "LOD should refine as soon as a chunk re-enters a ring.", state);
+
+    ChunkRegistry registry;
+    ChunkMesher mesher;
+    ChunkCoord coord{0, 0, 0};
+    auto entry = registry.GetOrCreateEntry(coord);
+    entry->chunk = std::make_unique<Chunk>();
+    entry->chunk->Fill(kBlockAir);
+    for (int z = 0; z < kChunkSize; ++z) {
+        for (int y = 0; y < kChunkSize / 2; ++y) {
+            for (int x = 0; x < kChunkSize; ++x) {
+                entry->chunk->Set(x, y, z, kBlockStone);
+            }
+        }
+    }
+    entry->generationState.store(GenerationState::Ready, std::memory_order_release);
+
+    for (int lod = 1; lod < kLodLevelCount; ++lod) {
+        ChunkMeshCpu mesh;
+        mesher.BuildLodMesh(coord, *entry->chunk, lod, registry, mesh);
+        const auto cells = static_cast<std::uint32_t>(kChunkSize / LodCellSize(lod));
+        Require(mesh.lod == lod && mesh.faces[2].indexCount == cells * cells * 6,
+                "LOD mesh should cover a flat surface with one quad per cell.", state);
+        bool onGrid = true;
+        for (const VoxelVertex& vertex : mesh.vertices) {
+            onGrid = onGrid && std::fmod(vertex.position.y, static_cast<float>(LodCellSize(lod))) == 0.0f;
+        }
+        Require(onGrid && !mesh.vertices.empty(), "LOD mesh vertices should lie on the cell grid.", state);
+    }
+
+    // Border faces toward +X are culled only while the neighbour is meshed at the same LOD.
+    auto neighbor = registry.GetOrCreateEntry({1, 0, 0});
+    neighbor->chunk = std::make_unique<Chunk>();
+    *neighbor->chunk = *entry->chunk;
+    neighbor->generationState.store(GenerationState::Ready, std::memory_order_release);
+    auto borderIndices = [&](int lod, int neighborLod) {
+        entry->lod.store(lod);
+        neighbor->lod.store(neighborLod);
+        ChunkMeshCpu mesh;
+        if (lod == 0) {
+            mesher.BuildMesh(coord, *entry->chunk, registry, mesh);
+        } else {
+            mesher.BuildLodMesh(coord, *entry->chunk, lod, registry, mesh);
+        }
+        return mesh.faces[0].indexCount;
+    };
+    Require(borderIndices(0, 0) == 0 && borderIndices(1, 1) == 0,
+            "Chunk borders should be culled against a neighbour at the same LOD.", state);
+    Require(borderIndices(0, 1) == static_cast<std::uint32_t>(kChunkSize * kChunkSize / 2 * 6) &&
+                borderIndices(1, 0) > 0,
+            "Chunk borders should stay closed against a neighbour at another LOD.", state);
+
+    Chunk cell;
+    cell.Fill(kBlockAir);
+    cell.Set(0, 0, 0, kBlockStone);
+    cell.Set(1, 0, 0, kBlockStone);
+    cell.Set(0, 0, 1, kBlockStone);
+    Require(DownsampleCell(cell, 0, 0, 0, 2) == kBlockAir, "A cell under half solid should downsample to air.", state);
+    cell.Set(1, 1, 1, kBlockDirt);
+    Require(DownsampleCell(cell, 0, 0, 0, 2) == kBlockDirt,
+            "A half-solid cell should take the block of its highest solid voxel.", state);
+}
+
+// Stands in for the GL mesh arena; uploads only need a handle back.
+class NullMeshStore final : public voxel::MeshStore {
+public:
+    Handle Upload(Handle handle, const voxel::VoxelVertex*, std::size_t, const std::uint32_t*, std::size_t) override {
+        return handle == kInvalidHandle ? 0 : handle;
+    }
+    void Free(Handle) override {}
+    void Queue(Handle, std::uint32_t, std::uint32_t) override {}
+};
+
+void CheckChunkVisibility(VerifyState& state) {
+    using namespace voxel;
+    std::vector<std::uint16_t> scratch;
+    Chunk chunk;
+    chunk.Fill(kBlockAir);
+    const ChunkVisibility open = ComputeChunkVisibility(chunk, scratch);
+    Require(open.Connects(0, 1) && open.Connects(2, 5), "Empty chunk should connect every face.", state);
+
+    // A stone wall across x = 16 separates -X from +X; the other faces span both halves.
+    for (int z = 0; z < kChunkSize; ++z) {
+        for (int y = 0; y < kChunkSize; ++y) {
+            chunk.Set(16, y, z, kBlockStone);
+        }
+    }
+    const ChunkVisibility wall = ComputeChunkVisibility(chunk, scratch);
+    Require(!wall.Connects(0, 1) && wall.Connects(0, 2) && wall.Connects(1, 2) && wall.Connects(2, 3),
+            "Chunk visibility does not respect a separating wall.", state);
+    chunk.Set(16, 8, 8, kBlockTorch);
+    Require(ComputeChunkVisibility(chunk, scratch).Connects(0, 1),
+            "Chunk visibility should pass through non-opaque blocks such as torches.", state);
+
+    chunk.Fill(kBlockStone);
+    const ChunkVisibility solid = ComputeChunkVisibility(chunk, scratch);
+    Require(!solid.Connects(0, 0) && !solid.Connects(2, 3), "Solid chunk should connect no faces.", state);
+
+    VisibilityGraph graph;
+    graph.Traverse({0, 0, 0}, nullptr, 4, 1);
+    Require(graph.IsReachable({3, 0, 0}), "Open space should be reachable by the visibility walk.", state);
+    graph.Clear();
+    graph.SetVisibility({1, 0, 0}, solid);
+    graph.Traverse({0, 0, 0}, nullptr, 4, 1);
+    Require(graph.IsReachable({1, 0, 0}) && !graph.IsReachable({2, 0, 0}),
+            "Chunks behind a solid chunk should be occluded.", state);
+
+    // A solid chunk uploads an empty mesh and never enters the render list, but must still occlude.
+    ChunkStreamingConfig config;
+    config.loadRadius = 2;
+    config.renderRadius = 2;
+    config.verticalRadius = 0;
+    config.maxChunkCreatesPerFrame = 0;
+    config.maxChunkMeshesPerFrame = 0;
+    config.budget.adaptive = false;
+    NullMeshStore store;
+    ChunkRegistry registry;
+    ChunkMesher mesher;
+    ChunkStreaming streaming(config);
+    streaming.SetMeshStore(&store);
+    streaming.Tick(ChunkCoord{0, 0, 0}, registry, mesher);
+    for (int x = 1; x <= 2; ++x) {
+        const ChunkCoord coord{x, 0, 0};
+        auto entry = registry.TryGetEntry(coord);
+        entry->gpuState.store(GpuState::UploadQueued, std::memory_order_release);
+        MeshReady ready;
+        ready.coord = coord;
+        ready.entry = entry;
+        ready.cpuMesh = registry.Pools().meshScratch.Acquire();
+        ready.cpuMesh->Clear();
+        ready.cpuMesh->visibility = x == 1 ? solid : ChunkVisibility::Open();
+        if (x == 2) {
+            ready.cpuMesh->vertices.resize(4);
+            ready.cpuMesh->indices.resize(6);
+        }
+        streaming.UploadQueue().try_push(std::move(ready));
+    }
+    streaming.Tick(ChunkCoord{0, 0, 0}, registry, mesher);
+    renderer::ChunkCuller culler;
+    renderer::ChunkCullOptions options;
+    options.frustum = false;
+    options.renderRadius = 2;
+    options.eye = glm::vec3(16.0f);
+    std::vector<std::uint32_t> drawn;
+    const renderer::ChunkCullResult result =
+        culler.Cull(streaming.RenderList(), Frustum::FromMatrix(glm::mat4(1.0f)), options, drawn);
+    Require(streaming.RenderList().Size() == 1 && result.occlusionCulled == 1 && drawn.empty(),
+            "A chunk behind an uploaded solid chunk should be occlusion culled.", state);
+}
+
+void CheckFrustumCulling(VerifyState& state) {
+    using namespace voxel;
+    const glm::mat4 projection = glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 300.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(8.0f, 20.0f, 8.0f), glm::vec3(40.0f, 12.0f, -25.0f),
+                                       glm::vec3(0.0f, 1.0f, 0.0f));
+    const Frustum frustum = Frustum::FromMatrix(projection * view);
+
+    // 61 boxes: exercises full vector steps and the scalar tail.
+    AabbList boxes;
+    std::uint32_t seed = 12345u;
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+    };
+    for (int i = 0; i < 61; ++i) {
+        const glm::vec3 min(next() * 400.0f - 200.0f, next() * 100.0f - 50.0f, next() * 400.0f - 200.0f);
+        boxes.Push(min, min + glm::vec3(1.0f + next() * 40.0f));
+    }
+    std::vector<std::uint8_t> mask(boxes.Size());
+    frustum.IntersectsAabbs(boxes, 0, boxes.Size(), mask.data());
+    bool matches = true;
+    for (std::size_t i = 0; i < boxes.Size(); ++i) {
+        const glm::vec3 min(boxes.minX[i], boxes.minY[i], boxes.minZ[i]);
+        const glm::vec3 max(boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]);
+        matches = matches && (mask[i] != 0) == frustum.IntersectsAabb(min, max);
+    }
+    Require(matches, std::string("Batched frustum test (") + FrustumBatchBackend() + ") differs from scalar.", state);
+
+    std::vector<ChunkCoord> coords;
+    for (int x = -9; x <= 9; ++x) {
+        for (int z = -9; z <= 9; ++z) {
+            for (int y = -2; y <= 2; ++y) {
+                coords.push_back(ChunkCoord{x, y, z});
+            }
+        }
+    }
+    renderer::ChunkCullTree tree;
+    tree.Build(coords);
+    std::vector<std::uint32_t> visible;
+    tree.Cull(frustum, visible);
+    std::sort(visible.begin(), visible.end());
+    std::vector<std::uint32_t> expected;
+    for (std::size_t i = 0; i < coords.size(); ++i) {
+        const ChunkBounds bounds = GetChunkBounds(coords[i]);
+        if (frustum.IntersectsAabb(bounds.min, bounds.max)) {
+            expected.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+    Require(visible == expected, "Hierarchical chunk culling differs from per-chunk frustum tests.", state);
+    Require(tree.Stats().boxTests < coords.size(), "Hierarchical chunk culling should skip hidden regions.", state);
+
+    renderer::ChunkRenderList list;
+    for (const ChunkCoord& coord : coords) {
+        list.Upsert(coord, std::make_shared<ChunkEntry>());
+    }
+    renderer::ChunkCuller culler;
+    renderer::ChunkCullOptions options;
+    options.renderRadius = 6;
+    std::vector<std::uint32_t> drawn;
+    const renderer::ChunkCullResult first = culler.Cull(list, frustum, options, drawn);
+    options.playerChunk = ChunkCoord{5, 0, 0};
+    list.Upsert(coords.front(), std::make_shared<ChunkEntry>());
+    const renderer::ChunkCullResult moved = culler.Cull(list, frustum, options, drawn);
+    Require(culler.TreeStats().builds == 1 && first.distanceCulled != moved.distanceCulled,
+            "The culler should keep its tree across player moves and remeshes.", state);
+    list.Remove(coords.back());
+    culler.Cull(list, frustum, options, drawn);
+    Require(culler.TreeStats().builds == 2, "The culler should rebuild its tree when the render list changes.",
+            state);
+}
+
+void CheckRenderList(VerifyState& state) {
+    using namespace voxel;
+    renderer::ChunkRenderList list;
+    auto first = std::make_shared<ChunkEntry>();
+    auto second = std::make_shared<ChunkEntry>();
+    list.Upsert({0, 0, 0}, first);
+    list.Upsert({1, 0, 0}, first);
+    list.Upsert({2, 0, 0}, first);
+    list.Upsert({1, 0, 0}, second);
+    Require(list.Size() == 3 && list.Chunks()[1].entry == second, "Render list upsert should replace in place.",
+            state);
+    Require(list.Remove({0, 0, 0}) && !list.Remove({0, 0, 0}), "Render list removes a chunk exactly once.", state);
+    bool consistent = list.Size() == 2;
+    for (const renderer::RenderChunk& chunk : list.Chunks()) {
+        consistent = consistent && list.Contains(chunk.coord);
+    }
+    list.Remove({2, 0, 0});
+    consistent = consistent && list.Size() == 1 && list.Chunks()[0].coord == ChunkCoord{1, 0, 0};
+    Require(consistent, "Render list slots out of sync after removal.", state);
+}
+
+void CheckFarTerrain(VerifyState& state) {
+    using namespace voxel;
+    WorldGenerator generator;
+    renderer::FarTerrainConfig config;
+    config.radiusChunks = 12;
+
+    // Tile 0,0 holds columns 0..3; the hole covers columns 2..3 on both axes.
+    renderer::FarTilePlan plan;
+    plan.hole = renderer::ColumnRect{2, 2, 3, 3};
+    ChunkMesh mesh;
+    glm::vec3 boundsMin{0.0f};
+    glm::vec3 boundsMax{0.0f};
+    renderer::BuildFarTerrainTile(generator, plan, config, mesh, boundsMin, boundsMax);
+
+    bool heightsMatch = true;
+    for (const VoxelVertex& vertex : mesh.Vertices()) {
+        const int x = static_cast<int>(vertex.position.x);
+        const int z = static_cast<int>(vertex.position.z);
+        heightsMatch = heightsMatch && vertex.position.y == static_cast<float>(generator.SurfaceHeight(x, z) + 1) &&
+                       vertex.position.y >= boundsMin.y && vertex.position.y <= boundsMax.y;
+    }
+    Require(heightsMatch, "Far terrain vertices should sit on the generator surface.", state);
+
+    bool holeSkipped = true;
+    const auto& indices = mesh.Indices();
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const glm::vec3 centre = (mesh.Vertices()[indices[i]].position + mesh.Vertices()[indices[i + 1]].position +
+                                  mesh.Vertices()[indices[i + 2]].position) /
+                                 3.0f;
+        const int columnX = static_cast<int>(std::floor(centre.x / static_cast<float>(kChunkSize)));
+        const int columnZ = static_cast<int>(std::floor(centre.z / static_cast<float>(kChunkSize)));
+        holeSkipped = holeSkipped && !plan.hole.Contains(columnX, columnZ);
+    }
+    const std::size_t cellsPerColumn = static_cast<std::size_t>(kChunkSize / config.cellBlocks) *
+                                       static_cast<std::size_t>(kChunkSize / config.cellBlocks);
+    Require(holeSkipped && indices.size() == 12 * cellsPerColumn * 6 &&
+                mesh.Faces()[2].indexCount == indices.size(),
+            "Far terrain tile should cover every column outside the hole.", state);
+
+    // One chunk of movement only touches tiles along the hole edge and the ring border.
+    std::vector<renderer::FarTilePlan> before;
+    std::vector<renderer::FarTilePlan> after;
+    renderer::PlanFarTerrainTiles({0, 0, 0}, 4, config, before);
+    renderer::PlanFarTerrainTiles({1, 0, 0}, 4, config, after);
+    bool holesExcluded = true;
+    std::size_t changed = 0;
+    for (const renderer::FarTilePlan& next : after) {
+        holesExcluded = holesExcluded && !(next.hole.minX == next.tileX * config.tileChunks &&
+                                           next.hole.maxX == next.tileX * config.tileChunks + config.tileChunks - 1 &&
+                                           next.hole.minZ == next.tileZ * config.tileChunks &&
+                                           next.hole.maxZ == next.tileZ * config.tileChunks + config.tileChunks - 1);
+        auto it = std::find_if(before.begin(), before.end(), [&](const renderer::FarTilePlan& prev) {
+            return prev.tileX == next.tileX && prev.tileZ == next.tileZ;
+        });
+        if (it == before.end() || !(it->hole == next.hole)) {
+            ++changed;
+        }
+    }
+    Require(holesExcluded && !after.empty() && changed * 2 < after.size(),
+            "Far terrain should only rebuild tiles whose hole or ring membership changed.", state);
+}
+
+void CheckUploadBudget(VerifyState& state) {
+    voxel::UploadBudgetConfig config;
+    config.targetMs = 2.0;
+    config.initialBytes = 1000;
+    config.minBytes = 100;
+    config.maxBytes = 100000;
+    config.smoothing = 0.5;
+    voxel::UploadBudget budget(config);
+
+    Require(budget.Allows(0, 50000, 10.0), "The first upload of a frame should always fit.", state);
+    Require(budget.Allows(400, 600, 1.0) && !budget.Allows(400, 601, 1.0),
+            "Uploads past the byte budget should wait for the next frame.", state);
+    Require(!budget.Allows(400, 100, 2.0), "Uploads past the time budget should wait for the next frame.", state);
+
+    budget.Record(4000, 1.0);
+    Require(budget.FrameBytes() == 8000, "Byte budget should follow measured throughput.", state);
+    budget.Record(0, 0.0);
+    budget.Record(2000, 1.0);
+    Require(budget.FrameBytes() == 6000, "Byte budget should smooth throughput and ignore idle frames.", state);
+    budget.Record(1000000, 1.0);
+    Require(budget.FrameBytes() == config.maxBytes, "Byte budget should stay within its limits.", state);
+}
+
+void CheckStreamingBudget(VerifyState& state) {
+    using namespace voxel;
+    StreamingBudgetConfig config;
+    config.smoothing = 1.0;
+    config.maxCreates = 5;
+    const StreamingBudgets initial{3, 2, 64};
+    auto frame = [](double frameMs, double uploadMs, double idle) {
+        return StreamingFrameSample{frameMs, uploadMs, idle, true, true, true};
+    };
+
+    StreamingBudgetConfig fixedConfig = config;
+    fixedConfig.adaptive = false;
+    StreamingBudget fixed(fixedConfig, initial);
+    for (int i = 0; i < 20; ++i) {
+        fixed.Update(frame(40.0, 10.0, 0.0));
+    }
+    Require(fixed.Current().creates == 3 && fixed.Current().meshes == 2 && fixed.Current().uploads == 64,
+            "Fixed streaming budgets should keep the configured limits.", state);
+
+    StreamingBudget budget(config, initial);
+    for (int i = 0; i < 40; ++i) {
+        budget.Update(frame(10.0, 0.5, 0.6));
+    }
+    Require(budget.Current().creates == config.maxCreates && budget.Current().meshes > 2 &&
+                budget.Current().uploads > 64,
+            "Streaming budgets should grow to their limits with frame headroom and idle workers.", state);
+
+    const StreamingBudgets grown = budget.Current();
+    for (int i = 0; i < 5; ++i) {
+        budget.Update(frame(30.0, 8.0, 0.6));
+    }
+    Require(budget.Current().creates == grown.creates && budget.Current().uploads < grown.uploads,
+            "Slow frames dominated by uploads should cut uploads first.", state);
+    for (int i = 0; i < 60; ++i) {
+        budget.Update(frame(30.0, 0.5, 0.6));
+    }
+    Require(budget.Current().creates == config.minCreates && budget.Current().meshes == config.minMeshes &&
+                budget.Current().uploads == config.minUploads,
+            "Slow frames should shrink every budget to its minimum.", state);
+
+    StreamingBudget saturated(config, initial);
+    for (int i = 0; i < 20; ++i) {
+        saturated.Update(frame(10.0, 0.5, 0.0));
+    }
+    Require(saturated.Current().creates == config.minCreates && saturated.Current().uploads > 64,
+            "Saturated workers should stop job budgets from growing.", state);
+}
+
+void CheckIncrementalStreaming(VerifyState& state) {
+    using namespace voxel;
+    std::size_t faceCoords = 0;
+    const ChunkRegion before{ChunkCoord{-2, 0, -2}, ChunkCoord{2, 1, 2}};
+    const ChunkRegion after{ChunkCoord{-1, 0, -2}, ChunkCoord{3, 1, 2}};
+    ForEachOutside(after, before, [&](const ChunkCoord& coord) {
+        if (coord.x == 3) {
+            ++faceCoords;
+        }
+    });
+    std::size_t disjointCoords = 0;
+    ForEachOutside(after, ChunkRegion{}, [&](const ChunkCoord&) { ++disjointCoords; });
+    Require(faceCoords == 10 && disjointCoords == after.Volume(),
+            "Region diffs should visit only the entering face.", state);
+
+    ChunkStreamingConfig config;
+    config.loadRadius = 2;
+    config.renderRadius = 2;
+    config.verticalRadius = 0;
+    config.unloadMargin = 0;
+    config.budget.adaptive = false;
+    ChunkRegistry registry;
+    ChunkMesher mesher;
+    ChunkStreaming streaming(config);
+    registry.GetOrCreateEntry(ChunkCoord{10, 0, 10});
+    streaming.Tick(ChunkCoord{0, 0, 0}, registry, mesher);
+    Require(registry.LoadedCount() == 25 && !registry.TryGetEntry(ChunkCoord{10, 0, 10}) &&
+                streaming.Stats().pendingChunks == 25,
+            "The first streaming tick should load the region and sweep foreign chunks.", state);
+
+    streaming.Tick(ChunkCoord{1, 0, 0}, registry, mesher);
+    Require(registry.LoadedCount() == 25 && !registry.TryGetEntry(ChunkCoord{-2, 0, 0}) &&
+                registry.TryGetEntry(ChunkCoord{3, 0, 0}) && streaming.Stats().pendingChunks == 25,
+            "Moving one chunk should swap one face of the region and its pending chunks.", state);
+}
+
+void CheckChunkPrefetch(VerifyState& state) {
+    using namespace voxel;
+    ChunkPrefetchConfig config;
+    const StreamingMotion walking{glm::vec3{4.0f, 0.0f, 0.0f}, glm::vec3{1.0f, 0.0f, 0.0f}};
+    const StreamingMotion flying{glm::vec3{32.0f, -5.0f, 0.0f}, glm::vec3{-1.0f, 0.0f, 0.0f}};
+    Require(!PlanPrefetch(config, walking, 2, 1, 100).Active(), "Walking speed should not prefetch.", state);
+
+    const PrefetchPlan plan = PlanPrefetch(config, flying, 2, 1, 100);
+    Require(plan.aheadX == 2 && plan.aheadZ == 0 && plan.ExtraChunks(2, 1) == 10,
+            "Prefetch should lead along the velocity and ignore a camera looking back.", state);
+    Require(plan.NearPath(ChunkCoord{0, 0, 0}, ChunkCoord{4, 0, 1}, 2) &&
+                !plan.NearPath(ChunkCoord{0, 0, 0}, ChunkCoord{-3, 0, 0}, 2),
+            "Prefetch priority should follow the predicted path.", state);
+    config.memoryCapBytes = 500;
+    Require(PlanPrefetch(config, flying, 2, 1, 100).aheadX == 1, "Prefetch should stay within its memory cap.",
+            state);
+
+    ChunkStreamingConfig streamingConfig;
+    streamingConfig.loadRadius = 2;
+    streamingConfig.renderRadius = 2;
+    streamingConfig.verticalRadius = 0;
+    streamingConfig.budget.adaptive = false;
+    ChunkRegistry registry;
+    ChunkMesher mesher;
+    ChunkStreaming streaming(streamingConfig);
+    streaming.SetMotion(flying);
+    streaming.Tick(ChunkCoord{0, 0, 0}, registry, mesher);
+    Require(registry.LoadedCount() == 35 && registry.TryGetEntry(ChunkCoord{4, 0, 2}) &&
+                streaming.Stats().prefetchChunks == 10,
+            "Streaming should load the chunks ahead of a fast player.", state);
+}
+
+void CheckChunkCache(VerifyState& state) {
+    using namespace voxel;
+    ChunkCacheConfig cacheConfig;
+    cacheConfig.memoryCapBytes = 300;
+    ChunkCache cache(cacheConfig);
+    std::vector<std::shared_ptr<ChunkEntry>> evicted;
+    for (int x = 0; x < 4; ++x) {
+        cache.Insert(ChunkCoord{x, 0, 0}, std::make_shared<ChunkEntry>(), 100, evicted);
+    }
+    const bool oldestEvicted = !cache.Take(ChunkCoord{0, 0, 0});
+    const bool recentKept = cache.Take(ChunkCoord{1, 0, 0}) != nullptr;
+    Require(oldestEvicted && recentKept && evicted.size() == 1 && cache.Stats().hits == 1 &&
+                cache.Stats().misses == 1 && cache.Stats().chunks == 2 && cache.Stats().bytes == 200,
+            "ChunkCache should evict the least recently inserted chunk to stay under its cap.", state);
+
+    ChunkStreamingConfig config;
+    config.loadRadius = 1;
+    config.renderRadius = 1;
+    config.verticalRadius = 0;
+    config.unloadMargin = 1;
+    config.maxChunkCreatesPerFrame = 0;
+    config.maxChunkMeshesPerFrame = 0;
+    config.budget.adaptive = false;
+    ChunkRegistry registry;
+    ChunkMesher mesher;
+    ChunkStreaming streaming(config);
+    streaming.Tick(ChunkCoord{0, 0, 0}, registry, mesher);
+    registry.ForEachEntry([&](const ChunkCoord&, const std::shared_ptr<ChunkEntry>& entry) {
+        entry->chunk = registry.Pools().chunks.Acquire();
+        entry->chunk->Fill(kBlockAir);
+        entry->generationState.store(GenerationState::Ready, std::memory_order_release);
+    });
+    const auto visited = registry.TryGetEntry(ChunkCoord{-1, 0, 0});
+
+    streaming.Tick(ChunkCoord{1, 0, 0}, registry, mesher);
+    Require(registry.LoadedCount() == 12 && registry.TryGetEntry(ChunkCoord{-1, 0, 0}) == visited,
+            "Chunks inside the unload margin should stay loaded.", state);
+
+    streaming.Tick(ChunkCoord{3, 0, 0}, registry, mesher);
+    Require(!registry.TryGetEntry(ChunkCoord{-1, 0, 0}) && streaming.Stats().cache.chunks == 6,
+            "Generated chunks past the unload margin should move to the cache.", state);
+
+    streaming.Tick(ChunkCoord{0, 0, 0}, registry, mesher);
+    const auto restored = registry.TryGetEntry(ChunkCoord{-1, 0, 0});
+    Require(restored == visited && restored->chunk &&
+                restored->generationState.load(std::memory_order_acquire) == GenerationState::Ready &&
+                streaming.Stats().cache.hits == 6,
+            "Re-entered chunks should come back from the cache with their block data.", state);
+    streaming.ClearCache(registry);
+}
+
 void CheckPersistence(VerifyState& state, const VerifyOptions& options) {
     if (!options.enablePersistence) {
         return;
@@ -213,6 +925,153 @@ void CheckPersistence(VerifyState& state, const VerifyOptions& options) {
     const BlockId* loadedHighData = loadedHigh.Data();
     Require(std::equal(savedHighData, savedHighData + kChunkVolume, loadedHighData),
             "High chunk persistence data mismatch.", state);
+
+    // Chunk files without world.meta are a legacy save; an empty save persists the generator it starts with,
+    // but only once a chunk is saved.
+    WorldGenConfig fresh;
+    fresh.seed = 77u;
+    Require(storage.ResolveWorldGen(fresh).version == kWorldGenLegacy, "Existing save not kept on legacy terrain.",
+            state);
+    persistence::ChunkStorage freshStorage(root / "fresh");
+    freshStorage.ResolveWorldGen(fresh);
+    Require(!std::filesystem::exists(root / "fresh", ec), "Resolving a new save should not write to disk.", state);
+    freshStorage.SaveChunk(lowCoord, savedLow);
+    const std::optional<WorldGenConfig> stored = persistence::ChunkStorage(root / "fresh").LoadWorldGen();
+    Require(stored && stored->version == kWorldGenVersion && stored->seed == 77u,
+            "World generator not persisted with the first chunk of a new save.", state);
+
+    // An unreadable world.meta must not turn a save with chunks into a legacy one, nor be overwritten.
+    const std::filesystem::path meta = root / "fresh" / "world.meta";
+    std::filesystem::resize_file(meta, 3, ec);
+    persistence::ChunkStorage corruptStorage(root / "fresh");
+    Require(corruptStorage.ResolveWorldGen(fresh).version == kWorldGenVersion,
+            "A rejected world.meta should not fall back to legacy terrain.", state);
+    corruptStorage.SaveChunk(highCoord, savedHigh);
+    Require(std::filesystem::file_size(meta, ec) == 3, "A rejected world.meta should be kept as it is.", state);
+}
+
+void CheckLatencyHistogram(VerifyState& state) {
+    bool boundsOk = true;
+    for (std::uint64_t us = 0; us < 200000; us += 1 + us / 7) {
+        const std::uint64_t highest = core::LatencyCounts::BucketHighestUs(core::LatencyCounts::BucketIndex(us));
+        boundsOk = boundsOk && highest >= us && highest - us <= us / core::LatencyCounts::kSubBuckets;
+    }
+    Require(boundsOk, "Latency buckets should bound each value within 1/16.", state);
+
+    core::LatencyHistogram histogram;
+    std::thread other([&histogram] {
+        for (std::uint64_t us = 2; us <= 1000; us += 2) {
+            histogram.Record(us);
+        }
+    });
+    for (std::uint64_t us = 1; us <= 1000; us += 2) {
+        histogram.Record(us);
+    }
+    other.join();
+    core::LatencyCounts counts;
+    histogram.DrainInto(counts);
+    const core::LatencyPercentiles percentiles = counts.Percentiles();
+    Require(percentiles.count == 1000 && percentiles.maxMs == 1.0, "Latency histogram lost concurrent samples.",
+            state);
+    Require(percentiles.p50Ms >= 0.5 && percentiles.p50Ms <= 0.5 * 17.0 / 16.0 && percentiles.p99Ms >= 0.99 &&
+                percentiles.p99Ms <= 1.0,
+            "Latency percentiles should be within one sub-bucket.", state);
+    core::LatencyCounts empty;
+    histogram.DrainInto(empty);
+    Require(empty.count == 0 && empty.maxUs == 0, "Draining should reset the histogram.", state);
+
+    core::Profiler profiler;
+    for (int i = 0; i < 99; ++i) {
+        profiler.AddSample(core::Metric::Frame, std::chrono::microseconds(1000));
+    }
+    profiler.AddSample(core::Metric::Frame, std::chrono::microseconds(50000));
+    const core::ProfilerSnapshot snapshot = profiler.CollectSnapshot();
+    const core::LatencyPercentiles& frame = snapshot.latency[static_cast<std::size_t>(core::Metric::Frame)];
+    Require(frame.p50Ms >= 1.0 && frame.p99Ms <= 1.0625 && frame.p999Ms == 50.0 && frame.maxMs == 50.0,
+            "Profiler snapshots should expose the frame-time tail.", state);
+
+    core::LatencyWindow window;
+    window.Record(1000);
+    const bool firstWindow = window.Percentiles(true).count == 1;
+    window.Record(2000);
+    const bool bothWindows = window.Percentiles(true).count == 2;
+    const core::LatencyPercentiles previousOnly = window.Percentiles(false);
+    Require(firstWindow && bothWindows && previousOnly.count == 1 && previousOnly.maxMs == 2.0,
+            "Latency windows should cover the current and previous window only.", state);
+}
+
+void CheckTraceRecorder(VerifyState& state) {
+    core::Tracer& tracer = core::Tracer::Global();
+    const bool wasEnabled = tracer.Enabled();
+    tracer.SetEnabled(true);
+    tracer.Clear();
+
+    const std::uint64_t flow = tracer.NextFlowId();
+    {
+        core::TraceScope scope("VerifyProducer");
+        core::TraceFlow(core::TracePhase::FlowStart, "VerifyFlow", flow);
+        core::TraceCounter("VerifyCounter", 42);
+        const std::int64_t now = core::SteadyNowNs();
+        core::TraceAsyncSpan("VerifySpan", flow, now - 1000, now);
+        core::TraceAsyncSpan("VerifyUnmeasured", flow, 0, now);
+    }
+    std::thread consumer([flow] {
+        core::Tracer::Global().SetThreadName("VerifyThread");
+        core::TraceScope scope("VerifyConsumer");
+        core::TraceFlow(core::TracePhase::FlowEnd, "VerifyFlow", flow);
+    });
+    consumer.join();
+
+    std::ostringstream json;
+    const std::size_t written = tracer.WriteChromeJson(json);
+    const std::string text = json.str();
+    Require(written == 9, "Trace export should hold every recorded event.", state);
+    Require(text.find("\"name\":\"VerifyThread\"") != std::string::npos,
+            "Trace export should name threads.", state);
+    Require(text.find("\"ph\":\"s\",\"pid\":1") != std::string::npos &&
+                text.find("\"id\":" + std::to_string(flow) + ",\"bp\":\"e\"") != std::string::npos,
+            "Trace flows should start and end across threads.", state);
+    Require(text.find("\"args\":{\"value\":42}") != std::string::npos, "Trace counters should keep values.", state);
+    Require(text.find("\"ph\":\"b\"") != std::string::npos && text.find("VerifyUnmeasured") == std::string::npos,
+            "Trace async spans should export measured spans only.", state);
+
+    // Holding every ring at once guarantees the consumer's ring is handed to one of these threads.
+    const std::size_t rings = tracer.Stats().threads;
+    std::atomic<std::size_t> claimed{0};
+    std::vector<std::thread> claimers;
+    for (std::size_t i = 0; i < rings; ++i) {
+        claimers.emplace_back([&claimed, rings] {
+            core::TraceCounter("VerifyHandover", 1);
+            claimed.fetch_add(1);
+            while (claimed.load() < rings) {
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (std::thread& claimer : claimers) {
+        claimer.join();
+    }
+    std::ostringstream handover;
+    tracer.WriteChromeJson(handover);
+    Require(handover.str().find("VerifyThread") == std::string::npos &&
+                handover.str().find("VerifyConsumer") == std::string::npos,
+            "A recycled trace ring should drop the previous thread's name and events.", state);
+
+    tracer.Clear();
+    for (std::size_t i = 0; i < core::Tracer::kRingCapacity + 10; ++i) {
+        core::TraceCounter("VerifyWrap", static_cast<std::int64_t>(i));
+    }
+    const core::TraceStats stats = tracer.Stats();
+    Require(stats.bufferedEvents == core::Tracer::kRingCapacity &&
+                stats.recordedEvents == core::Tracer::kRingCapacity + 10,
+            "A full trace ring should keep only the newest events.", state);
+
+    tracer.SetEnabled(false);
+    core::TraceCounter("VerifyDisabled", 1);
+    Require(tracer.Stats().recordedEvents == stats.recordedEvents, "A disabled tracer should record nothing.", state);
+
+    tracer.Clear();
+    tracer.SetEnabled(wasEnabled);
 }
 
 void CheckJobScheduling(VerifyState& state) {
@@ -230,6 +1089,225 @@ void CheckJobScheduling(VerifyState& state) {
     Require(first, "First remesh request should succeed.", state);
     Require(!second, "Second remesh request should be rejected.", state);
     Require(streaming.MeshQueue().size() == 1, "Remesh queue should only contain one job.", state);
+
+    // A full mesh ring must not block the main thread; the chunk keeps its mesh and retries later.
+    while (streaming.MeshQueue().try_push(MeshJob{})) {
+    }
+    entry->meshingState.store(MeshingState::Ready, std::memory_order_release);
+    const bool full = streaming.RequestRemesh(coord, registry);
+    Require(!full && entry->remeshPending &&
+                entry->meshingState.load(std::memory_order_acquire) == MeshingState::Ready,
+            "A remesh against a full ring should fail without blocking and stay requested.", state);
+    MeshJob drained;
+    while (streaming.MeshQueue().try_pop(drained)) {
+    }
+    Require(streaming.RequestRemesh(coord, registry) && !entry->remeshPending,
+            "A retried remesh should queue once the ring drains.", state);
+}
+
+void CheckPipelineTimeline(VerifyState& state) {
+    using namespace voxel;
+    ChunkRegistry registry;
+    ChunkMesher mesher;
+    ChunkStreaming streaming;
+    core::WorkerPool pool;
+    pool.Start(1, streaming.GenerateQueue(), streaming.MeshQueue(), streaming.UploadQueue(), registry, mesher, nullptr);
+
+    auto waitFor = [](auto&& done) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!done()) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    };
+
+    const ChunkCoord coord{0, 0, 0};
+    auto entry = registry.GetOrCreateEntry(coord);
+    entry->timeline.generateQueuedNs.store(core::SteadyNowNs());
+    entry->generationState.store(GenerationState::Queued, std::memory_order_release);
+    streaming.GenerateQueue().push(GenerateJob{coord, entry, 0});
+    pool.NotifyWork();
+    const bool generated = waitFor(
+        [&] { return entry->generationState.load(std::memory_order_acquire) == GenerationState::Ready; });
+
+    entry->meshingState.store(MeshingState::Queued, std::memory_order_release);
+    streaming.MeshQueue().push(MeshJob{coord, entry, 0, core::SteadyNowNs()});
+    pool.NotifyWork();
+    MeshReady ready;
+    const bool meshed = waitFor([&] { return streaming.UploadQueue().try_pop(ready); });
+    pool.Stop();
+
+    const ChunkTimeline& timeline = entry->timeline;
+    Require(generated && timeline.generateQueuedNs.load() <= timeline.generateStartNs.load() &&
+                timeline.generateStartNs.load() <= timeline.generatedNs.load(),
+            "Generate jobs should stamp ordered start and finish times.", state);
+    Require(meshed && ready.timing.queuedNs > 0 && ready.timing.queuedNs <= ready.timing.startNs &&
+                ready.timing.startNs <= ready.timing.litNs && ready.timing.litNs <= ready.timing.meshedNs,
+            "Mesh jobs should carry ordered queue, light and mesh times.", state);
+    if (ready.cpuMesh) {
+        voxel::RecycleMeshScratch(registry.Pools(), std::move(ready.cpuMesh));
+    }
+}
+
+void CheckMpmcQueue(VerifyState& state) {
+    core::MpmcQueue<int> queue(3);
+    Require(queue.capacity() == 4, "MpmcQueue capacity should round up to a power of two.", state);
+    for (int i = 0; i < 4; ++i) {
+        Require(queue.try_push(int{i}), "MpmcQueue rejected push below capacity.", state);
+    }
+    Require(!queue.try_push(4), "MpmcQueue accepted push beyond capacity.", state);
+    Require(queue.size() == 4, "MpmcQueue size mismatch when full.", state);
+    for (int i = 0; i < 4; ++i) {
+        int value = -1;
+        Require(queue.try_pop(value) && value == i, "MpmcQueue did not pop in FIFO order.", state);
+    }
+    int value = -1;
+    Require(!queue.try_pop(value) && queue.empty(), "MpmcQueue should be empty after draining.", state);
+}
+
+void CheckRangeAllocator(VerifyState& state) {
+    core::RangeAllocator allocator(100);
+    const auto a = allocator.Allocate(30);
+    const auto b = allocator.Allocate(20);
+    const auto c = allocator.Allocate(30);
+    Require(a && b && c && a->offset == 0 && b->offset == 30 && c->offset == 50,
+            "RangeAllocator should pack fresh allocations from offset 0.", state);
+    Require(!allocator.Allocate(25), "RangeAllocator allocated past capacity.", state);
+
+    allocator.Free(*a);
+    allocator.Free(*c);
+    core::RangeAllocatorStats stats = allocator.Stats();
+    Require(stats.freeBlocks == 2 && stats.largestFree == 50 && stats.fragmentation > 0.0f,
+            "RangeAllocator fragmentation stats mismatch.", state);
+    const auto bestFit = allocator.Allocate(25);
+    Require(bestFit && bestFit->offset == 0, "RangeAllocator did not pick the best-fitting block.", state);
+    allocator.Free(*bestFit);
+
+    allocator.Free(*b);
+    stats = allocator.Stats();
+    Require(stats.used == 0 && stats.freeBlocks == 1 && stats.largestFree == 100 && stats.fragmentation == 0.0f,
+            "RangeAllocator did not coalesce freed neighbours.", state);
+
+    const auto full = allocator.Allocate(100);
+    allocator.Grow(160);
+    const auto grown = allocator.Allocate(60);
+    Require(full && grown && grown->offset == 100, "RangeAllocator grow did not extend the top.", state);
+}
+
+void CheckChunkPoolRecycling(VerifyState& state) {
+    using namespace voxel;
+    ChunkRegistry registry;
+    ChunkCoord coord{0, 0, 0};
+    auto entry = registry.GetOrCreateEntry(coord);
+    {
+        std::unique_lock<std::shared_mutex> lock(entry->dataMutex);
+        entry->chunk = registry.Pools().chunks.Acquire();
+        entry->chunk->Fill(kBlockAir);
+        entry->generationState.store(GenerationState::Ready, std::memory_order_release);
+    }
+    const Chunk* original = entry->chunk.get();
+    registry.RemoveChunk(coord);
+    Require(!entry->chunk, "RemoveChunk should hand chunk storage back to the pool.", state);
+
+    auto recycled = registry.Pools().chunks.Acquire();
+    const core::PoolStats stats = registry.Pools().chunks.Stats();
+    Require(recycled.get() == original, "Chunk pool did not reuse released storage.", state);
+    Require(stats.hits == 1 && stats.misses == 1, "Chunk pool hit/miss counters mismatch.", state);
+    Require(stats.peakBytes >= sizeof(Chunk), "Chunk pool peak bytes not tracked.", state);
+
+    registry.Pools().chunks.Release(std::make_unique<Chunk>());
+    Require(registry.Pools().chunks.Stats().inUse == stats.inUse,
+            "Releasing a chunk the pool never handed out should not change its live count.", state);
+}
+
+void CheckMemoryLedger(VerifyState& state) {
+    using namespace voxel;
+    MemoryLedger ledger;
+    ledger.Add(MemoryCategory::BlockData, 300);
+    ledger.Add(MemoryCategory::Light, 200);
+    ledger.Remove(MemoryCategory::BlockData, 300);
+    ledger.Add(MemoryCategory::GpuMesh, 100);
+    const std::size_t blockIndex = static_cast<std::size_t>(MemoryCategory::BlockData);
+    MemorySnapshot snapshot = ledger.Snapshot();
+    Require(snapshot.totalBytes == 300 && snapshot.peakTotalBytes == 500 && snapshot.bytes[blockIndex] == 0 &&
+                snapshot.peakBytes[blockIndex] == 300,
+            "MemoryLedger current and peak bytes mismatch.", state);
+    ledger.ResetPeaks();
+    snapshot = ledger.Snapshot();
+    Require(snapshot.peakTotalBytes == 300 && snapshot.peakBytes[blockIndex] == 0,
+            "MemoryLedger ResetPeaks should restart at the current bytes.", state);
+
+    // The global ledger follows pools, meshes and queues as they come and go.
+    auto bytesOf = [](MemoryCategory category) {
+        return MemoryLedger::Global().Snapshot().bytes[static_cast<std::size_t>(category)];
+    };
+    const std::size_t blocksBefore = bytesOf(MemoryCategory::BlockData);
+    const std::size_t freeBefore = bytesOf(MemoryCategory::PoolFree);
+    {
+        ChunkPools pools;
+        auto chunk = pools.chunks.Acquire();
+        Require(bytesOf(MemoryCategory::BlockData) == blocksBefore + sizeof(Chunk),
+                "Acquired chunks should count as block data.", state);
+        pools.chunks.Release(std::move(chunk));
+        Require(bytesOf(MemoryCategory::BlockData) == blocksBefore &&
+                    bytesOf(MemoryCategory::PoolFree) == freeBefore + sizeof(Chunk),
+                "Released chunks should move from block data to pool free.", state);
+    }
+    Require(bytesOf(MemoryCategory::PoolFree) == freeBefore, "Destroyed pools should drop their free bytes.", state);
+
+    const std::size_t gpuBefore = bytesOf(MemoryCategory::GpuMesh);
+    NullMeshStore store;
+    ChunkMesh mesh;
+    mesh.Vertices().resize(4);
+    mesh.Indices().resize(6);
+    mesh.UploadToGpu(store);
+    const std::size_t meshBytes = 4 * sizeof(VoxelVertex) + 6 * sizeof(std::uint32_t);
+    Require(bytesOf(MemoryCategory::GpuMesh) == gpuBefore + meshBytes, "Uploaded meshes should count as GPU mesh.",
+            state);
+    mesh.Indices().resize(3);
+    mesh.UploadToGpu(store);
+    Require(bytesOf(MemoryCategory::GpuMesh) == gpuBefore + meshBytes - 3 * sizeof(std::uint32_t),
+            "Remeshing should replace the previous upload's bytes.", state);
+    mesh.DestroyGpu();
+    Require(bytesOf(MemoryCategory::GpuMesh) == gpuBefore, "Destroyed meshes should leave the GPU count.", state);
+
+    const std::size_t queuesBefore = bytesOf(MemoryCategory::Queues);
+    {
+        MpmcQueue<int> queue(16);
+        Require(bytesOf(MemoryCategory::Queues) == queuesBefore + queue.StorageBytes(),
+                "Queue rings should count as queue memory.", state);
+    }
+    Require(bytesOf(MemoryCategory::Queues) == queuesBefore, "Destroyed queues should leave the queue count.", state);
+
+    // A chunk unloaded while its generate job runs must not strand the generated block data.
+    ChunkRegistry registry;
+    ChunkMesher mesher;
+    ChunkStreaming streaming;
+    const ChunkCoord coord{0, 0, 0};
+    auto entry = registry.GetOrCreateEntry(coord);
+    const std::size_t generateBefore = bytesOf(MemoryCategory::BlockData);
+    entry->generationState.store(GenerationState::Queued, std::memory_order_release);
+    streaming.GenerateQueue().try_push(GenerateJob{coord, entry, 0});
+    core::WorkerPool pool;
+    {
+        // Holding the data lock parks the worker between generating and publishing.
+        std::unique_lock<std::shared_mutex> lock(entry->dataMutex);
+        pool.Start(1, streaming.GenerateQueue(), streaming.MeshQueue(), streaming.UploadQueue(), registry, mesher,
+                   nullptr);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (entry->generationState.load(std::memory_order_acquire) != GenerationState::Generating &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        registry.DetachEntry(coord);
+    }
+    registry.ReleaseEntry(*entry);
+    pool.Stop();
+    Require(!entry->chunk && bytesOf(MemoryCategory::BlockData) == generateBefore,
+            "Unloading a chunk mid-generation should return its block data to the pool.", state);
 }
 
 void CheckWorkerPoolShutdown(VerifyState& state) {
@@ -253,9 +1331,31 @@ VerifyResult RunAll(const VerifyOptions& options) {
     CheckRegistryReadOnly(state);
     CheckRaycast(state);
     CheckEditNeighborRemesh(state);
+    CheckColumnGeneration(state);
+    CheckBatchedHeights(state);
+    CheckWorldGenPipeline(state);
     CheckMesherVerticalNeighbors(state);
+    CheckMeshFaceRanges(state);
+    CheckBlockRegistry(state);
+    CheckLodMeshes(state);
+    CheckChunkVisibility(state);
+    CheckFrustumCulling(state);
+    CheckRenderList(state);
+    CheckFarTerrain(state);
+    CheckUploadBudget(state);
+    CheckStreamingBudget(state);
+    CheckIncrementalStreaming(state);
+    CheckChunkPrefetch(state);
+    CheckChunkCache(state);
+    CheckLatencyHistogram(state);
+    CheckTraceRecorder(state);
     CheckJobScheduling(state);
+    CheckPipelineTimeline(state);
     CheckPersistence(state, options);
+    CheckMpmcQueue(state);
+    CheckRangeAllocator(state);
+    CheckChunkPoolRecycling(state);
+    CheckMemoryLedger(state);
     CheckWorkerPoolShutdown(state);
 
     if (state.ok) {
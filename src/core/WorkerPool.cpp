@@ -1,19 +1,22 @@
 #include "core/WorkerPool.h"
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <shared_mutex>
+#include <string>
 
 #include "core/Assert.h"
+#include "core/Trace.h"
 #include "voxel/ChunkMesher.h"
 #include "voxel/ChunkRegistry.h"
 
 namespace core {
 
 void WorkerPool::Start(std::size_t threadCount,
-                       ThreadSafeQueue<voxel::GenerateJob>& generateQueue,
-                       ThreadSafeQueue<voxel::MeshJob>& meshQueue,
-                       ThreadSafeQueue<voxel::MeshReady>& readyQueue,
+                       MpmcQueue<voxel::GenerateJob>& generateQueue,
+                       MpmcQueue<voxel::MeshJob>& meshQueue,
+                       MpmcQueue<voxel::MeshReady>& readyQueue,
                        voxel::ChunkRegistry& registry,
                        const voxel::ChunkMesher& mesher,
                        core::Profiler* profiler) {
@@ -30,9 +33,14 @@ void WorkerPool::Start(std::size_t threadCount,
     mesher_ = &mesher;
     profiler_ = profiler;
 
+    sampleStartNs_ = SteadyNowNs();
+    sampleBusyNs_ = busyNs_.load(std::memory_order_relaxed);
     threads_.reserve(threadCount);
     for (std::size_t i = 0; i < threadCount; ++i) {
-        threads_.emplace_back([this]() { WorkerLoop(); });
+        threads_.emplace_back([this, i]() {
+            Tracer::Global().SetThreadName("Worker " + std::to_string(i));
+            WorkerLoop();
+        });
     }
 
     std::cout << "[Workers] Started " << threads_.size() << " worker thread(s).\n";
@@ -64,17 +72,37 @@ std::size_t WorkerPool::ThreadCount() const {
     return threads_.size();
 }
 
+double WorkerPool::SampleIdleRatio() {
+    if (threads_.empty()) {
+        return -1.0;
+    }
+    const std::int64_t now = SteadyNowNs();
+    const std::int64_t busy = busyNs_.load(std::memory_order_relaxed);
+    const double capacity = static_cast<double>(now - sampleStartNs_) * static_cast<double>(threads_.size());
+    const double used = static_cast<double>(busy - sampleBusyNs_);
+    sampleStartNs_ = now;
+    sampleBusyNs_ = busy;
+    if (capacity <= 0.0) {
+        return 1.0;
+    }
+    return std::clamp(1.0 - used / capacity, 0.0, 1.0);
+}
+
 void WorkerPool::WorkerLoop() {
     while (!stop_.load()) {
         voxel::GenerateJob generateJob;
         if (generateQueue_ && generateQueue_->try_pop(generateJob)) {
+            const std::int64_t start = SteadyNowNs();
             ExecuteGenerate(generateJob);
+            busyNs_.fetch_add(SteadyNowNs() - start, std::memory_order_relaxed);
             continue;
         }
 
         voxel::MeshJob meshJob;
         if (meshQueue_ && meshQueue_->try_pop(meshJob)) {
+            const std::int64_t start = SteadyNowNs();
             ExecuteMesh(meshJob);
+            busyNs_.fetch_add(SteadyNowNs() - start, std::memory_order_relaxed);
             continue;
         }
 
@@ -104,20 +132,30 @@ void WorkerPool::ExecuteGenerate(const voxel::GenerateJob& job) {
         return;
     }
 
-    voxel::Chunk chunk;
-    voxel::ChunkRegistry::GenerateChunkData(job.coord, chunk);
+    entry->timeline.generateStartNs.store(SteadyNowNs(), std::memory_order_relaxed);
+    auto chunk = registry_->Pools().chunks.Acquire();
+    registry_->GenerateChunkData(job.coord, *chunk);
 
     {
+        // UnloadChunk clears wanted before ReleaseEntry takes this lock, so a chunk published here is always
+        // handed back to the pool; one published into an already released entry would never be.
         std::unique_lock<std::shared_mutex> lock(entry->dataMutex);
-        entry->chunk = std::make_unique<voxel::Chunk>(std::move(chunk));
+        if (!entry->wanted.load()) {
+            lock.unlock();
+            registry_->Pools().chunks.Release(std::move(chunk));
+            entry->generationState.store(voxel::GenerationState::NotScheduled, std::memory_order_release);
+            std::cout << "[Workers] Generated chunk then found it unloaded.\n";
+            return;
+        }
+        entry->chunk = std::move(chunk);
     }
 
+    TraceFlow(TracePhase::FlowStep, "Chunk", job.traceFlow);
+    entry->traceFlow.store(job.traceFlow, std::memory_order_release);
+    entry->timeline.generatedNs.store(SteadyNowNs(), std::memory_order_relaxed);
     entry->generationState.store(voxel::GenerationState::Ready, std::memory_order_release);
     entry->dirty.store(false, std::memory_order_release);
 
-    if (!entry->wanted.load()) {
-        std::cout << "[Workers] Generated chunk then found it unloaded.\n";
-    }
 }
 
 void WorkerPool::ExecuteMesh(const voxel::MeshJob& job) {
@@ -143,6 +181,14 @@ void WorkerPool::ExecuteMesh(const voxel::MeshJob& job) {
         return;
     }
 
+    voxel::MeshTiming timing{job.queuedNs, SteadyNowNs(), 0, 0};
+    // Far chunks mesh at a coarser LOD without light, so they never allocate light volumes.
+    const int lod = entry->lod.load(std::memory_order_acquire);
+    if (lod == 0) {
+        registry_->EnsureLightForNeighborhood(job.coord);
+        timing.litNs = SteadyNowNs();
+    }
+
     std::shared_lock<std::shared_mutex> chunkLock(entry->dataMutex);
     const voxel::Chunk* chunk = entry->chunk.get();
     if (!chunk) {
@@ -151,11 +197,29 @@ void WorkerPool::ExecuteMesh(const voxel::MeshJob& job) {
         return;
     }
 
-    voxel::ChunkMeshCpu cpuMesh;
-    mesher_->BuildMesh(job.coord, *chunk, *registry_, cpuMesh);
+    auto cpuMesh = registry_->Pools().meshScratch.Acquire();
+    if (lod == 0) {
+        mesher_->BuildMesh(job.coord, *chunk, *registry_, *cpuMesh);
+    } else {
+        mesher_->BuildLodMesh(job.coord, *chunk, lod, *registry_, *cpuMesh);
+    }
 
-    auto meshPayload = std::make_shared<voxel::ChunkMeshCpu>(std::move(cpuMesh));
-    readyQueue_->push(voxel::MeshReady{job.coord, job.entry, std::move(meshPayload)});
+    chunkLock.unlock();
+
+    timing.meshedNs = SteadyNowNs();
+    voxel::TrackBuiltMesh(*cpuMesh);
+    TraceFlow(TracePhase::FlowStep, "Chunk", job.traceFlow);
+    // The main thread drains uploads every frame and never waits on a worker, so a full ring frees up;
+    // on shutdown nobody drains it and the mesh is dropped instead.
+    voxel::MeshReady ready{job.coord, job.entry, std::move(cpuMesh), job.traceFlow, timing};
+    while (!readyQueue_->try_push(std::move(ready))) {
+        if (stop_.load()) {
+            voxel::RecycleMeshScratch(registry_->Pools(), std::move(ready.cpuMesh));
+            entry->meshingState.store(voxel::MeshingState::NotScheduled, std::memory_order_release);
+            return;
+        }
+        std::this_thread::yield();
+    }
     entry->meshingState.store(voxel::MeshingState::Ready, std::memory_order_release);
     entry->gpuState.store(voxel::GpuState::UploadQueued, std::memory_order_release);
 }
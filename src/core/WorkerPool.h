@@ -3,12 +3,13 @@
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <mutex>
 #include <thread>
 #include <vector>
 
+#include "core/MpmcQueue.h"
 #include "core/Profiler.h"
-#include "core/ThreadSafeQueue.h"
 #include "voxel/ChunkJobs.h"
 
 namespace voxel {
@@ -25,9 +26,9 @@ public:
     WorkerPool& operator=(const WorkerPool&) = delete;
 
     void Start(std::size_t threadCount,
-               ThreadSafeQueue<voxel::GenerateJob>& generateQueue,
-               ThreadSafeQueue<voxel::MeshJob>& meshQueue,
-               ThreadSafeQueue<voxel::MeshReady>& readyQueue,
+               MpmcQueue<voxel::GenerateJob>& generateQueue,
+               MpmcQueue<voxel::MeshJob>& meshQueue,
+               MpmcQueue<voxel::MeshReady>& readyQueue,
                voxel::ChunkRegistry& registry,
                const voxel::ChunkMesher& mesher,
                core::Profiler* profiler);
@@ -35,6 +36,9 @@ public:
     void NotifyWork();
 
     std::size_t ThreadCount() const;
+    // Share of worker time spent idle since the previous call, 0..1; -1 without threads. Jobs count
+    // when they finish. Main thread only.
+    double SampleIdleRatio();
 
 private:
     void WorkerLoop();
@@ -44,13 +48,17 @@ private:
     std::atomic<bool> stop_{false};
     std::vector<std::thread> threads_;
 
-    ThreadSafeQueue<voxel::GenerateJob>* generateQueue_ = nullptr;
-    ThreadSafeQueue<voxel::MeshJob>* meshQueue_ = nullptr;
-    ThreadSafeQueue<voxel::MeshReady>* readyQueue_ = nullptr;
+    MpmcQueue<voxel::GenerateJob>* generateQueue_ = nullptr;
+    MpmcQueue<voxel::MeshJob>* meshQueue_ = nullptr;
+    MpmcQueue<voxel::MeshReady>* readyQueue_ = nullptr;
     voxel::ChunkRegistry* registry_ = nullptr;
     const voxel::ChunkMesher* mesher_ = nullptr;
     core::Profiler* profiler_ = nullptr;
 
+    std::atomic<std::int64_t> busyNs_{0};
+    std::int64_t sampleStartNs_ = 0;
+    std::int64_t sampleBusyNs_ = 0;
+
     std::mutex wakeMutex_;
     std::condition_variable wakeCv_;
 };
@@ -16,6 +16,7 @@
 #include "voxel/ChunkCoord.h"
 #include "voxel/ChunkRegistry.h"
 #include "voxel/VoxelCoords.h"
+#include "voxel/WorldGen.h"
 
 namespace core {
 
@@ -46,72 +47,108 @@ bool AppendUniqueChunk(const voxel::ChunkCoord& coord,
     return true;
 }
 
-} // namespace
+std::string ComputeWorldChecksum(std::string& error) {
+    voxel::WorldGenConfig worldGen;
+    worldGen.seed = static_cast<std::uint32_t>(kWorldTestSeed);
+    voxel::ChunkRegistry registry(worldGen);
+    std::unordered_set<voxel::ChunkCoord, voxel::ChunkCoordHash> seen;
+    std::vector<voxel::ChunkCoord> chunkList;
+
+    const std::vector<voxel::ChunkCoord> requiredChunks = {
+        {0, 0, 0},
+        {1, 0, 0},
+        {0, 0, 1},
+        {-1, 0, 0},
+        {0, 0, -1},
+    };
+
+    for (const auto& coord : requiredChunks) {
+        AppendUniqueChunk(coord, seen, chunkList);
+    }
 
-WorldTestResult RunWorldTest() {
-    WorldTestResult result;
-    try {
-        voxel::ChunkRegistry registry;
-        std::unordered_set<voxel::ChunkCoord, voxel::ChunkCoordHash> seen;
-        std::vector<voxel::ChunkCoord> chunkList;
-
-        const std::vector<voxel::ChunkCoord> requiredChunks = {
-            {0, 0, 0},
-            {1, 0, 0},
-            {0, 0, 1},
-            {-1, 0, 0},
-            {0, 0, -1},
-        };
-
-        for (const auto& coord : requiredChunks) {
-            AppendUniqueChunk(coord, seen, chunkList);
+    std::vector<voxel::WorldBlockCoord> queryCoords = {
+        {0, 0, 0},
+        {5, 10, 5},
+        {31, 0, 31},
+        {32, 0, 0},
+        {-1, 0, -1},
+    };
+
+    // A few full chunk columns, so the checksum covers surface layers and carved caves as well.
+    const std::vector<voxel::WorldBlockCoord> columnSamples = {
+        {3, 0, 7},
+        {-20, 0, 14},
+        {45, 0, -9},
+    };
+    for (const auto& column : columnSamples) {
+        for (int y = voxel::kWorldMinY; y < voxel::kWorldMaxY; ++y) {
+            queryCoords.push_back({column.x, y, column.z});
         }
+    }
 
-        const std::vector<voxel::WorldBlockCoord> queryCoords = {
-            {0, 0, 0},
-            {5, 10, 5},
-            {31, 0, 31},
-            {32, 0, 0},
-            {-1, 0, -1},
-        };
+    for (const auto& world : queryCoords) {
+        AppendUniqueChunk(voxel::WorldToChunkCoord(world, voxel::kChunkSize), seen, chunkList);
+    }
 
-        for (const auto& world : queryCoords) {
-            AppendUniqueChunk(voxel::WorldToChunkCoord(world, voxel::kChunkSize), seen, chunkList);
-        }
+    for (const auto& coord : chunkList) {
+        auto entry = registry.GetOrCreateEntry(coord);
+        std::unique_lock<std::shared_mutex> lock(entry->dataMutex);
+        entry->chunk = std::make_unique<voxel::Chunk>();
+        registry.GenerateChunkData(coord, *entry->chunk);
+        entry->generationState.store(voxel::GenerationState::Ready, std::memory_order_release);
+        entry->dirty.store(false, std::memory_order_release);
+    }
 
-        for (const auto& coord : chunkList) {
-            auto entry = registry.GetOrCreateEntry(coord);
-            std::unique_lock<std::shared_mutex> lock(entry->dataMutex);
-            entry->chunk = std::make_unique<voxel::Chunk>();
-            voxel::ChunkRegistry::GenerateChunkData(coord, *entry->chunk);
-            entry->generationState.store(voxel::GenerationState::Ready, std::memory_order_release);
-            entry->dirty.store(false, std::memory_order_release);
+    std::vector<std::uint8_t> buffer;
+    buffer.reserve(queryCoords.size() * (sizeof(std::int32_t) * 3 + sizeof(std::uint16_t)));
+
+    for (const auto& world : queryCoords) {
+        voxel::ChunkCoord chunkCoord = voxel::WorldToChunkCoord(world, voxel::kChunkSize);
+        if (!registry.HasChunk(chunkCoord)) {
+            error = "Missing chunk for query";
+            return {};
+        }
+        auto handle = registry.AcquireChunkRead(chunkCoord);
+        if (!handle || !handle->chunk) {
+            error = "Chunk access failed";
+            return {};
+        }
+        voxel::LocalCoord local = voxel::WorldToLocalCoord(world, voxel::kChunkSize);
+        voxel::BlockId block = handle->chunk->Get(local.x, local.y, local.z);
+        if (block != registry.Generator().SampleBlock(world)) {
+            error = "Generated chunk differs from per-voxel sampling";
+            return {};
         }
 
-        std::vector<std::uint8_t> buffer;
-        buffer.reserve(queryCoords.size() * (sizeof(std::int32_t) * 3 + sizeof(std::uint16_t)));
-
-        for (const auto& world : queryCoords) {
-            voxel::ChunkCoord chunkCoord = voxel::WorldToChunkCoord(world, voxel::kChunkSize);
-            if (!registry.HasChunk(chunkCoord)) {
-                result.message = "Missing chunk for query";
-                return result;
-            }
-            auto handle = registry.AcquireChunkRead(chunkCoord);
-            if (!handle || !handle->chunk) {
-                result.message = "Chunk access failed";
-                return result;
-            }
-            voxel::LocalCoord local = voxel::WorldToLocalCoord(world, voxel::kChunkSize);
-            voxel::BlockId block = handle->chunk->Get(local.x, local.y, local.z);
-
-            AppendInt32(buffer, world.x);
-            AppendInt32(buffer, world.y);
-            AppendInt32(buffer, world.z);
-            AppendUint16(buffer, block);
+        AppendInt32(buffer, world.x);
+        AppendInt32(buffer, world.y);
+        AppendInt32(buffer, world.z);
+        AppendUint16(buffer, block);
+    }
+
+    return core::Sha256Hex(buffer);
+}
+
+} // namespace
+
+WorldTestResult RunWorldTest() {
+    WorldTestResult result;
+    try {
+        // Two independent generators (fresh column caches) must agree for generation to be deterministic.
+        const std::string first = ComputeWorldChecksum(result.message);
+        if (first.empty()) {
+            return result;
+        }
+        const std::string second = ComputeWorldChecksum(result.message);
+        if (second.empty()) {
+            return result;
+        }
+        if (first != second) {
+            result.message = "World generation is not deterministic";
+            return result;
         }
 
-        result.checksum = core::Sha256Hex(buffer);
+        result.checksum = first;
         result.ok = true;
         std::cout << "[WorldTest] seed=" << kWorldTestSeed << " checksum=" << result.checksum << '\n';
         return result;
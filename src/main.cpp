@@ -19,10 +19,9 @@
 #include <shared_mutex>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
-#include "stb_image.h"
-
 #if defined(__linux__)
 #include <execinfo.h>
 #include <unistd.h>
@@ -34,8 +33,12 @@
 #include "app/AppMode.h"
 #include "core/Assert.h"
 #include "core/Cli.h"
+#include "core/ContentionBench.h"
+#include "core/HeightBench.h"
 #include "core/Profiler.h"
+#include "core/QueueBench.h"
 #include "core/Sha256.h"
+#include "core/Trace.h"
 #include "core/Verify.h"
 #include "core/WorldTest.h"
 #include "core/WorkerPool.h"
@@ -43,15 +46,21 @@
 #include "math/Frustum.h"
 #include "persistence/ChunkFormat.h"
 #include "persistence/ChunkStorage.h"
+#include "renderer/BlockTextures.h"
+#include "renderer/ChunkCuller.h"
 #include "renderer/DebugDraw.h"
+#include "renderer/FarTerrain.h"
+#include "renderer/MeshArena.h"
 #include "renderer/RenderTest.h"
 #include "voxel/Chunk.h"
 #include "voxel/ChunkBounds.h"
 #include "voxel/ChunkMesh.h"
 #include "voxel/ChunkMesher.h"
+#include "voxel/ChunkPools.h"
 #include "voxel/ChunkRegistry.h"
 #include "voxel/ChunkStreaming.h"
 #include "voxel/BlockEdit.h"
+#include "voxel/BlockRegistry.h"
 #include "voxel/Raycast.h"
 #include "voxel/WorldGen.h"
 #include "voxel/VoxelCoords.h"
@@ -82,186 +91,8 @@ constexpr int kInteractionWorkerThreads = 1;
 constexpr int kSoakTestFrames = 2000;
 constexpr int kSoakTestLongFrames = 10000;
 
-GLuint CreateTextureFromPixels(int width, int height, const std::vector<std::uint8_t>& pixels) {
-    if (width <= 0 || height <= 0 || pixels.empty()) {
-        return 0;
-    }
-
-    GLuint texture = 0;
-    glad_glGenTextures(1, &texture);
-    glad_glBindTexture(GL_TEXTURE_2D, texture);
-    glad_glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
-    glad_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glad_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glad_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glad_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    return texture;
-}
-
-struct TexturePixels {
-    int width = 0;
-    int height = 0;
-    std::vector<std::uint8_t> pixels;
-    bool IsValid() const { return width > 0 && height > 0 && !pixels.empty(); }
-};
-
-std::vector<std::uint8_t> BuildProceduralDirtPixels(int width, int height) {
-    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u);
-    std::uint32_t state = 0x1234abcd;
-    auto nextRandom = [&state]() {
-        state = state * 1664525u + 1013904223u;
-        return state;
-    };
-
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            const std::uint32_t noiseSeed =
-                nextRandom() + static_cast<std::uint32_t>(x * 374761393u) + static_cast<std::uint32_t>(y * 668265263u);
-            const int noise = static_cast<int>((noiseSeed >> 24) & 0xFF) % 37 - 18;
-            int r = 110 + noise + static_cast<int>((noiseSeed >> 16) & 0xF) - 7;
-            int g = 80 + noise;
-            int b = 50 + noise + static_cast<int>((noiseSeed >> 12) & 0x7) - 3;
-            if (((noiseSeed >> 8) & 0xFF) < 15) {
-                r += 20;
-                g += 20;
-                b += 20;
-            }
-            r = std::clamp(r, 0, 255);
-            g = std::clamp(g, 0, 255);
-            b = std::clamp(b, 0, 255);
-
-            const std::size_t index = (static_cast<std::size_t>(y) * static_cast<std::size_t>(width) +
-                                       static_cast<std::size_t>(x)) *
-                                      4u;
-            pixels[index + 0] = static_cast<std::uint8_t>(r);
-            pixels[index + 1] = static_cast<std::uint8_t>(g);
-            pixels[index + 2] = static_cast<std::uint8_t>(b);
-            pixels[index + 3] = 255;
-        }
-    }
-    return pixels;
-}
-
-std::vector<std::uint8_t> BuildProceduralStonePixels(int width, int height) {
-    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u);
-    std::uint32_t state = 0x7f4a7c15u;
-    auto nextRandom = [&state]() {
-        state = state * 1103515245u + 12345u;
-        return state;
-    };
-
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            const std::uint32_t noiseSeed =
-                nextRandom() + static_cast<std::uint32_t>(x * 2654435761u) + static_cast<std::uint32_t>(y * 1013904223u);
-            const int noise = static_cast<int>((noiseSeed >> 24) & 0xFF) % 25 - 12;
-            int shade = 130 + noise;
-            shade = std::clamp(shade, 80, 200);
-            const std::size_t index = (static_cast<std::size_t>(y) * static_cast<std::size_t>(width) +
-                                       static_cast<std::size_t>(x)) *
-                                      4u;
-            pixels[index + 0] = static_cast<std::uint8_t>(shade);
-            pixels[index + 1] = static_cast<std::uint8_t>(shade);
-            pixels[index + 2] = static_cast<std::uint8_t>(shade);
-            pixels[index + 3] = 255;
-        }
-    }
-    return pixels;
-}
-
-GLuint CreateProceduralDirtTexture(int width, int height) {
-    auto pixels = BuildProceduralDirtPixels(width, height);
-    return CreateTextureFromPixels(width, height, pixels);
-}
-
-TexturePixels LoadTexturePixels(const std::string& path) {
-    TexturePixels result;
-    int channels = 0;
-    stbi_uc* data = stbi_load(path.c_str(), &result.width, &result.height, &channels, 4);
-    if (!data) {
-        return result;
-    }
-    result.pixels.assign(data, data + (result.width * result.height * 4));
-    stbi_image_free(data);
-    return result;
-}
-
-GLuint LoadTexture2D(const std::string& path) {
-    int width = 0;
-    int height = 0;
-    int channels = 0;
-    stbi_uc* data = stbi_load(path.c_str(), &width, &height, &channels, 4);
-    if (!data) {
-        return 0;
-    }
-
-    std::vector<std::uint8_t> pixels(data, data + (width * height * 4));
-    stbi_image_free(data);
-    return CreateTextureFromPixels(width, height, pixels);
-}
-
-GLuint CreateBlockAtlasTexture() {
-    constexpr int kFallbackSize = 32;
-    TexturePixels dirt = LoadTexturePixels("textures/dirt.png");
-    if (!dirt.IsValid()) {
-        dirt.width = kFallbackSize;
-        dirt.height = kFallbackSize;
-        dirt.pixels = BuildProceduralDirtPixels(kFallbackSize, kFallbackSize);
-        std::cout << "[Texture] Using procedurally generated dirt texture.\n";
-    }
-
-    TexturePixels stone = LoadTexturePixels("textures/stone.png");
-    if (!stone.IsValid()) {
-        stone.width = kFallbackSize;
-        stone.height = kFallbackSize;
-        stone.pixels = BuildProceduralStonePixels(kFallbackSize, kFallbackSize);
-        std::cout << "[Texture] Using procedurally generated stone texture.\n";
-    }
-
-    if (dirt.width != stone.width || dirt.height != stone.height) {
-        std::cout << "[Texture] Mismatched block texture sizes, falling back to procedural 32x32 atlas.\n";
-        dirt.width = kFallbackSize;
-        dirt.height = kFallbackSize;
-        dirt.pixels = BuildProceduralDirtPixels(kFallbackSize, kFallbackSize);
-        stone.width = kFallbackSize;
-        stone.height = kFallbackSize;
-        stone.pixels = BuildProceduralStonePixels(kFallbackSize, kFallbackSize);
-    }
-
-    const int atlasWidth = dirt.width * 2;
-    const int atlasHeight = dirt.height;
-    std::vector<std::uint8_t> atlas(static_cast<std::size_t>(atlasWidth) * atlasHeight * 4u);
-
-    auto blit = [&](const TexturePixels& src, int dstX) {
-        for (int y = 0; y < src.height; ++y) {
-            for (int x = 0; x < src.width; ++x) {
-                const std::size_t srcIndex =
-                    (static_cast<std::size_t>(y) * src.width + static_cast<std::size_t>(x)) * 4u;
-                const std::size_t dstIndex =
-                    (static_cast<std::size_t>(y) * atlasWidth + static_cast<std::size_t>(x + dstX)) * 4u;
-                atlas[dstIndex + 0] = src.pixels[srcIndex + 0];
-                atlas[dstIndex + 1] = src.pixels[srcIndex + 1];
-                atlas[dstIndex + 2] = src.pixels[srcIndex + 2];
-                atlas[dstIndex + 3] = src.pixels[srcIndex + 3];
-            }
-        }
-    };
-
-    blit(dirt, 0);
-    blit(stone, dirt.width);
-    return CreateTextureFromPixels(atlasWidth, atlasHeight, atlas);
-}
-
 const char* BlockLabel(voxel::BlockId id) {
-    switch (id) {
-    case voxel::kBlockStone:
-        return "Stone";
-    case voxel::kBlockDirt:
-        return "Dirt";
-    case voxel::kBlockAir:
-    default:
-        return "Air";
-    }
+    return voxel::BlockRegistry::Default().Get(id).name.c_str();
 }
 constexpr int kSoakSaveInterval = 200;
 constexpr int kSoakSaveIntervalLong = 500;
@@ -273,12 +104,13 @@ constexpr int kSoakLoadRadius = 6;
 constexpr int kSoakWorkerThreads = 1;
 constexpr int kSoakSyncMaxIterations = 200;
 const glm::vec3 kInteractionMoveDir(-2.0f, 0.0f, -2.0f);
-const glm::vec3 kPlayerSpawn = []() {
-    const int surfaceHeight = voxel::GetSurfaceHeight(0, 0);
+const glm::vec3 kEyeOffset(0.0f, 1.6f, 0.0f);
+
+glm::vec3 SpawnPosition(const voxel::WorldGenerator& generator) {
+    const int surfaceHeight = generator.SurfaceHeight(0, 0);
     const int spawnY = std::clamp(surfaceHeight + 2, voxel::kWorldMinY + 2, voxel::kWorldMaxY - 2);
     return glm::vec3(0.0f, static_cast<float>(spawnY), 0.0f);
-}();
-const glm::vec3 kEyeOffset(0.0f, 1.6f, 0.0f);
+}
 
 void glfwErrorCallback(int error, const char* description) {
     std::cerr << "[GLFW] Error " << error << ": " << description << '\n';
@@ -335,8 +167,8 @@ void EnsureChunkReady(voxel::ChunkRegistry& registry, const voxel::ChunkCoord& c
     auto entry = registry.GetOrCreateEntry(coord);
     std::unique_lock<std::shared_mutex> lock(entry->dataMutex);
     if (!entry->chunk) {
-        entry->chunk = std::make_unique<voxel::Chunk>();
-        voxel::ChunkRegistry::GenerateChunkData(coord, *entry->chunk);
+        entry->chunk = registry.Pools().chunks.Acquire();
+        registry.GenerateChunkData(coord, *entry->chunk);
     }
     entry->generationState.store(voxel::GenerationState::Ready, std::memory_order_release);
     entry->dirty.store(false, std::memory_order_release);
@@ -477,6 +309,21 @@ struct SoakTestState {
     std::filesystem::path storageRoot;
 };
 
+// Writes the trace buffers on every exit path once --trace is given.
+struct TraceDumpOnExit {
+    std::string path;
+
+    ~TraceDumpOnExit() {
+        if (path.empty()) {
+            return;
+        }
+        std::string error;
+        if (!core::Tracer::Global().WriteChromeJsonFile(path, error)) {
+            std::cerr << "[Trace] " << error << '\n';
+        }
+    }
+};
+
 #if defined(__linux__)
 void CrashHandler(int signal) {
     void* frames[64];
@@ -510,6 +357,8 @@ int main(int argc, char** argv) {
         std::cout << core::Usage(argv[0]);
         return EXIT_SUCCESS;
     }
+    core::Tracer::Global().SetThreadName("Main");
+    const TraceDumpOnExit traceDump{options.tracePath};
 
     const bool smokeTest = options.smokeTest;
     const bool interactionTest = options.interactionTest;
@@ -540,7 +389,35 @@ int main(int argc, char** argv) {
         }
         return EXIT_SUCCESS;
     }
+    if (options.queueBench) {
+        core::QueueBenchResult result = core::RunQueueBench();
+        if (!result.ok) {
+            std::cerr << "[QueueBench] Failed: " << result.message << '\n';
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+    if (options.heightBench) {
+        core::HeightBenchResult result = core::RunHeightBench();
+        if (!result.ok) {
+            std::cerr << "[HeightBench] Failed: " << result.message << '\n';
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+    if (options.contentionBench) {
+        core::ContentionBenchResult result = core::RunContentionBench();
+        if (!result.ok) {
+            std::cerr << "[ContentionBench] Failed: " << result.message << '\n';
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
     const bool allowInput = !(smokeTest || interactionTest || runSoakTest);
+    voxel::WorldGenConfig worldGenConfig;
+    if (runSoakTest) {
+        worldGenConfig.seed = options.soakTestSeed;
+    }
 #ifndef NDEBUG
     const bool enableGlDebug = !options.noGlDebug;
 #endif
@@ -629,7 +506,6 @@ int main(int argc, char** argv) {
     glFrontFace(GL_CCW);
 
     app::SetMouseCapture(window, allowInput || interactionTest || runSoakTest);
-    app::gCamera.setPosition(kPlayerSpawn + kEyeOffset);
     if (interactionTest || runSoakTest) {
         app::gCamera.setMouseSensitivity(1.0f);
         if (interactionTest) {
@@ -691,9 +567,9 @@ int main(int argc, char** argv) {
             return EXIT_FAILURE;
         }
 
-        blockTexture = CreateBlockAtlasTexture();
+        blockTexture = renderer::CreateBlockTextureArray(voxel::BlockRegistry::Default());
         if (blockTexture == 0) {
-            std::cerr << "[Texture] Failed to create block atlas texture.\n";
+            std::cerr << "[Texture] Failed to create block texture array.\n";
             glfwDestroyWindow(window);
             glfwTerminate();
             return EXIT_FAILURE;
@@ -702,14 +578,18 @@ int main(int argc, char** argv) {
         DebugDraw debugDraw;
         DebugDraw crosshairDraw;
 
-        voxel::ChunkRegistry chunkRegistry;
-        voxel::ChunkMesher mesher;
+        // Declared before the registry so chunk meshes release their ranges before it is destroyed.
+        renderer::MeshArena meshArena;
         std::filesystem::path storageRoot = persistence::ChunkStorage::DefaultSavePath();
         if (runSoakTest) {
             storageRoot = soakState.storageRoot;
         }
         persistence::ChunkStorage chunkStorage(storageRoot);
+        voxel::ChunkRegistry chunkRegistry(chunkStorage.ResolveWorldGen(worldGenConfig));
+        voxel::ChunkMesher mesher;
         chunkRegistry.SetStorage(&chunkStorage);
+        const glm::vec3 playerSpawn = SpawnPosition(chunkRegistry.Generator());
+        app::gCamera.setPosition(playerSpawn + kEyeOffset);
 
         voxel::ChunkStreamingConfig streamingConfig;
         streamingConfig.renderRadius = runSoakTest ? kSoakRenderRadius
@@ -719,12 +599,17 @@ int main(int argc, char** argv) {
         streamingConfig.maxChunkCreatesPerFrame = 3;
         streamingConfig.maxChunkMeshesPerFrame = 2;
         streamingConfig.maxGpuUploadsPerFrame = 3;
+        // Test runs compare frame-indexed results, so they keep the fixed count limits (no byte or time
+        // budget on uploads) and a player-centred region.
+        streamingConfig.budget.adaptive = !smokeTest && !interactionTest && !runSoakTest;
+        streamingConfig.prefetch.enabled = streamingConfig.budget.adaptive;
         streamingConfig.workerThreads = runSoakTest
             ? kSoakWorkerThreads
             : (interactionTest ? kInteractionWorkerThreads : (smokeTest ? 0 : 2));
 
         voxel::ChunkStreaming streaming(streamingConfig);
         streaming.SetStorage(&chunkStorage);
+        streaming.SetMeshStore(&meshArena);
         core::Profiler profiler;
         core::WorkerPool workerPool;
         if (streamingConfig.workerThreads > 0) {
@@ -741,6 +626,7 @@ int main(int argc, char** argv) {
             soakState.workerThreads = static_cast<int>(workerPool.ThreadCount());
         }
         streaming.SetProfiler(&profiler);
+        renderer::FarTerrain farTerrain(chunkRegistry.Generator(), meshArena);
 
         auto lastTime = std::chrono::steady_clock::now();
         const auto smokeStartTime = lastTime;
@@ -759,8 +645,15 @@ int main(int argc, char** argv) {
         bool statsPrintTogglePressed = false;
         bool frustumTogglePressed = false;
         bool distanceTogglePressed = false;
+        bool occlusionTogglePressed = false;
+        bool farTerrainTogglePressed = false;
+        bool traceDumpPressed = false;
         bool frustumCullingEnabled = true;
         bool distanceCullingEnabled = true;
+        bool occlusionCullingEnabled = true;
+        bool farTerrainEnabled = true;
+        renderer::ChunkCuller chunkCuller;
+        std::vector<std::uint32_t> visibleChunks;
         bool statsTitleEnabled = true;
         bool statsPrintEnabled = false;
         auto lastStatsPrint = lastTime - std::chrono::seconds(5);
@@ -768,6 +661,8 @@ int main(int argc, char** argv) {
         std::size_t lastDrawnChunks = 0;
         std::size_t lastFrustumCulled = 0;
         std::size_t lastDistanceCulled = 0;
+        std::size_t lastOcclusionCulled = 0;
+        renderer::ChunkCullResult lastCull;
         std::size_t lastDrawCalls = 0;
         std::size_t lastGpuReadyChunks = 0;
         std::size_t lastGeneratedChunks = 0;
@@ -796,7 +691,7 @@ int main(int argc, char** argv) {
         std::size_t soakEditIndex = 0;
         int soakFrameIndex = 0;
         auto lastClampLogTime = lastTime - std::chrono::seconds(1);
-        game::Player player(kPlayerSpawn);
+        game::Player player(playerSpawn);
         glm::mat4 projection(1.0f);
         glm::mat4 view(1.0f);
         Frustum frustum = Frustum::FromMatrix(glm::mat4(1.0f));
@@ -856,6 +751,7 @@ int main(int argc, char** argv) {
 
     while (!glfwWindowShouldClose(window)) {
         core::ScopedTimer frameTimer(&profiler, core::Metric::Frame);
+        meshArena.BeginFrame();
         auto now = std::chrono::steady_clock::now();
         float deltaTime = kSmokeDeltaTime;
         if (interactionTest) {
@@ -994,6 +890,39 @@ int main(int argc, char** argv) {
                     distanceTogglePressed = false;
                 }
 
+                int occlusionToggleState = glfwGetKey(window, GLFW_KEY_F7);
+                if (occlusionToggleState == GLFW_PRESS && !occlusionTogglePressed) {
+                    occlusionTogglePressed = true;
+                    occlusionCullingEnabled = !occlusionCullingEnabled;
+                    std::cout << "[Culling] Occlusion culling " << (occlusionCullingEnabled ? "enabled" : "disabled")
+                              << ".\n";
+                } else if (occlusionToggleState == GLFW_RELEASE) {
+                    occlusionTogglePressed = false;
+                }
+
+                int farTerrainToggleState = glfwGetKey(window, GLFW_KEY_F8);
+                if (farTerrainToggleState == GLFW_PRESS && !farTerrainTogglePressed) {
+                    farTerrainTogglePressed = true;
+                    farTerrainEnabled = !farTerrainEnabled;
+                    if (!farTerrainEnabled) {
+                        farTerrain.Clear();
+                    }
+                    std::cout << "[Far] Far terrain " << (farTerrainEnabled ? "enabled" : "disabled") << ".\n";
+                } else if (farTerrainToggleState == GLFW_RELEASE) {
+                    farTerrainTogglePressed = false;
+                }
+
+                int traceDumpState = glfwGetKey(window, GLFW_KEY_F9);
+                if (traceDumpState == GLFW_PRESS && !traceDumpPressed) {
+                    traceDumpPressed = true;
+                    std::string traceError;
+                    if (!core::Tracer::Global().WriteChromeJsonFile(core::NextTraceDumpPath(), traceError)) {
+                        std::cerr << "[Trace] " << traceError << '\n';
+                    }
+                } else if (traceDumpState == GLFW_RELEASE) {
+                    traceDumpPressed = false;
+                }
+
                 if (app::gMouseCaptured) {
                     float yawRadians = glm::radians(app::gCamera.getYaw());
                     glm::vec3 forward(std::cos(yawRadians), 0.0f, std::sin(yawRadians));
@@ -1031,7 +960,7 @@ int main(int argc, char** argv) {
                 int resetState = glfwGetKey(window, GLFW_KEY_R);
                 if (resetState == GLFW_PRESS && !resetPressed) {
                     resetPressed = true;
-                    player.SetPosition(kPlayerSpawn);
+                    player.SetPosition(playerSpawn);
                     player.ResetVelocity();
                     std::cout << "[Debug] Player reset to spawn.\n";
                 } else if (resetState == GLFW_RELEASE) {
@@ -1117,7 +1046,8 @@ int main(int argc, char** argv) {
                 }
             }
 
-            projection = glm::perspective(glm::radians(kFov), aspect, 0.1f, 500.0f);
+            const float farPlane = farTerrainEnabled ? std::max(500.0f, farTerrain.ViewDistance()) : 500.0f;
+            projection = glm::perspective(glm::radians(kFov), aspect, 0.1f, farPlane);
             view = app::gCamera.getViewMatrix();
             frustum = Frustum::FromMatrix(projection * view);
             lightDir = glm::normalize(glm::vec3(-0.4f, -1.0f, -0.3f));
@@ -1175,7 +1105,7 @@ int main(int argc, char** argv) {
             shader.setVec3("uLightDir", lightDir);
             shader.setInt("uTexture", 0);
             glad_glActiveTexture(GL_TEXTURE0);
-            glad_glBindTexture(GL_TEXTURE_2D, blockTexture);
+            glad_glBindTexture(GL_TEXTURE_2D_ARRAY, blockTexture);
 
             playerPosition = player.Position();
             voxel::WorldBlockCoord playerBlock{
@@ -1183,6 +1113,8 @@ int main(int argc, char** argv) {
                 static_cast<int>(std::floor(playerPosition.y)),
                 static_cast<int>(std::floor(playerPosition.z))};
             playerChunk = voxel::WorldToChunkCoord(playerBlock, voxel::kChunkSize);
+            streaming.SetWorkerIdleRatio(workerPool.SampleIdleRatio());
+            streaming.SetMotion(voxel::StreamingMotion{player.Velocity(), app::gCamera.getFront()});
             streaming.Tick(playerChunk, chunkRegistry, mesher);
             workerPool.NotifyWork();
 
@@ -1201,7 +1133,8 @@ int main(int argc, char** argv) {
                     auto ensureEntry = chunkRegistry.GetOrCreateEntry(targetChunk);
                     std::unique_lock<std::shared_mutex> lock(ensureEntry->dataMutex);
                     if (!ensureEntry->chunk) {
-                        ensureEntry->chunk = std::make_unique<voxel::Chunk>();
+                        ensureEntry->chunk = chunkRegistry.Pools().chunks.Acquire();
+                        ensureEntry->chunk->Fill(voxel::kBlockAir);
                     }
                     ensureEntry->generationState.store(voxel::GenerationState::Ready, std::memory_order_release);
                     ensureEntry->dirty.store(false, std::memory_order_release);
@@ -1431,10 +1364,12 @@ int main(int argc, char** argv) {
 
         if (interactionTest && interactionState.failed) {
             interactionState.frames = interactionFrameIndex + 1;
+            streaming.TakeCensus(chunkRegistry);
             interactionState.stats = streaming.Stats();
         }
         if (runSoakTest && soakState.failed) {
             soakState.frames = soakFrameIndex + 1;
+            streaming.TakeCensus(chunkRegistry);
             soakState.stats = streaming.Stats();
         }
         if ((smokeTest && smokeFailed) || (interactionTest && interactionState.failed) ||
@@ -1444,38 +1379,45 @@ int main(int argc, char** argv) {
 
         std::size_t distanceCulled = 0;
         std::size_t frustumCulled = 0;
+        std::size_t occlusionCulled = 0;
         std::size_t drawn = 0;
+        std::size_t drawCalls = 0;
 
         {
             core::ScopedTimer renderTimer(&profiler, core::Metric::Render);
             const int renderRadiusChunks = streaming.RenderRadius();
 
-            chunkRegistry.ForEachEntry([&](const voxel::ChunkCoord& coord,
-                                           const std::shared_ptr<voxel::ChunkEntry>& entry) {
-                if (entry->gpuState.load(std::memory_order_acquire) != voxel::GpuState::Uploaded) {
-                    return;
-                }
-
-                if (distanceCullingEnabled) {
-                    const int dx = std::abs(coord.x - playerChunk.x);
-                    const int dz = std::abs(coord.z - playerChunk.z);
-                    if (std::max(dx, dz) > renderRadiusChunks) {
-                        ++distanceCulled;
-                        return;
-                    }
-                }
-
-                if (frustumCullingEnabled) {
-                    const voxel::ChunkBounds bounds = voxel::GetChunkBounds(coord);
-                    if (!frustum.IntersectsAabb(bounds.min, bounds.max)) {
-                        ++frustumCulled;
-                        return;
-                    }
-                }
-
-                entry->mesh.Draw();
+            const glm::vec3 eye = app::gCamera.getPosition();
+            const std::vector<renderer::RenderChunk>& renderChunks = streaming.RenderList().Chunks();
+
+            renderer::ChunkCullOptions cullOptions;
+            cullOptions.distance = distanceCullingEnabled;
+            cullOptions.frustum = frustumCullingEnabled;
+            cullOptions.occlusion = occlusionCullingEnabled;
+            cullOptions.renderRadius = renderRadiusChunks;
+            cullOptions.verticalRadius = streaming.Config().verticalRadius + 1;
+            cullOptions.playerChunk = playerChunk;
+            cullOptions.eye = eye;
+            const renderer::ChunkCullResult cull =
+                chunkCuller.Cull(streaming.RenderList(), frustum, cullOptions, visibleChunks);
+            lastCull = cull;
+            distanceCulled = cull.distanceCulled;
+            frustumCulled = cull.frustumCulled;
+            occlusionCulled = cull.occlusionCulled;
+
+            meshArena.BeginBatch();
+            for (std::uint32_t index : visibleChunks) {
+                const renderer::RenderChunk& chunk = renderChunks[index];
+                chunk.entry->mesh.QueueDraw(voxel::FacingDirectionMask(voxel::GetChunkBounds(chunk.coord), eye));
                 ++drawn;
-            });
+            }
+            if (farTerrainEnabled) {
+                // The hole follows whatever the chunk pass can draw, so the two never overlap.
+                farTerrain.Update(playerChunk,
+                                  distanceCullingEnabled ? renderRadiusChunks : streaming.Config().loadRadius);
+                farTerrain.QueueVisible(frustum);
+            }
+            drawCalls = meshArena.SubmitBatch();
 
             if (debugDraw.HasGeometry()) {
                 debugShader.use();
@@ -1511,9 +1453,11 @@ int main(int argc, char** argv) {
         lastDrawnChunks = drawn;
         lastFrustumCulled = frustumCulled;
         lastDistanceCulled = distanceCulled;
-        lastDrawCalls = drawn;
+        lastOcclusionCulled = occlusionCulled;
+        lastDrawCalls = drawCalls;
         lastWorkerThreads = streamStats.workerThreads;
 
+        meshArena.EndFrame();
         glfwSwapBuffers(window);
         glfwPollEvents();
 
@@ -1538,8 +1482,12 @@ int main(int argc, char** argv) {
         }
         if (interactionTest) {
             interactionState.frames = interactionFrameIndex + 1;
+            const bool lastFrame = interactionFrameIndex + 1 >= kInteractionTestFrames;
+            if (lastFrame) {
+                streaming.TakeCensus(chunkRegistry);
+            }
             interactionState.stats = streaming.Stats();
-            if (interactionFrameIndex + 1 >= kInteractionTestFrames) {
+            if (lastFrame) {
                 std::cout << "[InteractionTest] Completed " << interactionState.frames << " frames.\n";
                 break;
             }
@@ -1547,8 +1495,12 @@ int main(int argc, char** argv) {
         }
         if (runSoakTest) {
             soakState.frames = soakFrameIndex + 1;
+            const bool lastFrame = soakFrameIndex + 1 >= soakConfig.frames;
+            if (lastFrame) {
+                streaming.TakeCensus(chunkRegistry);
+            }
             soakState.stats = streaming.Stats();
-            if (soakFrameIndex + 1 >= soakConfig.frames) {
+            if (lastFrame) {
                 std::cout << "[SoakTest] Completed " << soakState.frames << " frames.\n";
                 break;
             }
@@ -1577,8 +1529,10 @@ int main(int argc, char** argv) {
             }
 
             if (statsTitleEnabled) {
-                title << " | frame " << ms(core::Metric::Frame)
-                      << "ms | upd " << ms(core::Metric::Update)
+                const core::LatencyPercentiles& frameLatency = snapshot.latency[metricIndex(core::Metric::Frame)];
+                title << " | frame " << ms(core::Metric::Frame) << "ms (p99 " << frameLatency.p99Ms << " max "
+                      << frameLatency.maxMs << ")"
+                      << " | upd " << ms(core::Metric::Update)
                       << "ms | up " << ms(core::Metric::Upload)
                       << "ms | rnd " << ms(core::Metric::Render) << "ms";
 
@@ -1592,7 +1546,8 @@ int main(int argc, char** argv) {
                       << " | Loaded: " << lastLoadedChunks
                       << " | GPU: " << lastGpuReadyChunks
                       << " | Q: " << lastCreateQueue << "/" << lastMeshQueue << "/" << lastUploadQueue
-                      << " | Drawn: " << lastDrawnChunks;
+                      << " | Drawn: " << lastDrawnChunks
+                      << " | Draws: " << lastDrawCalls;
             }
 
             if (!statsTitleEnabled) {
@@ -1605,6 +1560,8 @@ int main(int argc, char** argv) {
             if (statsPrintEnabled) {
                 std::chrono::duration<double> printElapsed = now - lastStatsPrint;
                 if (printElapsed.count() >= 5.0) {
+                    const double memoryMiB =
+                        static_cast<double>(streaming.Stats().memory.totalBytes) / (1024.0 * 1024.0);
                     std::ostringstream perfLine;
                     perfLine << "[Perf] fps " << std::fixed << std::setprecision(1) << fps
                              << " frame " << ms(core::Metric::Frame) << "ms"
@@ -1617,8 +1574,22 @@ int main(int argc, char** argv) {
                              << "ms/job (" << snapshot.counts[metricIndex(core::Metric::Mesh)] << ")"
                              << " loaded " << lastLoadedChunks
                              << " gpu " << lastGpuReadyChunks
-                             << " q " << lastCreateQueue << "/" << lastMeshQueue << "/" << lastUploadQueue;
+                             << " q " << lastCreateQueue << "/" << lastMeshQueue << "/" << lastUploadQueue
+                             << " drawn " << lastDrawnChunks << " draws " << lastDrawCalls
+                             << " cull d/f/o " << lastDistanceCulled << "/" << lastFrustumCulled << "/"
+                             << lastOcclusionCulled
+                             << " mem " << std::setprecision(1) << memoryMiB << "MiB";
                     std::cout << perfLine.str() << '\n';
+                    std::cout << voxel::DescribePools(chunkRegistry.Pools()) << '\n';
+                    std::cout << renderer::DescribeArena(meshArena.Stats()) << '\n';
+                    std::cout << renderer::DescribeLodRings(lastCull) << '\n';
+                    std::cout << voxel::DescribeUploads(streaming.Stats()) << '\n';
+                    std::cout << voxel::DescribeBudgets(streaming.Stats()) << '\n';
+                    std::cout << voxel::DescribeCache(streaming.Stats()) << '\n';
+                    std::cout << voxel::DescribePipeline(streaming.Stats()) << '\n';
+                    std::cout << renderer::DescribeFarTerrain(farTerrain.Stats()) << '\n';
+                    std::cout << core::DescribeLatency(snapshot) << '\n';
+                    std::cout << core::DescribeMemory(streaming.Stats().memory) << '\n';
                     lastStatsPrint = now;
                 }
             }
@@ -1743,13 +1714,46 @@ int main(int argc, char** argv) {
                       << soakState.stats.meshedCpuReady << "|\n";
             std::cout << "| chunks_uploaded          | " << std::left << std::setw(valueWidth)
                       << soakState.stats.gpuReadyChunks << "|\n";
+            {
+                std::ostringstream memory;
+                memory << std::fixed << std::setprecision(1) << "now "
+                       << static_cast<double>(soakState.stats.memory.totalBytes) / (1024.0 * 1024.0) << " peak "
+                       << static_cast<double>(soakState.stats.memory.peakTotalBytes) / (1024.0 * 1024.0);
+                std::cout << "| memory_mib               | " << std::left << std::setw(valueWidth) << memory.str()
+                          << "|\n";
+            }
+            {
+                std::ostringstream cache;
+                cache << soakState.stats.cache.hits << '/' << soakState.stats.cache.hits + soakState.stats.cache.misses;
+                std::cout << "| cache_hits               | " << std::left << std::setw(valueWidth) << cache.str()
+                          << "|\n";
+            }
             std::cout << "| final_checksum_sha256    | " << std::left << std::setw(valueWidth)
                       << soakState.checksum << "|\n";
+
+            // Nothing drains the profiler during a soak run, so this covers every frame and job.
+            const core::ProfilerSnapshot latencySnapshot = profiler.CollectSnapshot();
+            const std::pair<core::Metric, const char*> latencyRows[] = {
+                {core::Metric::Frame, "| frame_ms                 | "},
+                {core::Metric::Update, "| update_ms                | "},
+                {core::Metric::Upload, "| upload_ms                | "},
+                {core::Metric::Render, "| render_ms                | "},
+                {core::Metric::Generate, "| generate_job_ms          | "},
+                {core::Metric::Mesh, "| mesh_job_ms              | "},
+            };
+            for (const auto& [metric, label] : latencyRows) {
+                const core::LatencyPercentiles& latency = latencySnapshot.latency[static_cast<std::size_t>(metric)];
+                std::ostringstream value;
+                value << std::fixed << std::setprecision(2) << "p50 " << latency.p50Ms << " p99 " << latency.p99Ms
+                      << " p999 " << latency.p999Ms << " max " << latency.maxMs;
+                std::cout << label << std::left << std::setw(valueWidth) << value.str() << "|\n";
+            }
             std::cout << "+--------------------------+------------------------------------------+\n";
         }
 
         workerPool.Stop();
         chunkRegistry.SaveAllDirty(chunkStorage);
+        streaming.ClearCache(chunkRegistry);
         chunkRegistry.DestroyAll();
     }
 
@@ -5,6 +5,15 @@
 
 #include <glm/gtc/matrix_access.hpp>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MINECLONE_FRUSTUM_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#define MINECLONE_FRUSTUM_AVX2 1
+#include <immintrin.h>
+#endif
+
 namespace {
 Plane MakePlane(const glm::vec4& coefficients) {
     Plane plane;
@@ -13,8 +22,42 @@ Plane MakePlane(const glm::vec4& coefficients) {
     plane.Normalize();
     return plane;
 }
+
+// Per plane, the positive-vertex selection only depends on the normal signs, so every box in a
+// batch reads the same min/max column for each axis.
+struct PlaneColumns {
+    const float* x;
+    const float* y;
+    const float* z;
+};
+
+PlaneColumns SelectColumns(const Plane& plane, const AabbList& boxes, std::size_t first) {
+    return PlaneColumns{
+        (plane.normal.x >= 0.0f ? boxes.maxX.data() : boxes.minX.data()) + first,
+        (plane.normal.y >= 0.0f ? boxes.maxY.data() : boxes.minY.data()) + first,
+        (plane.normal.z >= 0.0f ? boxes.maxZ.data() : boxes.minZ.data()) + first};
+}
 } // namespace
 
+void AabbList::Clear() {
+    minX.clear();
+    minY.clear();
+    minZ.clear();
+    maxX.clear();
+    maxY.clear();
+    maxZ.clear();
+}
+
+void AabbList::Push(const glm::vec3& min, const glm::vec3& max) {
+    assert(min.x <= max.x && min.y <= max.y && min.z <= max.z);
+    minX.push_back(min.x);
+    minY.push_back(min.y);
+    minZ.push_back(min.z);
+    maxX.push_back(max.x);
+    maxY.push_back(max.y);
+    maxZ.push_back(max.z);
+}
+
 Frustum Frustum::FromMatrix(const glm::mat4& viewProjection) {
     const glm::vec4 row0 = glm::row(viewProjection, 0);
     const glm::vec4 row1 = glm::row(viewProjection, 1);
@@ -58,3 +101,72 @@ bool Frustum::IntersectsAabb(const glm::vec3& min, const glm::vec3& max) const {
 
     return true;
 }
+
+void Frustum::IntersectsAabbs(const AabbList& boxes, std::size_t first, std::size_t count,
+                              std::uint8_t* out) const {
+    assert(first + count <= boxes.Size());
+
+    std::array<PlaneColumns, 6> columns{};
+    for (std::size_t p = 0; p < planes_.size(); ++p) {
+        columns[p] = SelectColumns(planes_[p], boxes, first);
+    }
+
+    // Same operation order as Plane::Distance: ((nx * x + ny * y) + nz * z) + d.
+    std::size_t i = 0;
+#if defined(MINECLONE_FRUSTUM_AVX2)
+    for (; i + 8 <= count; i += 8) {
+        __m256 outside = _mm256_setzero_ps();
+        for (std::size_t p = 0; p < planes_.size(); ++p) {
+            const Plane& plane = planes_[p];
+            const __m256 dx = _mm256_mul_ps(_mm256_set1_ps(plane.normal.x), _mm256_loadu_ps(columns[p].x + i));
+            const __m256 dy = _mm256_mul_ps(_mm256_set1_ps(plane.normal.y), _mm256_loadu_ps(columns[p].y + i));
+            const __m256 dz = _mm256_mul_ps(_mm256_set1_ps(plane.normal.z), _mm256_loadu_ps(columns[p].z + i));
+            const __m256 distance =
+                _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(dx, dy), dz), _mm256_set1_ps(plane.d));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_LT_OQ));
+        }
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(outside));
+        for (std::size_t lane = 0; lane < 8; ++lane) {
+            out[i + lane] = ((mask >> lane) & 1u) ? 0 : 1;
+        }
+    }
+#endif
+#if defined(MINECLONE_FRUSTUM_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        __m128 outside = _mm_setzero_ps();
+        for (std::size_t p = 0; p < planes_.size(); ++p) {
+            const Plane& plane = planes_[p];
+            const __m128 dx = _mm_mul_ps(_mm_set1_ps(plane.normal.x), _mm_loadu_ps(columns[p].x + i));
+            const __m128 dy = _mm_mul_ps(_mm_set1_ps(plane.normal.y), _mm_loadu_ps(columns[p].y + i));
+            const __m128 dz = _mm_mul_ps(_mm_set1_ps(plane.normal.z), _mm_loadu_ps(columns[p].z + i));
+            const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(dx, dy), dz), _mm_set1_ps(plane.d));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, _mm_setzero_ps()));
+        }
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_ps(outside));
+        for (std::size_t lane = 0; lane < 4; ++lane) {
+            out[i + lane] = ((mask >> lane) & 1u) ? 0 : 1;
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        std::uint8_t inside = 1;
+        for (std::size_t p = 0; p < planes_.size(); ++p) {
+            const glm::vec3 positive{columns[p].x[i], columns[p].y[i], columns[p].z[i]};
+            if (planes_[p].Distance(positive) < 0.0f) {
+                inside = 0;
+                break;
+            }
+        }
+        out[i] = inside;
+    }
+}
+
+const char* FrustumBatchBackend() {
+#if defined(MINECLONE_FRUSTUM_AVX2)
+    return "avx2";
+#elif defined(MINECLONE_FRUSTUM_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
@@ -2,11 +2,24 @@
 #define MINECLONE_MATH_FRUSTUM_H
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 #include <glm/glm.hpp>
 
 #include "math/Plane.h"
 
+// Structure-of-arrays box list for the batched frustum test.
+struct AabbList {
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+
+    void Clear();
+    void Push(const glm::vec3& min, const glm::vec3& max);
+    std::size_t Size() const { return minX.size(); }
+};
+
 class Frustum {
 public:
     enum PlaneIndex {
@@ -22,8 +35,16 @@ public:
 
     bool IntersectsAabb(const glm::vec3& min, const glm::vec3& max) const;
 
+    // Tests boxes [first, first + count) and writes 1 (intersects) or 0 per box to out.
+    // Runs 8 (AVX2) or 4 (SSE2) boxes per step and matches IntersectsAabb bit for bit.
+    void IntersectsAabbs(const AabbList& boxes, std::size_t first, std::size_t count, std::uint8_t* out) const;
+
+    const std::array<Plane, 6>& Planes() const { return planes_; }
+
 private:
     std::array<Plane, 6> planes_{};
 };
 
+const char* FrustumBatchBackend();
+
 #endif
@@ -20,4 +20,16 @@ constexpr std::array<char, 8> kChunkMagic = {'M', 'C', 'L', 'C', 'H', 'N', 'K',
 constexpr std::uint32_t kChunkVersion = 1;
 constexpr std::size_t kChunkHeaderSize = 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4;
 
+// world.meta: which terrain generator a save was written with.
+struct WorldFileHeader {
+    std::array<char, 8> magic{};
+    std::uint32_t version = 0;
+    std::uint32_t generatorVersion = 0;
+    std::uint32_t seed = 0;
+};
+
+constexpr std::array<char, 8> kWorldMagic = {'M', 'C', 'L', 'W', 'R', 'L', 'D', '\0'};
+constexpr std::uint32_t kWorldVersion = 1;
+constexpr std::size_t kWorldFileSize = 8 + 4 + 4 + 4;
+
 } // namespace persistence
@@ -30,9 +30,8 @@ bool ReadExact(std::istream& in, void* data, std::size_t size) {
 
 } // namespace
 
-ChunkStorage::ChunkStorage(std::filesystem::path root) : root_(std::move(root)) {
-    EnsureRoot();
-}
+// The folder is created by the first save, so runs that never save leave nothing behind.
+ChunkStorage::ChunkStorage(std::filesystem::path root) : root_(std::move(root)) {}
 
 std::filesystem::path ChunkStorage::DefaultSavePath() {
     return std::filesystem::path("saves") / "world_0";
@@ -61,6 +60,98 @@ std::filesystem::path ChunkStorage::ChunkPath(const voxel::ChunkCoord& coord) co
     return root_ / name.str();
 }
 
+std::filesystem::path ChunkStorage::WorldPath() const {
+    return root_ / "world.meta";
+}
+
+bool ChunkStorage::HasChunkFiles() const {
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(root_, error)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".bin") {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::optional<voxel::WorldGenConfig> ChunkStorage::LoadWorldGen() const {
+    const std::filesystem::path path = WorldPath();
+    std::error_code error;
+    if (!std::filesystem::exists(path, error)) {
+        return std::nullopt;
+    }
+    const std::uintmax_t fileSize = std::filesystem::file_size(path, error);
+    if (error || fileSize != kWorldFileSize) {
+        std::cout << "[Storage] Reject world file " << path.string() << ": file size mismatch.\n";
+        return std::nullopt;
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    WorldFileHeader header;
+    if (!in || !ReadExact(in, header.magic.data(), header.magic.size()) ||
+        !ReadExact(in, &header.version, sizeof(header.version)) ||
+        !ReadExact(in, &header.generatorVersion, sizeof(header.generatorVersion)) ||
+        !ReadExact(in, &header.seed, sizeof(header.seed))) {
+        std::cout << "[Storage] Reject world file " << path.string() << ": header truncated.\n";
+        return std::nullopt;
+    }
+    if (header.magic != kWorldMagic || header.version != kWorldVersion) {
+        std::cout << "[Storage] Reject world file " << path.string() << ": bad magic or version.\n";
+        return std::nullopt;
+    }
+    if (header.generatorVersion > voxel::kWorldGenVersion) {
+        std::cout << "[Storage] World file " << path.string() << " uses unknown generator "
+                  << header.generatorVersion << "; using " << voxel::kWorldGenVersion << ".\n";
+    }
+    return voxel::WorldGenConfigForVersion(header.generatorVersion, header.seed);
+}
+
+bool ChunkStorage::SaveWorldGen(const voxel::WorldGenConfig& config) {
+    if (!EnsureRoot()) {
+        return false;
+    }
+
+    WorldFileHeader header;
+    header.magic = kWorldMagic;
+    header.version = kWorldVersion;
+    header.generatorVersion = config.version;
+    header.seed = config.seed;
+
+    const std::filesystem::path path = WorldPath();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out || !WriteExact(out, header.magic.data(), header.magic.size()) ||
+        !WriteExact(out, &header.version, sizeof(header.version)) ||
+        !WriteExact(out, &header.generatorVersion, sizeof(header.generatorVersion)) ||
+        !WriteExact(out, &header.seed, sizeof(header.seed))) {
+        std::cout << "[Storage] Failed to write world file " << path.string() << ".\n";
+        return false;
+    }
+    return true;
+}
+
+voxel::WorldGenConfig ChunkStorage::ResolveWorldGen(const voxel::WorldGenConfig& freshWorld) {
+    pendingWorldGen_.reset();
+    if (std::optional<voxel::WorldGenConfig> stored = LoadWorldGen()) {
+        return *stored;
+    }
+    std::error_code error;
+    if (std::filesystem::exists(WorldPath(), error)) {
+        // Never guess legacy (or overwrite) over a world.meta we could not read; it may be a newer world.
+        std::cout << "[Storage] WARNING: keeping unreadable " << WorldPath().string() << "; generating with "
+                  << "generator " << freshWorld.version << " seed " << freshWorld.seed
+                  << ". Terrain may not match saved chunks.\n";
+        return freshWorld;
+    }
+    // Saves predating world.meta were all written by the legacy generator with the default seed.
+    const bool legacy = HasChunkFiles();
+    voxel::WorldGenConfig config =
+        legacy ? voxel::WorldGenConfigForVersion(voxel::kWorldGenLegacy, voxel::kDefaultWorldSeed) : freshWorld;
+    pendingWorldGen_ = config;
+    std::cout << "[Storage] World generator " << config.version << " seed " << config.seed
+              << (legacy ? " (existing save without world.meta).\n" : ".\n");
+    return config;
+}
+
 bool ChunkStorage::LoadChunk(const voxel::ChunkCoord& coord, voxel::Chunk& chunk) {
     const std::filesystem::path path = ChunkPath(coord);
     std::error_code error;
@@ -140,8 +231,10 @@ bool ChunkStorage::LoadChunk(const voxel::ChunkCoord& coord, voxel::Chunk& chunk
         return false;
     }
 
-    std::cout << "[Storage] Loaded chunk " << CoordToString(coord)
-              << " (" << header.payloadBytes << " bytes).\n";
+    if (logSuccess_) {
+        std::cout << "[Storage] Loaded chunk " << CoordToString(coord) << " (" << header.payloadBytes
+                  << " bytes).\n";
+    }
     return true;
 }
 
@@ -150,6 +243,14 @@ bool ChunkStorage::SaveChunk(const voxel::ChunkCoord& coord, const voxel::Chunk&
         return false;
     }
 
+    // world.meta goes down before the first chunk file, so a save never holds chunks without it.
+    if (pendingWorldGen_) {
+        if (!SaveWorldGen(*pendingWorldGen_)) {
+            return false;
+        }
+        pendingWorldGen_.reset();
+    }
+
     const std::filesystem::path path = ChunkPath(coord);
     const std::filesystem::path tempPath = path.string() + ".tmp";
     const std::uint32_t payloadBytes = static_cast<std::uint32_t>(voxel::kChunkVolume * sizeof(voxel::BlockId));
@@ -206,8 +307,10 @@ bool ChunkStorage::SaveChunk(const voxel::ChunkCoord& coord, const voxel::Chunk&
 
     auto end = std::chrono::steady_clock::now();
     auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-    std::cout << "[Storage] Saved chunk " << CoordToString(coord)
-              << " (" << payloadBytes << " bytes, " << elapsed << " ms).\n";
+    if (logSuccess_) {
+        std::cout << "[Storage] Saved chunk " << CoordToString(coord) << " (" << payloadBytes << " bytes, "
+                  << elapsed << " ms).\n";
+    }
     return true;
 }
 
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <filesystem>
+#include <optional>
 
 #include "voxel/Chunk.h"
 #include "voxel/ChunkCoord.h"
+#include "voxel/WorldGen.h"
 
 namespace persistence {
 
@@ -18,11 +20,27 @@ public:
 
     bool ChunkFileExists(const voxel::ChunkCoord& coord) const;
 
+    std::optional<voxel::WorldGenConfig> LoadWorldGen() const;
+    bool SaveWorldGen(const voxel::WorldGenConfig& config);
+
+    // Generator for this save: the persisted one, legacy terrain for chunk files written before world.meta
+    // existed, or freshWorld for an empty save. An unreadable world.meta is kept and freshWorld is used with
+    // a warning. A newly decided generator is written with the first SaveChunk, so runs that never save
+    // leave no world.meta behind.
+    voxel::WorldGenConfig ResolveWorldGen(const voxel::WorldGenConfig& freshWorld);
+
+    // Per-chunk "Loaded"/"Saved" lines; failures are always printed.
+    void SetLogSuccess(bool enabled) { logSuccess_ = enabled; }
+
 private:
     std::filesystem::path ChunkPath(const voxel::ChunkCoord& coord) const;
+    std::filesystem::path WorldPath() const;
+    bool HasChunkFiles() const;
     bool EnsureRoot();
 
     std::filesystem::path root_;
+    bool logSuccess_ = true;
+    std::optional<voxel::WorldGenConfig> pendingWorldGen_;
 };
 
 } // namespace persistence
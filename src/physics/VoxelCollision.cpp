@@ -3,13 +3,14 @@
 #include <cmath>
 
 #include "voxel/BlockId.h"
+#include "voxel/BlockRegistry.h"
 #include "voxel/VoxelCoords.h"
 
 namespace physics {
 
 namespace {
 inline bool IsSolid(voxel::BlockId id) {
-    return id != voxel::kBlockAir;
+    return voxel::BlockRegistry::Default().IsSolid(id);
 }
 
 inline voxel::WorldBlockCoord MakeCoord(int x, int y, int z) {
@@ -0,0 +1,194 @@
+#include "renderer/BlockTextures.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "stb_image.h"
+
+#include "voxel/BlockRegistry.h"
+
+namespace renderer {
+
+namespace {
+
+constexpr int kFallbackSize = 32;
+
+struct TexturePixels {
+    int width = 0;
+    int height = 0;
+    std::vector<std::uint8_t> pixels;
+    bool IsValid() const { return width > 0 && height > 0 && !pixels.empty(); }
+};
+
+std::vector<std::uint8_t> BuildProceduralDirtPixels(int width, int height) {
+    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u);
+    std::uint32_t state = 0x1234abcd;
+    auto nextRandom = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return state;
+    };
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const std::uint32_t noiseSeed =
+                nextRandom() + static_cast<std::uint32_t>(x) * 374761393u + static_cast<std::uint32_t>(y) * 668265263u;
+            const int noise = static_cast<int>((noiseSeed >> 24) & 0xFF) % 37 - 18;
+            int r = 110 + noise + static_cast<int>((noiseSeed >> 16) & 0xF) - 7;
+            int g = 80 + noise;
+            int b = 50 + noise + static_cast<int>((noiseSeed >> 12) & 0x7) - 3;
+            if (((noiseSeed >> 8) & 0xFF) < 15) {
+                r += 20;
+                g += 20;
+                b += 20;
+            }
+            r = std::clamp(r, 0, 255);
+            g = std::clamp(g, 0, 255);
+            b = std::clamp(b, 0, 255);
+
+            const std::size_t index = (static_cast<std::size_t>(y) * static_cast<std::size_t>(width) +
+                                       static_cast<std::size_t>(x)) *
+                                      4u;
+            pixels[index + 0] = static_cast<std::uint8_t>(r);
+            pixels[index + 1] = static_cast<std::uint8_t>(g);
+            pixels[index + 2] = static_cast<std::uint8_t>(b);
+            pixels[index + 3] = 255;
+        }
+    }
+    return pixels;
+}
+
+std::vector<std::uint8_t> BuildProceduralStonePixels(int width, int height) {
+    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u);
+    std::uint32_t state = 0x7f4a7c15u;
+    auto nextRandom = [&state]() {
+        state = state * 1103515245u + 12345u;
+        return state;
+    };
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const std::uint32_t noiseSeed = nextRandom() + static_cast<std::uint32_t>(x) * 2654435761u +
+                                            static_cast<std::uint32_t>(y) * 1013904223u;
+            const int noise = static_cast<int>((noiseSeed >> 24) & 0xFF) % 25 - 12;
+            int shade = 130 + noise;
+            shade = std::clamp(shade, 80, 200);
+            const std::size_t index = (static_cast<std::size_t>(y) * static_cast<std::size_t>(width) +
+                                       static_cast<std::size_t>(x)) *
+                                      4u;
+            pixels[index + 0] = static_cast<std::uint8_t>(shade);
+            pixels[index + 1] = static_cast<std::uint8_t>(shade);
+            pixels[index + 2] = static_cast<std::uint8_t>(shade);
+            pixels[index + 3] = 255;
+        }
+    }
+    return pixels;
+}
+
+// Noise around an arbitrary base colour for layers without a hand-tuned generator.
+std::vector<std::uint8_t> BuildProceduralTintPixels(int width, int height, const std::array<std::uint8_t, 3>& color,
+                                                    std::uint32_t seed) {
+    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u);
+    std::uint32_t state = seed | 1u;
+    for (std::size_t i = 0; i < pixels.size(); i += 4) {
+        state = state * 1664525u + 1013904223u;
+        const int noise = static_cast<int>((state >> 24) & 0xFF) % 31 - 15;
+        for (std::size_t c = 0; c < 3; ++c) {
+            pixels[i + c] = static_cast<std::uint8_t>(std::clamp(static_cast<int>(color[c]) + noise, 0, 255));
+        }
+        pixels[i + 3] = 255;
+    }
+    return pixels;
+}
+
+TexturePixels BuildFallbackPixels(const voxel::TextureLayerDefinition& layer, std::uint32_t seed) {
+    TexturePixels result;
+    result.width = kFallbackSize;
+    result.height = kFallbackSize;
+    if (layer.name == "dirt") {
+        result.pixels = BuildProceduralDirtPixels(kFallbackSize, kFallbackSize);
+    } else if (layer.name == "stone") {
+        result.pixels = BuildProceduralStonePixels(kFallbackSize, kFallbackSize);
+    } else {
+        result.pixels = BuildProceduralTintPixels(kFallbackSize, kFallbackSize, layer.fallbackColor, seed);
+    }
+    return result;
+}
+
+TexturePixels LoadTexturePixels(const std::string& path) {
+    TexturePixels result;
+    int channels = 0;
+    stbi_uc* data = stbi_load(path.c_str(), &result.width, &result.height, &channels, 4);
+    if (!data) {
+        return result;
+    }
+    result.pixels.assign(data, data + (result.width * result.height * 4));
+    stbi_image_free(data);
+    return result;
+}
+
+int MipLevelCount(int width, int height) {
+    int levels = 1;
+    for (int size = std::max(width, height); size > 1; size /= 2) {
+        ++levels;
+    }
+    return levels;
+}
+
+} // namespace
+
+GLuint CreateBlockTextureArray(const voxel::BlockRegistry& blocks) {
+    const auto& layerDefinitions = blocks.Layers();
+    if (layerDefinitions.empty()) {
+        return 0;
+    }
+
+    std::vector<TexturePixels> layers;
+    layers.reserve(layerDefinitions.size());
+    for (std::size_t i = 0; i < layerDefinitions.size(); ++i) {
+        const voxel::TextureLayerDefinition& definition = layerDefinitions[i];
+        TexturePixels pixels = LoadTexturePixels("textures/" + definition.name + ".png");
+        if (!pixels.IsValid()) {
+            std::cout << "[Texture] Using procedurally generated " << definition.name << " texture.\n";
+            pixels = BuildFallbackPixels(definition, static_cast<std::uint32_t>(i) * 2654435761u);
+        }
+        layers.push_back(std::move(pixels));
+    }
+
+    // Array layers share one size; a mismatched layer falls back rather than failing the array.
+    const int width = layers.front().width;
+    const int height = layers.front().height;
+    for (std::size_t i = 1; i < layers.size(); ++i) {
+        if (layers[i].width != width || layers[i].height != height) {
+            std::cout << "[Texture] " << layerDefinitions[i].name << " size differs from "
+                      << layerDefinitions.front().name << ", using its procedural texture.\n";
+            layers[i] = BuildFallbackPixels(layerDefinitions[i], static_cast<std::uint32_t>(i) * 2654435761u);
+            if (width != kFallbackSize || height != kFallbackSize) {
+                return 0;
+            }
+        }
+    }
+
+    GLuint texture = 0;
+    glad_glGenTextures(1, &texture);
+    glad_glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+    glad_glTexStorage3D(GL_TEXTURE_2D_ARRAY, MipLevelCount(width, height), GL_RGBA8, width, height,
+                        static_cast<GLsizei>(layers.size()));
+    for (std::size_t i = 0; i < layers.size(); ++i) {
+        glad_glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(i), width, height, 1, GL_RGBA,
+                             GL_UNSIGNED_BYTE, layers[i].pixels.data());
+    }
+    glad_glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    glad_glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+    glad_glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glad_glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glad_glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glad_glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    return texture;
+}
+
+} // namespace renderer
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <glad/glad.h>
+
+namespace voxel {
+class BlockRegistry;
+}
+
+namespace renderer {
+
+// Builds a mipmapped GL_TEXTURE_2D_ARRAY with one layer per registry texture layer, loaded from
+// textures/<name>.png. Missing files, and files whose size differs from the first layer, fall back
+// to procedural 32x32 noise. Returns 0 on failure.
+GLuint CreateBlockTextureArray(const voxel::BlockRegistry& blocks);
+
+} // namespace renderer
@@ -0,0 +1,221 @@
+#include "renderer/ChunkCuller.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <tuple>
+
+#include "core/Trace.h"
+#include "voxel/Chunk.h"
+#include "voxel/ChunkBounds.h"
+#include "voxel/ChunkRegistry.h"
+#include "voxel/VoxelCoords.h"
+
+namespace renderer {
+
+namespace {
+int FloorDiv(int value, int divisor) {
+    const int quotient = value / divisor;
+    return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+}
+
+void Union(AabbList& list, std::size_t index, const glm::vec3& min, const glm::vec3& max) {
+    list.minX[index] = std::min(list.minX[index], min.x);
+    list.minY[index] = std::min(list.minY[index], min.y);
+    list.minZ[index] = std::min(list.minZ[index], min.z);
+    list.maxX[index] = std::max(list.maxX[index], max.x);
+    list.maxY[index] = std::max(list.maxY[index], max.y);
+    list.maxZ[index] = std::max(list.maxZ[index], max.z);
+}
+} // namespace
+
+void ChunkCullTree::Build(const std::vector<voxel::ChunkCoord>& coords) {
+    order_.clear();
+    order_.reserve(coords.size());
+    for (std::size_t i = 0; i < coords.size(); ++i) {
+        const voxel::ChunkCoord& coord = coords[i];
+        order_.push_back(SortKey{FloorDiv(coord.x, kCullRegionColumns), FloorDiv(coord.z, kCullRegionColumns),
+                                 coord, static_cast<std::uint32_t>(i)});
+    }
+    std::sort(order_.begin(), order_.end(), [](const SortKey& a, const SortKey& b) {
+        return std::tie(a.regionX, a.regionZ, a.coord.x, a.coord.z, a.coord.y) <
+               std::tie(b.regionX, b.regionZ, b.coord.x, b.coord.z, b.coord.y);
+    });
+
+    regionBounds_.Clear();
+    columnBounds_.Clear();
+    chunkBounds_.Clear();
+    regions_.clear();
+    columns_.clear();
+    chunkIndices_.clear();
+    chunkIndices_.reserve(order_.size());
+
+    for (std::size_t i = 0; i < order_.size(); ++i) {
+        const SortKey& key = order_[i];
+        const voxel::ChunkBounds bounds = voxel::GetChunkBounds(key.coord);
+        const bool newRegion =
+            i == 0 || key.regionX != order_[i - 1].regionX || key.regionZ != order_[i - 1].regionZ;
+        const bool newColumn =
+            newRegion || key.coord.x != order_[i - 1].coord.x || key.coord.z != order_[i - 1].coord.z;
+
+        if (newRegion) {
+            regions_.push_back(Group{static_cast<std::uint32_t>(columns_.size()), 0});
+            regionBounds_.Push(bounds.min, bounds.max);
+        }
+        if (newColumn) {
+            columns_.push_back(Group{static_cast<std::uint32_t>(chunkIndices_.size()), 0});
+            columnBounds_.Push(bounds.min, bounds.max);
+            ++regions_.back().count;
+        }
+        Union(regionBounds_, regions_.size() - 1, bounds.min, bounds.max);
+        Union(columnBounds_, columns_.size() - 1, bounds.min, bounds.max);
+        chunkBounds_.Push(bounds.min, bounds.max);
+        chunkIndices_.push_back(key.index);
+        ++columns_.back().count;
+    }
+
+    regionMask_.resize(regions_.size());
+    columnMask_.resize(columns_.size());
+    chunkMask_.resize(chunkIndices_.size());
+    stats_.regions = regions_.size();
+    stats_.columns = columns_.size();
+    ++stats_.builds;
+}
+
+void ChunkCullTree::Cull(const Frustum& frustum, std::vector<std::uint32_t>& visible) {
+    stats_.boxTests = regions_.size();
+    frustum.IntersectsAabbs(regionBounds_, 0, regions_.size(), regionMask_.data());
+    for (std::size_t r = 0; r < regions_.size(); ++r) {
+        if (!regionMask_[r]) {
+            continue;
+        }
+        const Group& region = regions_[r];
+        frustum.IntersectsAabbs(columnBounds_, region.first, region.count, columnMask_.data() + region.first);
+        stats_.boxTests += region.count;
+        for (std::uint32_t c = region.first; c < region.first + region.count; ++c) {
+            if (!columnMask_[c]) {
+                continue;
+            }
+            const Group& column = columns_[c];
+            frustum.IntersectsAabbs(chunkBounds_, column.first, column.count, chunkMask_.data() + column.first);
+            stats_.boxTests += column.count;
+            for (std::uint32_t k = column.first; k < column.first + column.count; ++k) {
+                if (chunkMask_[k]) {
+                    visible.push_back(chunkIndices_[k]);
+                }
+            }
+        }
+    }
+}
+
+void ChunkCuller::SyncTree(const ChunkRenderList& list) {
+    if (treeLayout_ == list.LayoutRevision()) {
+        return;
+    }
+    coords_.clear();
+    for (const RenderChunk& chunk : list.Chunks()) {
+        coords_.push_back(chunk.coord);
+    }
+    tree_.Build(coords_);
+    treeLayout_ = list.LayoutRevision();
+}
+
+void ChunkCuller::SyncGraph(const ChunkRenderList& list) {
+    if (graphLayout_ != list.VisibilityLayoutRevision()) {
+        graph_.Clear();
+        for (const auto& [coord, occluder] : list.Occluders()) {
+            graph_.SetVisibility(coord, occluder.visibility);
+        }
+    } else if (graphRevision_ != list.VisibilityRevision()) {
+        // Nothing was cleared; only uploads since the last sync can have added or changed visibility.
+        for (const auto& [coord, occluder] : list.Occluders()) {
+            if (occluder.revision > graphRevision_) {
+                graph_.SetVisibility(coord, occluder.visibility);
+            }
+        }
+    }
+    graphLayout_ = list.VisibilityLayoutRevision();
+    graphRevision_ = list.VisibilityRevision();
+}
+
+ChunkCullResult ChunkCuller::Cull(const ChunkRenderList& list, const Frustum& frustum,
+                                  const ChunkCullOptions& options, std::vector<std::uint32_t>& visible) {
+    core::TraceScope traceScope("Cull");
+    const std::vector<RenderChunk>& chunks = list.Chunks();
+    ChunkCullResult result;
+    result.candidates = chunks.size();
+    visible.clear();
+
+    inRange_.assign(chunks.size(), 1);
+    if (options.distance) {
+        for (std::size_t i = 0; i < chunks.size(); ++i) {
+            const voxel::ChunkCoord& coord = chunks[i].coord;
+            const int dx = std::abs(coord.x - options.playerChunk.x);
+            const int dz = std::abs(coord.z - options.playerChunk.z);
+            if (std::max(dx, dz) > options.renderRadius) {
+                inRange_[i] = 0;
+                ++result.distanceCulled;
+            }
+        }
+    }
+
+    // The tree covers the whole list so it survives player moves; distance is applied to its output.
+    treeVisible_.clear();
+    if (options.frustum) {
+        SyncTree(list);
+        tree_.Cull(frustum, treeVisible_);
+    } else {
+        for (std::size_t i = 0; i < chunks.size(); ++i) {
+            treeVisible_.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+
+    if (options.occlusion) {
+        SyncGraph(list);
+        const voxel::ChunkCoord eyeChunk = voxel::WorldToChunkCoord(
+            voxel::WorldBlockCoord{static_cast<int>(std::floor(options.eye.x)),
+                                   static_cast<int>(std::floor(options.eye.y)),
+                                   static_cast<int>(std::floor(options.eye.z))},
+            voxel::kChunkSize);
+        graph_.Traverse(eyeChunk, options.frustum ? &frustum : nullptr, options.renderRadius,
+                        options.verticalRadius);
+    }
+
+    std::size_t inFrustum = 0;
+    visible.reserve(treeVisible_.size());
+    for (std::uint32_t index : treeVisible_) {
+        assert(index < chunks.size());
+        if (!inRange_[index]) {
+            continue;
+        }
+        ++inFrustum;
+        if (options.occlusion && !graph_.IsReachable(chunks[index].coord)) {
+            ++result.occlusionCulled;
+            continue;
+        }
+        visible.push_back(index);
+        const voxel::ChunkMesh& mesh = chunks[index].entry->mesh;
+        const auto lod = static_cast<std::size_t>(mesh.Lod());
+        ++result.lodChunks[lod];
+        result.lodTriangles[lod] += mesh.GpuIndexCount() / 3;
+    }
+    result.frustumCulled = chunks.size() - result.distanceCulled - inFrustum;
+    return result;
+}
+
+std::string DescribeLodRings(const ChunkCullResult& result) {
+    std::ostringstream out;
+    out << "[Lod] drawn";
+    for (std::size_t lod = 0; lod < result.lodChunks.size(); ++lod) {
+        out << (lod == 0 ? ' ' : '/') << result.lodChunks[lod];
+    }
+    out << " tris";
+    for (std::size_t lod = 0; lod < result.lodTriangles.size(); ++lod) {
+        out << (lod == 0 ? ' ' : '/') << result.lodTriangles[lod];
+    }
+    return out.str();
+}
+
+} // namespace renderer
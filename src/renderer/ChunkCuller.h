@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "math/Frustum.h"
+#include "renderer/ChunkRenderList.h"
+#include "voxel/ChunkCoord.h"
+#include "voxel/ChunkLod.h"
+#include "voxel/ChunkVisibility.h"
+
+namespace renderer {
+
+// Columns per region edge; a region covers kCullRegionColumns^2 chunk columns.
+constexpr int kCullRegionColumns = 4;
+
+struct CullTreeStats {
+    std::size_t regions = 0;
+    std::size_t columns = 0;
+    std::size_t boxTests = 0;
+    std::size_t builds = 0;
+};
+
+// Two-level spatial hierarchy over chunk coordinates: region -> column -> chunk, each node with a
+// bounding box. Cull walks it top-down with the batched frustum test so a hidden region or column
+// rejects all of its chunks with one box test.
+class ChunkCullTree {
+public:
+    void Build(const std::vector<voxel::ChunkCoord>& coords);
+
+    // Appends the Build indices of chunks intersecting the frustum, grouped by region and column.
+    void Cull(const Frustum& frustum, std::vector<std::uint32_t>& visible);
+
+    const CullTreeStats& Stats() const { return stats_; }
+
+private:
+    struct Group {
+        std::uint32_t first = 0;
+        std::uint32_t count = 0;
+    };
+
+    struct SortKey {
+        int regionX = 0;
+        int regionZ = 0;
+        voxel::ChunkCoord coord;
+        std::uint32_t index = 0;
+    };
+
+    AabbList regionBounds_;
+    AabbList columnBounds_;
+    AabbList chunkBounds_;
+    std::vector<Group> regions_;
+    std::vector<Group> columns_;
+    std::vector<std::uint32_t> chunkIndices_;
+    std::vector<SortKey> order_;
+    std::vector<std::uint8_t> regionMask_;
+    std::vector<std::uint8_t> columnMask_;
+    std::vector<std::uint8_t> chunkMask_;
+    CullTreeStats stats_;
+};
+
+struct ChunkCullOptions {
+    bool distance = true;
+    bool frustum = true;
+    bool occlusion = true;
+    int renderRadius = 0;
+    int verticalRadius = 0;
+    voxel::ChunkCoord playerChunk;
+    glm::vec3 eye{0.0f};
+};
+
+struct ChunkCullResult {
+    std::size_t candidates = 0;
+    std::size_t distanceCulled = 0;
+    std::size_t frustumCulled = 0;
+    std::size_t occlusionCulled = 0;
+    // Visible chunks and their full mesh triangle counts (before facing masks) per LOD ring.
+    std::array<std::size_t, voxel::kLodLevelCount> lodChunks{};
+    std::array<std::size_t, voxel::kLodLevelCount> lodTriangles{};
+};
+
+// Distance, hierarchical frustum and occlusion culling over the render list. Never touches the
+// registry, so the render loop runs without the registry lock. The tree is rebuilt only when the list
+// layout changes and the visibility graph only picks up visibility set since the last frame.
+class ChunkCuller {
+public:
+    // visible receives indices into list.Chunks().
+    ChunkCullResult Cull(const ChunkRenderList& list, const Frustum& frustum, const ChunkCullOptions& options,
+                         std::vector<std::uint32_t>& visible);
+
+    const CullTreeStats& TreeStats() const { return tree_.Stats(); }
+
+private:
+    static constexpr std::uint64_t kNeverSynced = ~std::uint64_t{0};
+
+    void SyncTree(const ChunkRenderList& list);
+    void SyncGraph(const ChunkRenderList& list);
+
+    ChunkCullTree tree_;
+    voxel::VisibilityGraph graph_;
+    std::uint64_t treeLayout_ = kNeverSynced;
+    std::uint64_t graphLayout_ = kNeverSynced;
+    std::uint64_t graphRevision_ = 0;
+    std::vector<voxel::ChunkCoord> coords_;
+    std::vector<std::uint8_t> inRange_;
+    std::vector<std::uint32_t> treeVisible_;
+};
+
+// "[Lod] drawn a/b/c/d tris A/B/C/D", one entry per LOD ring from full detail outwards.
+std::string DescribeLodRings(const ChunkCullResult& result);
+
+} // namespace renderer
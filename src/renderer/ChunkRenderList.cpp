@@ -0,0 +1,58 @@
+#include "renderer/ChunkRenderList.h"
+
+#include <utility>
+
+namespace renderer {
+
+void ChunkRenderList::Upsert(const voxel::ChunkCoord& coord, const std::shared_ptr<voxel::ChunkEntry>& entry) {
+    ++revision_;
+    auto [it, inserted] = slots_.emplace(coord, chunks_.size());
+    if (inserted) {
+        ++layoutRevision_;
+        chunks_.push_back(RenderChunk{coord, entry, revision_});
+    } else {
+        chunks_[it->second].entry = entry;
+        chunks_[it->second].revision = revision_;
+    }
+}
+
+bool ChunkRenderList::Remove(const voxel::ChunkCoord& coord) {
+    auto it = slots_.find(coord);
+    if (it == slots_.end()) {
+        return false;
+    }
+    ++revision_;
+    ++layoutRevision_;
+    const std::size_t slot = it->second;
+    slots_.erase(it);
+    if (slot + 1 != chunks_.size()) {
+        chunks_[slot] = std::move(chunks_.back());
+        slots_[chunks_[slot].coord] = slot;
+    }
+    chunks_.pop_back();
+    return true;
+}
+
+void ChunkRenderList::Clear() {
+    ++revision_;
+    ++layoutRevision_;
+    chunks_.clear();
+    slots_.clear();
+    ++visibilityRevision_;
+    ++visibilityLayoutRevision_;
+    occluders_.clear();
+}
+
+void ChunkRenderList::SetVisibility(const voxel::ChunkCoord& coord, const voxel::ChunkVisibility& visibility) {
+    ++visibilityRevision_;
+    occluders_[coord] = ChunkOccluder{visibility, visibilityRevision_};
+}
+
+void ChunkRenderList::ClearVisibility(const voxel::ChunkCoord& coord) {
+    if (occluders_.erase(coord) > 0) {
+        ++visibilityRevision_;
+        ++visibilityLayoutRevision_;
+    }
+}
+
+} // namespace renderer
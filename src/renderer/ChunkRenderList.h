@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "voxel/ChunkCoord.h"
+#include "voxel/ChunkVisibility.h"
+
+namespace voxel {
+struct ChunkEntry;
+}
+
+namespace renderer {
+
+struct RenderChunk {
+    voxel::ChunkCoord coord;
+    std::shared_ptr<voxel::ChunkEntry> entry;
+    // List revision of the last upsert, so consumers can pick up replaced meshes without a full pass.
+    std::uint64_t revision = 0;
+};
+
+struct ChunkOccluder {
+    voxel::ChunkVisibility visibility;
+    // Visibility revision of the last set.
+    std::uint64_t revision = 0;
+};
+
+// Main-thread list of chunks with a GPU mesh. Kept up to date by upload and unload events so the
+// render loop never iterates (or locks) the registry map. Order is unspecified; removal swaps the
+// last chunk into the freed slot.
+class ChunkRenderList {
+public:
+    void Upsert(const voxel::ChunkCoord& coord, const std::shared_ptr<voxel::ChunkEntry>& entry);
+    bool Remove(const voxel::ChunkCoord& coord);
+    void Clear();
+
+    bool Contains(const voxel::ChunkCoord& coord) const { return slots_.contains(coord); }
+    std::size_t Size() const { return chunks_.size(); }
+    const std::vector<RenderChunk>& Chunks() const { return chunks_; }
+    // Bumped by every change.
+    std::uint64_t Revision() const { return revision_; }
+    // Bumped when chunks are added, removed or moved to another slot.
+    std::uint64_t LayoutRevision() const { return layoutRevision_; }
+
+    // Face connectivity of every uploaded mesh, including empty ones that never enter the list: a fully
+    // solid chunk draws nothing but is exactly what occlusion culling needs to stop at.
+    void SetVisibility(const voxel::ChunkCoord& coord, const voxel::ChunkVisibility& visibility);
+    void ClearVisibility(const voxel::ChunkCoord& coord);
+    const std::unordered_map<voxel::ChunkCoord, ChunkOccluder, voxel::ChunkCoordHash>& Occluders() const {
+        return occluders_;
+    }
+    // Bumped by every visibility change.
+    std::uint64_t VisibilityRevision() const { return visibilityRevision_; }
+    // Bumped when a visibility is cleared.
+    std::uint64_t VisibilityLayoutRevision() const { return visibilityLayoutRevision_; }
+
+private:
+    std::vector<RenderChunk> chunks_;
+    std::uint64_t revision_ = 0;
+    std::uint64_t layoutRevision_ = 0;
+    std::unordered_map<voxel::ChunkCoord, std::size_t, voxel::ChunkCoordHash> slots_;
+    std::unordered_map<voxel::ChunkCoord, ChunkOccluder, voxel::ChunkCoordHash> occluders_;
+    std::uint64_t visibilityRevision_ = 0;
+    std::uint64_t visibilityLayoutRevision_ = 0;
+};
+
+} // namespace renderer
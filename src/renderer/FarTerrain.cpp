@@ -0,0 +1,243 @@
+#include "renderer/FarTerrain.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include <glm/glm.hpp>
+
+#include "core/Assert.h"
+#include "core/Trace.h"
+#include "voxel/BlockRegistry.h"
+#include "voxel/Chunk.h"
+#include "voxel/WorldGen.h"
+
+namespace renderer {
+
+namespace {
+int FloorDiv(int value, int divisor) {
+    const int quotient = value / divisor;
+    return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+}
+
+std::uint64_t TileKey(int tileX, int tileZ) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(tileX)) << 32) |
+           static_cast<std::uint64_t>(static_cast<std::uint32_t>(tileZ));
+}
+
+int AxisDistance(int value, int min, int max) {
+    return value < min ? min - value : (value > max ? value - max : 0);
+}
+} // namespace
+
+void PlanFarTerrainTiles(const voxel::ChunkCoord& playerChunk, int nearRadius, const FarTerrainConfig& config,
+                         std::vector<FarTilePlan>& out) {
+    out.clear();
+    const int tile = config.tileChunks;
+    const ColumnRect hole{playerChunk.x - nearRadius, playerChunk.z - nearRadius, playerChunk.x + nearRadius,
+                          playerChunk.z + nearRadius};
+    const int minTileX = FloorDiv(playerChunk.x - config.radiusChunks, tile);
+    const int maxTileX = FloorDiv(playerChunk.x + config.radiusChunks, tile);
+    const int minTileZ = FloorDiv(playerChunk.z - config.radiusChunks, tile);
+    const int maxTileZ = FloorDiv(playerChunk.z + config.radiusChunks, tile);
+
+    for (int tz = minTileZ; tz <= maxTileZ; ++tz) {
+        for (int tx = minTileX; tx <= maxTileX; ++tx) {
+            const ColumnRect columns{tx * tile, tz * tile, tx * tile + tile - 1, tz * tile + tile - 1};
+            ColumnRect clipped{std::max(hole.minX, columns.minX), std::max(hole.minZ, columns.minZ),
+                               std::min(hole.maxX, columns.maxX), std::min(hole.maxZ, columns.maxZ)};
+            if (clipped == columns) {
+                continue;
+            }
+            if (clipped.Empty()) {
+                clipped = ColumnRect{};
+            }
+            const int distance = std::max(AxisDistance(playerChunk.x, columns.minX, columns.maxX),
+                                          AxisDistance(playerChunk.z, columns.minZ, columns.maxZ));
+            out.push_back(FarTilePlan{tx, tz, clipped, distance});
+        }
+    }
+    std::stable_sort(out.begin(), out.end(),
+                     [](const FarTilePlan& a, const FarTilePlan& b) { return a.distance < b.distance; });
+}
+
+void BuildFarTerrainTile(const voxel::WorldGenerator& generator, const FarTilePlan& plan,
+                         const FarTerrainConfig& config, voxel::ChunkMesh& mesh, glm::vec3& boundsMin,
+                         glm::vec3& boundsMax) {
+    MC_ASSERT(config.cellBlocks > 0 && voxel::kChunkSize % config.cellBlocks == 0,
+              "Far terrain cells must tile a chunk.");
+    mesh.Clear();
+
+    const int cell = config.cellBlocks;
+    const int cells = config.tileChunks * voxel::kChunkSize / cell;
+    const int originX = plan.tileX * config.tileChunks * voxel::kChunkSize;
+    const int originZ = plan.tileZ * config.tileChunks * voxel::kChunkSize;
+
+    // Corner heights with a one-sample border for the normals, as one batched grid.
+    const int side = cells + 3;
+    std::vector<int> heights(static_cast<std::size_t>(side * side));
+    std::vector<std::uint8_t> biomes(heights.size());
+    generator.SampleHeightColumns(originX - cell, originZ - cell, side, side, heights.data(), biomes.data(), cell);
+    auto heightAt = [&](int i, int j) { return heights[static_cast<std::size_t>(i + 1 + side * (j + 1))]; };
+
+    const auto& layers = generator.Config().biomes;
+    const voxel::BlockRegistry& blocks = voxel::BlockRegistry::Default();
+    auto& vertices = mesh.Vertices();
+    auto& indices = mesh.Indices();
+    vertices.reserve(static_cast<std::size_t>((cells + 1) * (cells + 1)));
+    indices.reserve(static_cast<std::size_t>(cells * cells * 6));
+
+    int minHeight = heightAt(0, 0);
+    int maxHeight = minHeight;
+    for (int j = 0; j <= cells; ++j) {
+        for (int i = 0; i <= cells; ++i) {
+            const int height = heightAt(i, j);
+            minHeight = std::min(minHeight, height);
+            maxHeight = std::max(maxHeight, height);
+            const glm::vec3 normal =
+                glm::normalize(glm::vec3{static_cast<float>(heightAt(i - 1, j) - heightAt(i + 1, j)),
+                                         static_cast<float>(2 * cell),
+                                         static_cast<float>(heightAt(i, j - 1) - heightAt(i, j + 1))});
+            const auto biome = static_cast<std::size_t>(biomes[static_cast<std::size_t>(i + 1 + side * (j + 1))]);
+            const voxel::BlockId top = biome < layers.size() ? layers[biome].topBlock : voxel::kBlockDirt;
+            vertices.push_back(voxel::VoxelVertex{
+                glm::vec3{static_cast<float>(originX + i * cell), static_cast<float>(height + 1),
+                          static_cast<float>(originZ + j * cell)},
+                voxel::PackNormal(normal), blocks.FaceLayer(top, 2), voxel::PackUnit(1.0f), 0});
+        }
+    }
+
+    // Same corner order as the +Y block face so the winding matches chunk meshes.
+    const auto stride = static_cast<std::uint32_t>(cells + 1);
+    for (int j = 0; j < cells; ++j) {
+        for (int i = 0; i < cells; ++i) {
+            const int columnX = FloorDiv(originX + i * cell, voxel::kChunkSize);
+            const int columnZ = FloorDiv(originZ + j * cell, voxel::kChunkSize);
+            if (plan.hole.Contains(columnX, columnZ)) {
+                continue;
+            }
+            const auto base = static_cast<std::uint32_t>(i) + stride * static_cast<std::uint32_t>(j);
+            const std::uint32_t corner[4] = {base, base + stride, base + stride + 1, base + 1};
+            indices.insert(indices.end(), {corner[0], corner[1], corner[2], corner[0], corner[2], corner[3]});
+        }
+    }
+
+    mesh.Faces()[2] = voxel::FaceRange{0, static_cast<std::uint32_t>(indices.size())};
+    const float extent = static_cast<float>(cells * cell);
+    boundsMin = glm::vec3{static_cast<float>(originX), static_cast<float>(minHeight + 1),
+                          static_cast<float>(originZ)};
+    boundsMax = glm::vec3{static_cast<float>(originX) + extent, static_cast<float>(maxHeight + 1),
+                          static_cast<float>(originZ) + extent};
+}
+
+FarTerrain::FarTerrain(const voxel::WorldGenerator& generator, voxel::MeshStore& store, FarTerrainConfig config)
+    : generator_(generator), store_(store), config_(config) {
+    config_.tileChunks = std::max(1, config_.tileChunks);
+    config_.maxTileBuildsPerFrame = std::max(1, config_.maxTileBuildsPerFrame);
+}
+
+FarTerrain::~FarTerrain() {
+    Clear();
+}
+
+void FarTerrain::Update(const voxel::ChunkCoord& playerChunk, int nearRadius) {
+    core::TraceScope traceScope("Far terrain");
+    stats_.builtThisFrame = 0;
+    if (!planned_ || playerChunk.x != plannedChunk_.x || playerChunk.z != plannedChunk_.z ||
+        nearRadius != plannedRadius_) {
+        planned_ = true;
+        plannedChunk_ = playerChunk;
+        plannedRadius_ = nearRadius;
+        PlanFarTerrainTiles(playerChunk, nearRadius, config_, plan_);
+
+        std::unordered_map<std::uint64_t, Tile> kept;
+        kept.reserve(plan_.size());
+        pending_.clear();
+        for (const FarTilePlan& plan : plan_) {
+            const std::uint64_t key = TileKey(plan.tileX, plan.tileZ);
+            auto it = tiles_.find(key);
+            if (it == tiles_.end()) {
+                pending_.push_back(plan);
+                continue;
+            }
+            if (!(it->second.hole == plan.hole)) {
+                pending_.push_back(plan);
+            }
+            kept.emplace(key, std::move(it->second));
+            tiles_.erase(it);
+        }
+        for (auto& [key, tile] : tiles_) {
+            tile.mesh.DestroyGpu();
+        }
+        tiles_ = std::move(kept);
+        // Nearest first: stale tiles next to the hole would otherwise overlap freshly loaded chunks.
+        std::reverse(pending_.begin(), pending_.end());
+    }
+
+    while (!pending_.empty() && stats_.builtThisFrame < static_cast<std::size_t>(config_.maxTileBuildsPerFrame)) {
+        const FarTilePlan plan = pending_.back();
+        pending_.pop_back();
+        Tile& tile = tiles_[TileKey(plan.tileX, plan.tileZ)];
+        stats_.triangles -= tile.mesh.GpuIndexCount() / 3;
+        BuildFarTerrainTile(generator_, plan, config_, tile.mesh, tile.boundsMin, tile.boundsMax);
+        tile.hole = plan.hole;
+        tile.mesh.UploadToGpu(store_);
+        tile.mesh.ClearCpu();
+        stats_.triangles += tile.mesh.GpuIndexCount() / 3;
+        ++stats_.builtThisFrame;
+        ++stats_.builtTotal;
+    }
+
+    stats_.tiles = tiles_.size();
+    stats_.pendingTiles = pending_.size();
+}
+
+std::size_t FarTerrain::QueueVisible(const Frustum& frustum) {
+    bounds_.Clear();
+    boundTiles_.clear();
+    for (const auto& [key, tile] : tiles_) {
+        if (tile.mesh.GpuIndexCount() == 0) {
+            continue;
+        }
+        bounds_.Push(tile.boundsMin, tile.boundsMax);
+        boundTiles_.push_back(&tile);
+    }
+    mask_.resize(boundTiles_.size());
+    frustum.IntersectsAabbs(bounds_, 0, boundTiles_.size(), mask_.data());
+
+    stats_.drawnTiles = 0;
+    for (std::size_t i = 0; i < boundTiles_.size(); ++i) {
+        if (mask_[i]) {
+            boundTiles_[i]->mesh.QueueDraw();
+            ++stats_.drawnTiles;
+        }
+    }
+    return stats_.drawnTiles;
+}
+
+void FarTerrain::Clear() {
+    for (auto& [key, tile] : tiles_) {
+        tile.mesh.DestroyGpu();
+    }
+    tiles_.clear();
+    pending_.clear();
+    planned_ = false;
+    stats_.tiles = 0;
+    stats_.pendingTiles = 0;
+    stats_.triangles = 0;
+    stats_.drawnTiles = 0;
+}
+
+float FarTerrain::ViewDistance() const {
+    const float reach = static_cast<float>((config_.radiusChunks + config_.tileChunks) * voxel::kChunkSize);
+    return reach * std::sqrt(2.0f);
+}
+
+std::string DescribeFarTerrain(const FarTerrainStats& stats) {
+    std::ostringstream out;
+    out << "[Far] tiles " << stats.tiles << " (pending " << stats.pendingTiles << ") tris " << stats.triangles
+        << " drawn " << stats.drawnTiles << " built " << stats.builtThisFrame << '/' << stats.builtTotal;
+    return out.str();
+}
+
+} // namespace renderer
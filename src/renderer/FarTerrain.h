@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include "math/Frustum.h"
+#include "voxel/ChunkCoord.h"
+#include "voxel/ChunkMesh.h"
+
+namespace voxel {
+class WorldGenerator;
+}
+
+namespace renderer {
+
+struct FarTerrainConfig {
+    int tileChunks = 4;             // tile edge in chunk columns
+    int cellBlocks = 8;             // heightfield grid spacing; must divide the chunk size
+    int radiusChunks = 40;          // outer edge of the ring, Chebyshev distance in chunks
+    int maxTileBuildsPerFrame = 4;
+};
+
+// Inclusive rectangle of chunk columns; empty when min > max on either axis.
+struct ColumnRect {
+    int minX = 0;
+    int minZ = 0;
+    int maxX = -1;
+    int maxZ = -1;
+
+    bool Empty() const { return minX > maxX || minZ > maxZ; }
+    bool Contains(int x, int z) const { return x >= minX && x <= maxX && z >= minZ && z <= maxZ; }
+    bool operator==(const ColumnRect& other) const {
+        return Empty() ? other.Empty()
+                       : minX == other.minX && minZ == other.minZ && maxX == other.maxX && maxZ == other.maxZ;
+    }
+};
+
+// One tile of the ring and the chunk columns inside it that the chunk renderer already covers.
+struct FarTilePlan {
+    int tileX = 0;
+    int tileZ = 0;
+    ColumnRect hole;
+    int distance = 0;
+};
+
+// Tiles overlapping the ring around playerChunk, nearest first. Columns within nearRadius of the player
+// are holes; tiles lying entirely inside the hole are left out.
+void PlanFarTerrainTiles(const voxel::ChunkCoord& playerChunk, int nearRadius, const FarTerrainConfig& config,
+                         std::vector<FarTilePlan>& out);
+
+// Builds the heightfield for one tile straight from the generator's surface height, skipping cells in the
+// hole. All triangles face up, so indices go in the +Y face range. GL-free.
+void BuildFarTerrainTile(const voxel::WorldGenerator& generator, const FarTilePlan& plan,
+                         const FarTerrainConfig& config, voxel::ChunkMesh& mesh, glm::vec3& boundsMin,
+                         glm::vec3& boundsMax);
+
+struct FarTerrainStats {
+    std::size_t tiles = 0;
+    std::size_t pendingTiles = 0;
+    std::size_t triangles = 0;
+    std::size_t builtThisFrame = 0;
+    std::uint64_t builtTotal = 0;
+    std::size_t drawnTiles = 0;
+};
+
+// Low-poly terrain beyond the chunk render radius, built without instantiating any chunks. Tiles are
+// meshes in the shared mesh store and are drawn in the same batch as chunks. Only tiles entering the ring or
+// whose hole changed are rebuilt as the player moves. Main thread only.
+class FarTerrain {
+public:
+    FarTerrain(const voxel::WorldGenerator& generator, voxel::MeshStore& store, FarTerrainConfig config = {});
+    ~FarTerrain();
+
+    FarTerrain(const FarTerrain&) = delete;
+    FarTerrain& operator=(const FarTerrain&) = delete;
+
+    // Re-plans the ring when the player chunk or near radius changed, frees tiles that left it and builds
+    // up to maxTileBuildsPerFrame missing or stale tiles.
+    void Update(const voxel::ChunkCoord& playerChunk, int nearRadius);
+
+    // Adds tiles intersecting the frustum to the store's open batch; returns the number queued.
+    std::size_t QueueVisible(const Frustum& frustum);
+
+    void Clear();
+
+    // Farthest point of the ring from the player, for sizing the far clip plane.
+    float ViewDistance() const;
+
+    const FarTerrainConfig& Config() const { return config_; }
+    const FarTerrainStats& Stats() const { return stats_; }
+
+private:
+    struct Tile {
+        ColumnRect hole;
+        voxel::ChunkMesh mesh;
+        glm::vec3 boundsMin{0.0f};
+        glm::vec3 boundsMax{0.0f};
+    };
+
+    const voxel::WorldGenerator& generator_;
+    voxel::MeshStore& store_;
+    FarTerrainConfig config_;
+    std::unordered_map<std::uint64_t, Tile> tiles_;
+    std::vector<FarTilePlan> plan_;
+    std::vector<FarTilePlan> pending_;
+    voxel::ChunkCoord plannedChunk_;
+    int plannedRadius_ = 0;
+    bool planned_ = false;
+    AabbList bounds_;
+    std::vector<const Tile*> boundTiles_;
+    std::vector<std::uint8_t> mask_;
+    FarTerrainStats stats_;
+};
+
+// "[Far] tiles a (pending b) tris c drawn d built e/f"
+std::string DescribeFarTerrain(const FarTerrainStats& stats);
+
+} // namespace renderer
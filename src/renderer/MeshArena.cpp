@@ -0,0 +1,474 @@
+#include "renderer/MeshArena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include "core/Assert.h"
+#include "voxel/ChunkMesh.h"
+
+namespace renderer {
+
+namespace {
+
+constexpr GLbitfield kStorageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+constexpr std::size_t kVertexBytes = sizeof(voxel::VoxelVertex);
+constexpr std::size_t kIndexBytes = sizeof(std::uint32_t);
+// Quads are 4 vertices / 6 indices.
+constexpr std::size_t kIndexCapacityNum = 3;
+constexpr std::size_t kIndexCapacityDen = 2;
+constexpr std::size_t kAllocationGranule = 64;
+constexpr std::size_t kMaxFramesInFlight = 3;
+constexpr std::size_t kIndirectSegments = kMaxFramesInFlight + 1;
+constexpr std::size_t kIndirectSegmentCommands = 1024;
+constexpr GLuint64 kFenceWaitNs = 1'000'000'000;
+constexpr float kDefragFragmentation = 0.5f;
+constexpr std::size_t kDefragMinFreeBlocks = 64;
+constexpr std::uint64_t kDefragMinFrames = 600;
+
+// Headroom so that a remesh adding a few faces can still overwrite in place.
+std::size_t WithSlack(std::size_t count) {
+    if (count == 0) {
+        return 0;
+    }
+    const std::size_t padded = count + count / 8;
+    return (padded + kAllocationGranule - 1) / kAllocationGranule * kAllocationGranule;
+}
+
+struct CopyRun {
+    std::size_t src = 0;
+    std::size_t dst = 0;
+    std::size_t bytes = 0;
+};
+
+void AppendRun(std::vector<CopyRun>& runs, std::size_t src, std::size_t dst, std::size_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+    if (!runs.empty()) {
+        CopyRun& last = runs.back();
+        if (last.src + last.bytes == src && last.dst + last.bytes == dst) {
+            last.bytes += bytes;
+            return;
+        }
+    }
+    runs.push_back({src, dst, bytes});
+}
+
+void CopyRuns(GLuint from, GLuint to, const std::vector<CopyRun>& runs) {
+    if (runs.empty()) {
+        return;
+    }
+    glad_glBindBuffer(GL_COPY_READ_BUFFER, from);
+    glad_glBindBuffer(GL_COPY_WRITE_BUFFER, to);
+    for (const CopyRun& run : runs) {
+        glad_glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(run.src),
+                                 static_cast<GLintptr>(run.dst), static_cast<GLsizeiptr>(run.bytes));
+    }
+    glad_glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glad_glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+} // namespace
+
+MeshArena::MeshArena(std::size_t vertexCapacity)
+    : vertexAllocator_(vertexCapacity),
+      indexAllocator_(vertexCapacity * kIndexCapacityNum / kIndexCapacityDen) {
+    MC_ASSERT_MAIN_THREAD_GL();
+    vertexBuffer_ = CreateBuffer(vertexAllocator_.Capacity() * kVertexBytes);
+    indexBuffer_ = CreateBuffer(indexAllocator_.Capacity() * kIndexBytes);
+    glad_glGenVertexArrays(1, &vao_);
+    ConfigureVao();
+    GrowIndirect(kIndirectSegmentCommands);
+}
+
+MeshArena::~MeshArena() {
+    MC_ASSERT_MAIN_THREAD_GL();
+    for (FrameFence& fence : fences_) {
+        glad_glDeleteSync(fence.sync);
+    }
+    fences_.clear();
+    if (vao_ != 0) {
+        glad_glDeleteVertexArrays(1, &vao_);
+        vao_ = 0;
+    }
+    DestroyBuffer(indirectBuffer_);
+    DestroyBuffer(indexBuffer_);
+    DestroyBuffer(vertexBuffer_);
+}
+
+MeshArena::Buffer MeshArena::CreateBuffer(std::size_t bytes) {
+    Buffer buffer;
+    glad_glGenBuffers(1, &buffer.id);
+    glad_glBindBuffer(GL_COPY_WRITE_BUFFER, buffer.id);
+    glad_glBufferStorage(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, kStorageFlags);
+    buffer.mapped = glad_glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, static_cast<GLsizeiptr>(bytes), kStorageFlags);
+    glad_glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    MC_ASSERT(buffer.mapped != nullptr, "MeshArena failed to map persistent buffer.");
+    return buffer;
+}
+
+void MeshArena::DestroyBuffer(Buffer& buffer) {
+    if (buffer.id == 0) {
+        return;
+    }
+    glad_glBindBuffer(GL_COPY_WRITE_BUFFER, buffer.id);
+    glad_glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    glad_glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glad_glDeleteBuffers(1, &buffer.id);
+    buffer = Buffer{};
+}
+
+void MeshArena::ConfigureVao() {
+    using voxel::VoxelVertex;
+    glad_glBindVertexArray(vao_);
+    glad_glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer_.id);
+    glad_glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer_.id);
+
+    glad_glEnableVertexAttribArray(0);
+    glad_glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(VoxelVertex),
+                               reinterpret_cast<void*>(offsetof(VoxelVertex, position)));
+
+    glad_glEnableVertexAttribArray(1);
+    glad_glVertexAttribPointer(1, 4, GL_BYTE, GL_TRUE, sizeof(VoxelVertex),
+                               reinterpret_cast<void*>(offsetof(VoxelVertex, normal)));
+
+    glad_glEnableVertexAttribArray(2);
+    glad_glVertexAttribIPointer(2, 1, GL_UNSIGNED_SHORT, sizeof(VoxelVertex),
+                                reinterpret_cast<void*>(offsetof(VoxelVertex, layer)));
+
+    glad_glEnableVertexAttribArray(3);
+    glad_glVertexAttribPointer(3, 1, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(VoxelVertex),
+                               reinterpret_cast<void*>(offsetof(VoxelVertex, sunlight)));
+
+    glad_glEnableVertexAttribArray(4);
+    glad_glVertexAttribPointer(4, 1, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(VoxelVertex),
+                               reinterpret_cast<void*>(offsetof(VoxelVertex, emissive)));
+
+    glad_glBindVertexArray(0);
+    glad_glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+MeshArena::Handle MeshArena::Upload(Handle handle, const voxel::VoxelVertex* vertices, std::size_t vertexCount,
+                                    const std::uint32_t* indices, std::size_t indexCount) {
+    MC_ASSERT_MAIN_THREAD_GL();
+    if (handle == kInvalidHandle) {
+        if (!freeSlots_.empty()) {
+            handle = freeSlots_.back();
+            freeSlots_.pop_back();
+        } else {
+            handle = static_cast<Handle>(slots_.size());
+            slots_.emplace_back();
+        }
+        slots_[handle] = Slot{};
+    }
+    MC_ASSERT(handle < slots_.size(), "MeshArena::Upload with unknown handle.");
+
+    Slot& slot = slots_[handle];
+    const bool fits = slot.live && vertexCount <= slot.vertices.size && indexCount <= slot.indices.size;
+    if (fits && slot.lastUseFrame <= completedFrame_) {
+        ++inPlaceUpdates_;
+    } else {
+        if (slot.live) {
+            Retire(slot);
+            ++reallocatedUpdates_;
+        }
+        if (!AllocateRanges(slot, vertexCount, indexCount)) {
+            std::size_t vertexCapacity = std::max<std::size_t>(vertexAllocator_.Capacity(), kAllocationGranule);
+            std::size_t indexCapacity = std::max<std::size_t>(indexAllocator_.Capacity(), kAllocationGranule);
+            while (vertexCapacity < vertexAllocator_.Used() + WithSlack(vertexCount)) {
+                vertexCapacity *= 2;
+            }
+            while (indexCapacity < indexAllocator_.Used() + WithSlack(indexCount)) {
+                indexCapacity *= 2;
+            }
+            if (vertexCapacity == vertexAllocator_.Capacity()) {
+                vertexCapacity *= 2;
+            }
+            if (indexCapacity == indexAllocator_.Capacity()) {
+                indexCapacity *= 2;
+            }
+            Relocate(vertexCapacity, indexCapacity);
+            ++grows_;
+            const bool allocated = AllocateRanges(slot, vertexCount, indexCount);
+            MC_ASSERT(allocated, "MeshArena grow did not make room for upload.");
+            (void)allocated;
+        }
+        slot.live = true;
+        ++liveMeshes_;
+    }
+
+    if (vertexCount > 0) {
+        std::memcpy(static_cast<std::byte*>(vertexBuffer_.mapped) + slot.vertices.offset * kVertexBytes, vertices,
+                    vertexCount * kVertexBytes);
+    }
+    if (indexCount > 0) {
+        std::memcpy(static_cast<std::byte*>(indexBuffer_.mapped) + slot.indices.offset * kIndexBytes, indices,
+                    indexCount * kIndexBytes);
+    }
+    slot.vertexCount = vertexCount;
+    slot.indexCount = indexCount;
+    return handle;
+}
+
+void MeshArena::Free(Handle handle) {
+    if (handle == kInvalidHandle) {
+        return;
+    }
+    MC_ASSERT(handle < slots_.size(), "MeshArena::Free with unknown handle.");
+    Slot& slot = slots_[handle];
+    if (slot.live) {
+        Retire(slot);
+    }
+    slot = Slot{};
+    freeSlots_.push_back(handle);
+}
+
+bool MeshArena::AllocateRanges(Slot& slot, std::size_t vertexCount, std::size_t indexCount) {
+    const auto vertexRange = vertexAllocator_.Allocate(WithSlack(vertexCount));
+    if (!vertexRange) {
+        return false;
+    }
+    const auto indexRange = indexAllocator_.Allocate(WithSlack(indexCount));
+    if (!indexRange) {
+        vertexAllocator_.Free(*vertexRange);
+        return false;
+    }
+    slot.vertices = *vertexRange;
+    slot.indices = *indexRange;
+    slot.lastUseFrame = 0;
+    return true;
+}
+
+void MeshArena::Retire(Slot& slot) {
+    if (slot.lastUseFrame <= completedFrame_) {
+        vertexAllocator_.Free(slot.vertices);
+        indexAllocator_.Free(slot.indices);
+    } else {
+        retired_.push_back({slot.vertices, slot.indices, slot.lastUseFrame});
+    }
+    slot.vertices = {};
+    slot.indices = {};
+    slot.vertexCount = 0;
+    slot.indexCount = 0;
+    slot.live = false;
+    --liveMeshes_;
+}
+
+void MeshArena::BeginBatch() {
+    MC_ASSERT(!batching_, "MeshArena::BeginBatch called twice.");
+    batch_.clear();
+    batchIndices_ = 0;
+    batching_ = true;
+}
+
+void MeshArena::Queue(Handle handle, std::uint32_t firstIndex, std::uint32_t indexCount) {
+    MC_ASSERT(batching_, "MeshArena::Queue requires BeginBatch().");
+    if (handle == kInvalidHandle || indexCount == 0) {
+        return;
+    }
+    Slot& slot = slots_[handle];
+    if (!slot.live) {
+        return;
+    }
+    MC_ASSERT(static_cast<std::size_t>(firstIndex) + indexCount <= slot.indexCount, "MeshArena::Queue past mesh end.");
+    MC_ASSERT(indexCount % 3 == 0, "Chunk mesh index count must be a multiple of 3.");
+    slot.lastUseFrame = currentFrame_;
+    DrawElementsIndirectCommand command;
+    command.count = indexCount;
+    command.instanceCount = 1;
+    command.firstIndex = static_cast<std::uint32_t>(slot.indices.offset) + firstIndex;
+    command.baseVertex = static_cast<std::int32_t>(slot.vertices.offset);
+    batch_.push_back(command);
+    batchIndices_ += indexCount;
+}
+
+std::size_t MeshArena::SubmitBatch() {
+    MC_ASSERT_MAIN_THREAD_GL();
+    MC_ASSERT(batching_, "MeshArena::SubmitBatch requires BeginBatch().");
+    batching_ = false;
+    lastBatchCommands_ = batch_.size();
+    lastBatchTriangles_ = batchIndices_ / 3;
+    batchIndices_ = 0;
+    if (batch_.empty()) {
+        return 0;
+    }
+    if (indirectUsed_ + batch_.size() > indirectSegmentCommands_) {
+        std::size_t segmentCommands = std::max<std::size_t>(indirectSegmentCommands_ * 2, kIndirectSegmentCommands);
+        while (segmentCommands < batch_.size()) {
+            segmentCommands *= 2;
+        }
+        GrowIndirect(segmentCommands);
+    }
+
+    const std::size_t segment = static_cast<std::size_t>(currentFrame_ % kIndirectSegments);
+    const std::size_t byteOffset =
+        (segment * indirectSegmentCommands_ + indirectUsed_) * sizeof(DrawElementsIndirectCommand);
+    std::memcpy(static_cast<std::byte*>(indirectBuffer_.mapped) + byteOffset, batch_.data(),
+                batch_.size() * sizeof(DrawElementsIndirectCommand));
+    indirectUsed_ += batch_.size();
+
+    glad_glBindVertexArray(vao_);
+    glad_glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer_.id);
+    glad_glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, reinterpret_cast<void*>(byteOffset),
+                                     static_cast<GLsizei>(batch_.size()), 0);
+    glad_glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glad_glBindVertexArray(0);
+    batch_.clear();
+    return 1;
+}
+
+// One slice per frame that can be in flight, so a slice is only rewritten after its frame's fence.
+// Growing swaps in a fresh buffer; GL keeps the old one alive until pending draws finish with it.
+void MeshArena::GrowIndirect(std::size_t segmentCommands) {
+    DestroyBuffer(indirectBuffer_);
+    indirectBuffer_ = CreateBuffer(segmentCommands * kIndirectSegments * sizeof(DrawElementsIndirectCommand));
+    indirectSegmentCommands_ = segmentCommands;
+    indirectUsed_ = 0;
+}
+
+void MeshArena::PollFences(bool waitForOldest) {
+    while (!fences_.empty()) {
+        FrameFence& fence = fences_.front();
+        const GLenum status = waitForOldest
+                                  ? glad_glClientWaitSync(fence.sync, GL_SYNC_FLUSH_COMMANDS_BIT, kFenceWaitNs)
+                                  : glad_glClientWaitSync(fence.sync, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            break;
+        }
+        completedFrame_ = fence.frame;
+        glad_glDeleteSync(fence.sync);
+        fences_.pop_front();
+        waitForOldest = false;
+    }
+}
+
+void MeshArena::BeginFrame() {
+    MC_ASSERT_MAIN_THREAD_GL();
+    PollFences(false);
+    auto keep = retired_.begin();
+    for (auto it = retired_.begin(); it != retired_.end(); ++it) {
+        if (it->frame <= completedFrame_) {
+            vertexAllocator_.Free(it->vertices);
+            indexAllocator_.Free(it->indices);
+        } else {
+            *keep++ = *it;
+        }
+    }
+    retired_.erase(keep, retired_.end());
+
+    const core::RangeAllocatorStats vertexStats = vertexAllocator_.Stats();
+    if (vertexStats.fragmentation > kDefragFragmentation && vertexStats.freeBlocks > kDefragMinFreeBlocks &&
+        currentFrame_ - lastDefragFrame_ > kDefragMinFrames) {
+        Defragment();
+    }
+}
+
+void MeshArena::EndFrame() {
+    MC_ASSERT_MAIN_THREAD_GL();
+    GLsync sync = glad_glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (sync != nullptr) {
+        fences_.push_back({sync, currentFrame_});
+    }
+    ++currentFrame_;
+    indirectUsed_ = 0;
+    if (fences_.size() > kMaxFramesInFlight) {
+        PollFences(true);
+    }
+}
+
+void MeshArena::Defragment() {
+    MC_ASSERT_MAIN_THREAD_GL();
+    Relocate(vertexAllocator_.Capacity(), indexAllocator_.Capacity());
+    ++defragmentations_;
+}
+
+// Copies every live mesh into freshly allocated buffers, packed from offset 0. The GPU does the copy,
+// so moved slots count as used this frame and are not overwritten on the CPU until it completes.
+// Retired ranges belong to the old buffers and are simply dropped with them.
+void MeshArena::Relocate(std::size_t vertexCapacity, std::size_t indexCapacity) {
+    std::vector<Handle> order;
+    order.reserve(liveMeshes_);
+    for (Handle handle = 0; handle < slots_.size(); ++handle) {
+        if (slots_[handle].live) {
+            order.push_back(handle);
+        }
+    }
+    std::sort(order.begin(), order.end(), [this](Handle a, Handle b) {
+        return slots_[a].vertices.offset < slots_[b].vertices.offset;
+    });
+
+    Buffer newVertices = CreateBuffer(vertexCapacity * kVertexBytes);
+    Buffer newIndices = CreateBuffer(indexCapacity * kIndexBytes);
+    vertexAllocator_.Reset(vertexCapacity);
+    indexAllocator_.Reset(indexCapacity);
+
+    std::vector<CopyRun> vertexRuns;
+    std::vector<CopyRun> indexRuns;
+    for (Handle handle : order) {
+        Slot& slot = slots_[handle];
+        const auto vertexRange = vertexAllocator_.Allocate(slot.vertices.size);
+        const auto indexRange = indexAllocator_.Allocate(slot.indices.size);
+        MC_ASSERT(vertexRange && indexRange, "MeshArena relocation target too small.");
+        AppendRun(vertexRuns, slot.vertices.offset * kVertexBytes, vertexRange->offset * kVertexBytes,
+                  slot.vertexCount * kVertexBytes);
+        AppendRun(indexRuns, slot.indices.offset * kIndexBytes, indexRange->offset * kIndexBytes,
+                  slot.indexCount * kIndexBytes);
+        slot.vertices = *vertexRange;
+        slot.indices = *indexRange;
+        slot.lastUseFrame = currentFrame_;
+    }
+    CopyRuns(vertexBuffer_.id, newVertices.id, vertexRuns);
+    CopyRuns(indexBuffer_.id, newIndices.id, indexRuns);
+    retired_.clear();
+
+    DestroyBuffer(vertexBuffer_);
+    DestroyBuffer(indexBuffer_);
+    vertexBuffer_ = newVertices;
+    indexBuffer_ = newIndices;
+    ConfigureVao();
+    lastDefragFrame_ = currentFrame_;
+}
+
+MeshArenaStats MeshArena::Stats() const {
+    const core::RangeAllocatorStats vertexStats = vertexAllocator_.Stats();
+    const core::RangeAllocatorStats indexStats = indexAllocator_.Stats();
+    MeshArenaStats stats;
+    stats.vertexBytesUsed = vertexStats.used * kVertexBytes;
+    stats.vertexBytesCapacity = vertexStats.capacity * kVertexBytes;
+    stats.indexBytesUsed = indexStats.used * kIndexBytes;
+    stats.indexBytesCapacity = indexStats.capacity * kIndexBytes;
+    for (const Retired& retired : retired_) {
+        stats.retiredBytes += retired.vertices.size * kVertexBytes + retired.indices.size * kIndexBytes;
+    }
+    stats.liveMeshes = liveMeshes_;
+    stats.freeBlocks = vertexStats.freeBlocks + indexStats.freeBlocks;
+    stats.vertexFragmentation = vertexStats.fragmentation;
+    stats.indexFragmentation = indexStats.fragmentation;
+    stats.inPlaceUpdates = inPlaceUpdates_;
+    stats.reallocatedUpdates = reallocatedUpdates_;
+    stats.defragmentations = defragmentations_;
+    stats.grows = grows_;
+    stats.lastBatchCommands = lastBatchCommands_;
+    stats.lastBatchTriangles = lastBatchTriangles_;
+    return stats;
+}
+
+std::string DescribeArena(const MeshArenaStats& stats) {
+    constexpr double kBytesPerMiB = 1024.0 * 1024.0;
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << "[Arena] meshes " << stats.liveMeshes << " vtx "
+        << static_cast<double>(stats.vertexBytesUsed) / kBytesPerMiB << '/'
+        << static_cast<double>(stats.vertexBytesCapacity) / kBytesPerMiB << "MiB idx "
+        << static_cast<double>(stats.indexBytesUsed) / kBytesPerMiB << '/'
+        << static_cast<double>(stats.indexBytesCapacity) / kBytesPerMiB << "MiB retired "
+        << static_cast<double>(stats.retiredBytes) / kBytesPerMiB << "MiB" << std::setprecision(2) << " frag "
+        << stats.vertexFragmentation << '/' << stats.indexFragmentation << " blocks " << stats.freeBlocks
+        << " | in-place " << stats.inPlaceUpdates << " realloc " << stats.reallocatedUpdates << " defrag "
+        << stats.defragmentations << " grow " << stats.grows << " | batch cmds " << stats.lastBatchCommands
+        << " tris " << stats.lastBatchTriangles;
+    return out.str();
+}
+
+} // namespace renderer
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "core/RangeAllocator.h"
+#include "voxel/ChunkMesh.h"
+
+namespace renderer {
+
+// Layout fixed by glMultiDrawElementsIndirect.
+struct DrawElementsIndirectCommand {
+    std::uint32_t count = 0;
+    std::uint32_t instanceCount = 0;
+    std::uint32_t firstIndex = 0;
+    std::int32_t baseVertex = 0;
+    std::uint32_t baseInstance = 0;
+};
+
+struct MeshArenaStats {
+    std::size_t vertexBytesUsed = 0;
+    std::size_t vertexBytesCapacity = 0;
+    std::size_t indexBytesUsed = 0;
+    std::size_t indexBytesCapacity = 0;
+    std::size_t retiredBytes = 0;
+    std::size_t liveMeshes = 0;
+    std::size_t freeBlocks = 0;
+    float vertexFragmentation = 0.0f;
+    float indexFragmentation = 0.0f;
+    std::uint64_t inPlaceUpdates = 0;
+    std::uint64_t reallocatedUpdates = 0;
+    std::uint64_t defragmentations = 0;
+    std::uint64_t grows = 0;
+    std::size_t lastBatchCommands = 0;
+    std::size_t lastBatchTriangles = 0;
+};
+
+// Shared vertex/index storage for every chunk mesh: two persistently mapped buffers behind one VAO,
+// sub-allocated per mesh and drawn in one glMultiDrawElementsIndirect per batch. Ranges freed or outgrown
+// while a frame that drew them may still be in flight are retired and only recycled once that frame's
+// fence has signalled. Main thread only.
+class MeshArena final : public voxel::MeshStore {
+public:
+    static constexpr std::size_t kDefaultVertexCapacity = 1u << 20;
+
+    explicit MeshArena(std::size_t vertexCapacity = kDefaultVertexCapacity);
+    ~MeshArena() override;
+
+    MeshArena(const MeshArena&) = delete;
+    MeshArena& operator=(const MeshArena&) = delete;
+
+    // Writes a mesh and returns its handle. Pass the previous handle on remesh: the old range is
+    // overwritten in place when the mesh still fits and the GPU is done reading it.
+    Handle Upload(Handle handle, const voxel::VoxelVertex* vertices, std::size_t vertexCount,
+                  const std::uint32_t* indices, std::size_t indexCount) override;
+    void Free(Handle handle) override;
+
+    // Meshes queued between BeginBatch and SubmitBatch are drawn with a single multi-draw; the
+    // command array lives in a per-frame slice of a persistently mapped indirect buffer.
+    // SubmitBatch returns the number of GL draw calls issued (0 or 1).
+    void BeginBatch();
+    // Queues indexCount indices starting at firstIndex within the mesh (not the arena).
+    void Queue(Handle handle, std::uint32_t firstIndex, std::uint32_t indexCount) override;
+    std::size_t SubmitBatch();
+
+    // Frame bracketing: BeginFrame recycles retired ranges whose fences signalled (and defragments
+    // when free space has splintered); EndFrame fences the frame's draws.
+    void BeginFrame();
+    void EndFrame();
+
+    void Defragment();
+    MeshArenaStats Stats() const;
+
+private:
+    struct Slot {
+        core::Range vertices;
+        core::Range indices;
+        std::size_t vertexCount = 0;
+        std::size_t indexCount = 0;
+        std::uint64_t lastUseFrame = 0;
+        bool live = false;
+    };
+
+    struct Retired {
+        core::Range vertices;
+        core::Range indices;
+        std::uint64_t frame = 0;
+    };
+
+    struct FrameFence {
+        GLsync sync = nullptr;
+        std::uint64_t frame = 0;
+    };
+
+    struct Buffer {
+        GLuint id = 0;
+        void* mapped = nullptr;
+    };
+
+    static Buffer CreateBuffer(std::size_t bytes);
+    static void DestroyBuffer(Buffer& buffer);
+
+    void ConfigureVao();
+    bool AllocateRanges(Slot& slot, std::size_t vertexCount, std::size_t indexCount);
+    void Retire(Slot& slot);
+    void Relocate(std::size_t vertexCapacity, std::size_t indexCapacity);
+    void PollFences(bool waitForOldest);
+    void GrowIndirect(std::size_t segmentCommands);
+
+    GLuint vao_ = 0;
+    Buffer vertexBuffer_;
+    Buffer indexBuffer_;
+    Buffer indirectBuffer_;
+    std::size_t indirectSegmentCommands_ = 0;
+    std::size_t indirectUsed_ = 0;
+    std::vector<DrawElementsIndirectCommand> batch_;
+    std::size_t batchIndices_ = 0;
+    std::size_t lastBatchCommands_ = 0;
+    std::size_t lastBatchTriangles_ = 0;
+    core::RangeAllocator vertexAllocator_;
+    core::RangeAllocator indexAllocator_;
+    std::vector<Slot> slots_;
+    std::vector<Handle> freeSlots_;
+    std::vector<Retired> retired_;
+    std::deque<FrameFence> fences_;
+    std::uint64_t currentFrame_ = 1;
+    std::uint64_t completedFrame_ = 0;
+    std::uint64_t lastDefragFrame_ = 0;
+    std::size_t liveMeshes_ = 0;
+    bool batching_ = false;
+    std::uint64_t inPlaceUpdates_ = 0;
+    std::uint64_t reallocatedUpdates_ = 0;
+    std::uint64_t defragmentations_ = 0;
+    std::uint64_t grows_ = 0;
+};
+
+std::string DescribeArena(const MeshArenaStats& stats);
+
+} // namespace renderer
@@ -20,11 +20,16 @@
 
 #include "Shader.h"
 #include "core/Sha256.h"
+#include "renderer/BlockTextures.h"
+#include "renderer/MeshArena.h"
 #include "voxel/BlockId.h"
+#include "voxel/BlockRegistry.h"
 #include "voxel/Chunk.h"
+#include "voxel/ChunkBounds.h"
 #include "voxel/ChunkMesh.h"
 #include "voxel/ChunkMesher.h"
 #include "voxel/ChunkRegistry.h"
+#include "voxel/WorldGen.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -37,176 +42,7 @@ namespace {
 
 constexpr float kFov = 60.0f;
 constexpr glm::vec3 kClearColor(0.08f, 0.10f, 0.15f);
-
-GLuint CreateTextureFromPixels(int width, int height, const std::vector<std::uint8_t>& pixels) {
-    if (width <= 0 || height <= 0 || pixels.empty()) {
-        return 0;
-    }
-
-    GLuint texture = 0;
-    glad_glGenTextures(1, &texture);
-    glad_glBindTexture(GL_TEXTURE_2D, texture);
-    glad_glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
-    glad_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glad_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glad_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glad_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    return texture;
-}
-
-struct TexturePixels {
-    int width = 0;
-    int height = 0;
-    std::vector<std::uint8_t> pixels;
-    bool IsValid() const { return width > 0 && height > 0 && !pixels.empty(); }
-};
-
-std::vector<std::uint8_t> BuildProceduralDirtPixels(int width, int height) {
-    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u);
-    std::uint32_t state = 0x1234abcd;
-    auto nextRandom = [&state]() {
-        state = state * 1664525u + 1013904223u;
-        return state;
-    };
-
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            const std::uint32_t noiseSeed =
-                nextRandom() + static_cast<std::uint32_t>(x * 374761393u) + static_cast<std::uint32_t>(y * 668265263u);
-            const int noise = static_cast<int>((noiseSeed >> 24) & 0xFF) % 37 - 18;
-            int r = 110 + noise + static_cast<int>((noiseSeed >> 16) & 0xF) - 7;
-            int g = 80 + noise;
-            int b = 50 + noise + static_cast<int>((noiseSeed >> 12) & 0x7) - 3;
-            if (((noiseSeed >> 8) & 0xFF) < 15) {
-                r += 20;
-                g += 20;
-                b += 20;
-            }
-            r = std::clamp(r, 0, 255);
-            g = std::clamp(g, 0, 255);
-            b = std::clamp(b, 0, 255);
-
-            const std::size_t index = (static_cast<std::size_t>(y) * static_cast<std::size_t>(width) +
-                                       static_cast<std::size_t>(x)) *
-                                      4u;
-            pixels[index + 0] = static_cast<std::uint8_t>(r);
-            pixels[index + 1] = static_cast<std::uint8_t>(g);
-            pixels[index + 2] = static_cast<std::uint8_t>(b);
-            pixels[index + 3] = 255;
-        }
-    }
-    return pixels;
-}
-
-std::vector<std::uint8_t> BuildProceduralStonePixels(int width, int height) {
-    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u);
-    std::uint32_t state = 0x7f4a7c15u;
-    auto nextRandom = [&state]() {
-        state = state * 1103515245u + 12345u;
-        return state;
-    };
-
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            const std::uint32_t noiseSeed =
-                nextRandom() + static_cast<std::uint32_t>(x * 2654435761u) + static_cast<std::uint32_t>(y * 1013904223u);
-            const int noise = static_cast<int>((noiseSeed >> 24) & 0xFF) % 25 - 12;
-            int shade = 130 + noise;
-            shade = std::clamp(shade, 80, 200);
-            const std::size_t index = (static_cast<std::size_t>(y) * static_cast<std::size_t>(width) +
-                                       static_cast<std::size_t>(x)) *
-                                      4u;
-            pixels[index + 0] = static_cast<std::uint8_t>(shade);
-            pixels[index + 1] = static_cast<std::uint8_t>(shade);
-            pixels[index + 2] = static_cast<std::uint8_t>(shade);
-            pixels[index + 3] = 255;
-        }
-    }
-    return pixels;
-}
-
-GLuint CreateProceduralDirtTexture(int width, int height) {
-    auto pixels = BuildProceduralDirtPixels(width, height);
-    return CreateTextureFromPixels(width, height, pixels);
-}
-
-TexturePixels LoadTexturePixels(const std::string& path) {
-    TexturePixels result;
-    int channels = 0;
-    stbi_uc* data = stbi_load(path.c_str(), &result.width, &result.height, &channels, 4);
-    if (!data) {
-        return result;
-    }
-    result.pixels.assign(data, data + (result.width * result.height * 4));
-    stbi_image_free(data);
-    return result;
-}
-
-GLuint LoadTexture2D(const std::string& path) {
-    int width = 0;
-    int height = 0;
-    int channels = 0;
-    stbi_uc* data = stbi_load(path.c_str(), &width, &height, &channels, 4);
-    if (!data) {
-        return 0;
-    }
-
-    std::vector<std::uint8_t> pixels(data, data + (width * height * 4));
-    stbi_image_free(data);
-    return CreateTextureFromPixels(width, height, pixels);
-}
-
-GLuint CreateBlockAtlasTexture() {
-    constexpr int kFallbackSize = 32;
-    TexturePixels dirt = LoadTexturePixels("textures/dirt.png");
-    if (!dirt.IsValid()) {
-        dirt.width = kFallbackSize;
-        dirt.height = kFallbackSize;
-        dirt.pixels = BuildProceduralDirtPixels(kFallbackSize, kFallbackSize);
-        std::cout << "[RenderTest] Using procedurally generated dirt texture.\n";
-    }
-
-    TexturePixels stone = LoadTexturePixels("textures/stone.png");
-    if (!stone.IsValid()) {
-        stone.width = kFallbackSize;
-        stone.height = kFallbackSize;
-        stone.pixels = BuildProceduralStonePixels(kFallbackSize, kFallbackSize);
-        std::cout << "[RenderTest] Using procedurally generated stone texture.\n";
-    }
-
-    if (dirt.width != stone.width || dirt.height != stone.height) {
-        std::cout << "[RenderTest] Mismatched block texture sizes, using procedural 32x32 atlas.\n";
-        dirt.width = kFallbackSize;
-        dirt.height = kFallbackSize;
-        dirt.pixels = BuildProceduralDirtPixels(kFallbackSize, kFallbackSize);
-        stone.width = kFallbackSize;
-        stone.height = kFallbackSize;
-        stone.pixels = BuildProceduralStonePixels(kFallbackSize, kFallbackSize);
-    }
-
-    const int atlasWidth = dirt.width * 2;
-    const int atlasHeight = dirt.height;
-    std::vector<std::uint8_t> atlas(static_cast<std::size_t>(atlasWidth) * atlasHeight * 4u);
-
-    auto blit = [&](const TexturePixels& src, int dstX) {
-        for (int y = 0; y < src.height; ++y) {
-            for (int x = 0; x < src.width; ++x) {
-                const std::size_t srcIndex =
-                    (static_cast<std::size_t>(y) * src.width + static_cast<std::size_t>(x)) * 4u;
-                const std::size_t dstIndex =
-                    (static_cast<std::size_t>(y) * atlasWidth + static_cast<std::size_t>(x + dstX)) * 4u;
-                atlas[dstIndex + 0] = src.pixels[srcIndex + 0];
-                atlas[dstIndex + 1] = src.pixels[srcIndex + 1];
-                atlas[dstIndex + 2] = src.pixels[srcIndex + 2];
-                atlas[dstIndex + 3] = src.pixels[srcIndex + 3];
-            }
-        }
-    };
-
-    blit(dirt, 0);
-    blit(stone, dirt.width);
-    return CreateTextureFromPixels(atlasWidth, atlasHeight, atlas);
-}
+constexpr std::size_t kRenderTestArenaVertices = 1u << 16;
 
 void glfwErrorCallback(int error, const char* description) {
     std::cerr << "[GLFW] Error " << error << ": " << description << '\n';
@@ -240,7 +76,7 @@ void EnsureEmptyChunk(voxel::ChunkRegistry& registry, const voxel::ChunkCoord& c
 }
 
 std::shared_ptr<voxel::ChunkEntry> BuildTestChunk(voxel::ChunkRegistry& registry, voxel::ChunkMesher& mesher,
-                                                  std::uint32_t seed, const voxel::ChunkCoord& coord,
+                                                  MeshArena& arena, std::uint32_t seed, const voxel::ChunkCoord& coord,
                                                   bool variant) {
     auto entry = registry.GetOrCreateEntry(coord);
     {
@@ -287,12 +123,14 @@ std::shared_ptr<voxel::ChunkEntry> BuildTestChunk(voxel::ChunkRegistry& registry
     EnsureEmptyChunk(registry, {coord.x, coord.y, coord.z + 1});
     EnsureEmptyChunk(registry, {coord.x, coord.y, coord.z - 1});
 
+    registry.EnsureLightForNeighborhood(coord);
     voxel::ChunkMeshCpu cpuMesh;
     mesher.BuildMesh(coord, *entry->chunk, registry, cpuMesh);
     entry->mesh.Clear();
     entry->mesh.Vertices() = std::move(cpuMesh.vertices);
     entry->mesh.Indices() = std::move(cpuMesh.indices);
-    entry->mesh.UploadToGpu();
+    entry->mesh.Faces() = cpuMesh.faces;
+    entry->mesh.UploadToGpu(arena);
     entry->gpuState.store(voxel::GpuState::Uploaded, std::memory_order_release);
     return entry;
 }
@@ -427,9 +265,9 @@ int RunRenderTest(const RenderTestOptions& options) {
     }
     std::cout << "[RenderTest] Shaders loaded.\n";
 
-    GLuint blockTexture = CreateBlockAtlasTexture();
+    GLuint blockTexture = CreateBlockTextureArray(voxel::BlockRegistry::Default());
     if (blockTexture == 0) {
-        std::cerr << "[RenderTest] Failed to create block atlas texture.\n";
+        std::cerr << "[RenderTest] Failed to create block texture array.\n";
         glfwDestroyWindow(window);
         glfwTerminate();
         return EXIT_FAILURE;
@@ -489,11 +327,14 @@ int RunRenderTest(const RenderTestOptions& options) {
     std::vector<RenderSceneResult> results;
     results.reserve(scenes.size());
     bool compareOk = true;
+    voxel::WorldGenConfig worldGenConfig;
+    worldGenConfig.seed = options.seed;
     for (const auto& scene : scenes) {
-        voxel::ChunkRegistry chunkRegistry;
+        MeshArena meshArena(kRenderTestArenaVertices);
+        voxel::ChunkRegistry chunkRegistry(worldGenConfig);
         voxel::ChunkMesher mesher;
         std::cout << "[RenderTest] Building test chunk...\n";
-        auto entry = BuildTestChunk(chunkRegistry, mesher, options.seed, scene.coord, scene.variant);
+        auto entry = BuildTestChunk(chunkRegistry, mesher, meshArena, options.seed, scene.coord, scene.variant);
         if (!entry) {
             std::cerr << "[RenderTest] Failed to build test chunk.\n";
             compareOk = false;
@@ -521,8 +362,11 @@ int RunRenderTest(const RenderTestOptions& options) {
             shader.setVec3("uLightDir", lightDir);
             shader.setInt("uTexture", 0);
             glad_glActiveTexture(GL_TEXTURE0);
-            glad_glBindTexture(GL_TEXTURE_2D, blockTexture);
-            entry->mesh.Draw();
+            glad_glBindTexture(GL_TEXTURE_2D_ARRAY, blockTexture);
+            meshArena.BeginBatch();
+            entry->mesh.QueueDraw(voxel::FacingDirectionMask(voxel::GetChunkBounds(scene.coord), scene.eye));
+            meshArena.SubmitBatch();
+            meshArena.EndFrame();
         }
         GLenum frameError = glad_glGetError();
         if (frameError != GL_NO_ERROR) {
@@ -2,7 +2,6 @@
 
 #include <array>
 
-#include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 
 #include "voxel/VoxelCoords.h"
@@ -13,7 +12,6 @@ struct BlockFace {
     WorldBlockCoord neighborOffset;
     glm::vec3 normal;
     std::array<glm::vec3, 4> vertices;
-    std::array<glm::vec2, 4> uvs;
 };
 
 inline const std::array<BlockFace, 6> kBlockFaces = {{
@@ -21,38 +19,32 @@ inline const std::array<BlockFace, 6> kBlockFaces = {{
     {{1, 0, 0},
      {1.0f, 0.0f, 0.0f},
      {glm::vec3{1.0f, 0.0f, 0.0f}, glm::vec3{1.0f, 1.0f, 0.0f},
-      glm::vec3{1.0f, 1.0f, 1.0f}, glm::vec3{1.0f, 0.0f, 1.0f}},
-     {glm::vec2{0.0f, 0.0f}, glm::vec2{0.0f, 1.0f}, glm::vec2{1.0f, 1.0f}, glm::vec2{1.0f, 0.0f}}},
+      glm::vec3{1.0f, 1.0f, 1.0f}, glm::vec3{1.0f, 0.0f, 1.0f}}},
     // -X
     {{-1, 0, 0},
      {-1.0f, 0.0f, 0.0f},
      {glm::vec3{0.0f, 0.0f, 0.0f}, glm::vec3{0.0f, 0.0f, 1.0f},
-      glm::vec3{0.0f, 1.0f, 1.0f}, glm::vec3{0.0f, 1.0f, 0.0f}},
-     {glm::vec2{0.0f, 0.0f}, glm::vec2{1.0f, 0.0f}, glm::vec2{1.0f, 1.0f}, glm::vec2{0.0f, 1.0f}}},
+      glm::vec3{0.0f, 1.0f, 1.0f}, glm::vec3{0.0f, 1.0f, 0.0f}}},
     // +Y
     {{0, 1, 0},
      {0.0f, 1.0f, 0.0f},
      {glm::vec3{0.0f, 1.0f, 0.0f}, glm::vec3{0.0f, 1.0f, 1.0f},
-      glm::vec3{1.0f, 1.0f, 1.0f}, glm::vec3{1.0f, 1.0f, 0.0f}},
-     {glm::vec2{0.0f, 0.0f}, glm::vec2{0.0f, 1.0f}, glm::vec2{1.0f, 1.0f}, glm::vec2{1.0f, 0.0f}}},
+      glm::vec3{1.0f, 1.0f, 1.0f}, glm::vec3{1.0f, 1.0f, 0.0f}}},
     // -Y
     {{0, -1, 0},
      {0.0f, -1.0f, 0.0f},
      {glm::vec3{0.0f, 0.0f, 0.0f}, glm::vec3{1.0f, 0.0f, 0.0f},
-      glm::vec3{1.0f, 0.0f, 1.0f}, glm::vec3{0.0f, 0.0f, 1.0f}},
-     {glm::vec2{0.0f, 0.0f}, glm::vec2{1.0f, 0.0f}, glm::vec2{1.0f, 1.0f}, glm::vec2{0.0f, 1.0f}}},
+      glm::vec3{1.0f, 0.0f, 1.0f}, glm::vec3{0.0f, 0.0f, 1.0f}}},
     // +Z
     {{0, 0, 1},
      {0.0f, 0.0f, 1.0f},
      {glm::vec3{0.0f, 0.0f, 1.0f}, glm::vec3{1.0f, 0.0f, 1.0f},
-      glm::vec3{1.0f, 1.0f, 1.0f}, glm::vec3{0.0f, 1.0f, 1.0f}},
-     {glm::vec2{0.0f, 0.0f}, glm::vec2{1.0f, 0.0f}, glm::vec2{1.0f, 1.0f}, glm::vec2{0.0f, 1.0f}}},
+      glm::vec3{1.0f, 1.0f, 1.0f}, glm::vec3{0.0f, 1.0f, 1.0f}}},
     // -Z
     {{0, 0, -1},
      {0.0f, 0.0f, -1.0f},
      {glm::vec3{0.0f, 0.0f, 0.0f}, glm::vec3{0.0f, 1.0f, 0.0f},
-      glm::vec3{1.0f, 1.0f, 0.0f}, glm::vec3{1.0f, 0.0f, 0.0f}},
-     {glm::vec2{0.0f, 0.0f}, glm::vec2{0.0f, 1.0f}, glm::vec2{1.0f, 1.0f}, glm::vec2{1.0f, 0.0f}}},
+      glm::vec3{1.0f, 1.0f, 0.0f}, glm::vec3{1.0f, 0.0f, 0.0f}}},
 }};
 
 } // namespace voxel
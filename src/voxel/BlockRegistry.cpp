@@ -0,0 +1,83 @@
+#include "voxel/BlockRegistry.h"
+
+#include <utility>
+
+#include "voxel/LightData.h"
+
+namespace voxel {
+
+namespace {
+
+struct BuiltinLayer {
+    const char* name;
+    std::array<std::uint8_t, 3> fallbackColor;
+};
+
+struct BuiltinBlock {
+    BlockId id;
+    const char* name;
+    const char* layer;
+    bool opaque;
+    bool solid;
+    std::uint8_t emissive;
+};
+
+constexpr BuiltinLayer kBuiltinLayers[] = {
+    {"dirt", {110, 80, 50}},
+    {"stone", {130, 130, 130}},
+    {"torch", {230, 180, 70}},
+    {"lava", {220, 90, 20}},
+};
+
+constexpr BuiltinBlock kBuiltinBlocks[] = {
+    {kBlockAir, "Air", "dirt", false, false, 0},
+    {kBlockStone, "Stone", "stone", true, true, 0},
+    {kBlockDirt, "Dirt", "dirt", true, true, 0},
+    {kBlockTorch, "Torch", "torch", false, true, 14},
+    {kBlockLava, "Lava", "lava", true, true, kLightMax},
+};
+
+} // namespace
+
+BlockRegistry::BlockRegistry() {
+    unknown_.name = "Unknown";
+}
+
+TextureLayer BlockRegistry::AddLayer(const std::string& name, const std::array<std::uint8_t, 3>& fallbackColor) {
+    for (std::size_t i = 0; i < layers_.size(); ++i) {
+        if (layers_[i].name == name) {
+            return static_cast<TextureLayer>(i);
+        }
+    }
+    layers_.push_back(TextureLayerDefinition{name, fallbackColor});
+    return static_cast<TextureLayer>(layers_.size() - 1);
+}
+
+void BlockRegistry::Register(BlockId id, BlockDefinition definition) {
+    if (id >= definitions_.size()) {
+        definitions_.resize(static_cast<std::size_t>(id) + 1, unknown_);
+    }
+    definitions_[id] = std::move(definition);
+}
+
+const BlockRegistry& BlockRegistry::Default() {
+    static const BlockRegistry registry = [] {
+        BlockRegistry blocks;
+        for (const BuiltinLayer& layer : kBuiltinLayers) {
+            blocks.AddLayer(layer.name, layer.fallbackColor);
+        }
+        for (const BuiltinBlock& block : kBuiltinBlocks) {
+            BlockDefinition definition;
+            definition.name = block.name;
+            definition.faceLayers = AllFaces(blocks.AddLayer(block.layer, {}));
+            definition.opaque = block.opaque;
+            definition.solid = block.solid;
+            definition.emissive = block.emissive;
+            blocks.Register(block.id, std::move(definition));
+        }
+        return blocks;
+    }();
+    return registry;
+}
+
+} // namespace voxel
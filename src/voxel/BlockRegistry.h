@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "voxel/BlockId.h"
+
+namespace voxel {
+
+// Layer of the block texture array.
+using TextureLayer = std::uint16_t;
+
+struct TextureLayerDefinition {
+    // Loaded from textures/<name>.png; layers without a file get procedural noise around fallbackColor.
+    std::string name;
+    std::array<std::uint8_t, 3> fallbackColor{};
+};
+
+struct BlockDefinition {
+    std::string name;
+    // Texture layer per face in kBlockFaces order (+X, -X, +Y, -Y, +Z, -Z).
+    std::array<TextureLayer, 6> faceLayers{};
+    bool opaque = true;        // blocks sunlight and emitted light
+    bool solid = true;         // collides with the player
+    std::uint8_t emissive = 0; // emitted light level, up to kLightMax
+};
+
+// Data-driven block table indexed by BlockId. Every lookup is a bounds check and an array index, so
+// meshing and lighting cost does not grow with the number of block types. Ids never registered read
+// as an opaque, solid "Unknown" block on layer 0.
+class BlockRegistry {
+public:
+    BlockRegistry();
+
+    // Returns the layer with this name, adding it if needed.
+    TextureLayer AddLayer(const std::string& name, const std::array<std::uint8_t, 3>& fallbackColor);
+    void Register(BlockId id, BlockDefinition definition);
+
+    const BlockDefinition& Get(BlockId id) const {
+        return id < definitions_.size() ? definitions_[id] : unknown_;
+    }
+    bool IsOpaque(BlockId id) const { return Get(id).opaque; }
+    bool IsSolid(BlockId id) const { return Get(id).solid; }
+    std::uint8_t Emissive(BlockId id) const { return Get(id).emissive; }
+    TextureLayer FaceLayer(BlockId id, std::size_t direction) const { return Get(id).faceLayers[direction]; }
+
+    std::size_t BlockCount() const { return definitions_.size(); }
+    const std::vector<TextureLayerDefinition>& Layers() const { return layers_; }
+
+    // Built-in blocks: air, stone, dirt, torch, lava.
+    static const BlockRegistry& Default();
+
+private:
+    std::vector<BlockDefinition> definitions_;
+    std::vector<TextureLayerDefinition> layers_;
+    BlockDefinition unknown_;
+};
+
+inline std::array<TextureLayer, 6> AllFaces(TextureLayer layer) {
+    return {layer, layer, layer, layer, layer, layer};
+}
+
+} // namespace voxel
@@ -8,6 +8,8 @@ Chunk::Chunk() {
     Fill(kBlockAir);
 }
 
+Chunk::Chunk(UninitializedTag) {}
+
 BlockId Chunk::Get(int lx, int ly, int lz) const {
 #ifndef NDEBUG
     assert(lx >= 0 && lx < kChunkSize);
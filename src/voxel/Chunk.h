@@ -12,7 +12,12 @@ constexpr int kChunkVolume = kChunkSize * kChunkSize * kChunkSize;
 
 class Chunk {
 public:
+    struct UninitializedTag {};
+    static constexpr UninitializedTag kUninitialized{};
+
     Chunk();
+    // Leaves block storage unset; callers must overwrite every voxel (generation or storage load).
+    explicit Chunk(UninitializedTag);
 
     BlockId Get(int lx, int ly, int lz) const;
     void Set(int lx, int ly, int lz, BlockId id);
@@ -27,7 +32,9 @@ private:
         return static_cast<std::size_t>(lx + kChunkSize * (ly + kChunkSize * lz));
     }
 
-    std::array<BlockId, kChunkVolume> blocks_{};
+    // No default initializer: pooled chunks come back from Acquire() holding the previous chunk's
+    // blocks, so callers must overwrite every voxel (generate, load or Fill) before use.
+    std::array<BlockId, kChunkVolume> blocks_;
 };
 
 } // namespace voxel
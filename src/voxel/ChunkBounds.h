@@ -2,6 +2,7 @@
 #define MINECLONE_VOXEL_CHUNK_BOUNDS_H
 
 #include <cassert>
+#include <cstdint>
 
 #include <glm/glm.hpp>
 
@@ -24,6 +25,19 @@ inline ChunkBounds GetChunkBounds(const ChunkCoord& coord) {
     return bounds;
 }
 
+// Bit i is set when faces with the direction of kBlockFaces[i] inside the chunk can face the eye.
+// Conservative: a direction is only dropped when the eye is behind every such face plane.
+inline std::uint8_t FacingDirectionMask(const ChunkBounds& bounds, const glm::vec3& eye) {
+    unsigned mask = 0;
+    mask |= eye.x > bounds.min.x ? 0x01u : 0u;
+    mask |= eye.x < bounds.max.x ? 0x02u : 0u;
+    mask |= eye.y > bounds.min.y ? 0x04u : 0u;
+    mask |= eye.y < bounds.max.y ? 0x08u : 0u;
+    mask |= eye.z > bounds.min.z ? 0x10u : 0u;
+    mask |= eye.z < bounds.max.z ? 0x20u : 0u;
+    return static_cast<std::uint8_t>(mask);
+}
+
 } // namespace voxel
 
 #endif
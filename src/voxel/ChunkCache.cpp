@@ -0,0 +1,60 @@
+#include "voxel/ChunkCache.h"
+
+#include <utility>
+
+namespace voxel {
+
+ChunkCache::ChunkCache(const ChunkCacheConfig& config) : config_(config) {}
+
+bool ChunkCache::Insert(const ChunkCoord& coord, std::shared_ptr<ChunkEntry> entry, std::size_t bytes,
+                        std::vector<std::shared_ptr<ChunkEntry>>& evicted) {
+    if (bytes > config_.memoryCapBytes) {
+        return false;
+    }
+    if (auto it = slots_.find(coord); it != slots_.end()) {
+        stats_.bytes -= it->second->bytes;
+        evicted.push_back(std::move(it->second->entry));
+        lru_.erase(it->second);
+        slots_.erase(it);
+    }
+    while (!lru_.empty() && stats_.bytes + bytes > config_.memoryCapBytes) {
+        Slot& oldest = lru_.back();
+        stats_.bytes -= oldest.bytes;
+        evicted.push_back(std::move(oldest.entry));
+        slots_.erase(oldest.coord);
+        lru_.pop_back();
+        ++stats_.evictions;
+    }
+    lru_.push_front(Slot{coord, std::move(entry), bytes});
+    slots_[coord] = lru_.begin();
+    stats_.bytes += bytes;
+    stats_.chunks = lru_.size();
+    return true;
+}
+
+std::shared_ptr<ChunkEntry> ChunkCache::Take(const ChunkCoord& coord) {
+    auto it = slots_.find(coord);
+    if (it == slots_.end()) {
+        ++stats_.misses;
+        return nullptr;
+    }
+    ++stats_.hits;
+    std::shared_ptr<ChunkEntry> entry = std::move(it->second->entry);
+    stats_.bytes -= it->second->bytes;
+    lru_.erase(it->second);
+    slots_.erase(it);
+    stats_.chunks = lru_.size();
+    return entry;
+}
+
+void ChunkCache::Clear(std::vector<std::shared_ptr<ChunkEntry>>& evicted) {
+    for (Slot& slot : lru_) {
+        evicted.push_back(std::move(slot.entry));
+    }
+    lru_.clear();
+    slots_.clear();
+    stats_.bytes = 0;
+    stats_.chunks = 0;
+}
+
+} // namespace voxel
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "voxel/ChunkCoord.h"
+
+namespace voxel {
+
+struct ChunkEntry;
+
+struct ChunkCacheConfig {
+    // Estimated bytes of unloaded chunks kept for re-entry; 0 disables the cache.
+    std::size_t memoryCapBytes = 64u * 1024u * 1024u;
+    // Also keep the uploaded mesh in the mesh store, so a re-entered chunk needs no meshing or upload.
+    // Off keeps block data and light only and meshes again on re-entry.
+    bool keepMeshes = true;
+};
+
+struct ChunkCacheStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+    std::size_t chunks = 0;
+    std::size_t bytes = 0;
+
+    double HitRate() const {
+        const std::uint64_t lookups = hits + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+};
+
+// LRU of chunk entries detached from the registry when they left the streamed region. Holding the entry
+// keeps its block data, light and (optionally) GPU mesh as they were, so taking it back is a map insert.
+// Main thread only; entries pushed out by the cap are handed back for ChunkRegistry::ReleaseEntry.
+class ChunkCache {
+public:
+    explicit ChunkCache(const ChunkCacheConfig& config = {});
+
+    const ChunkCacheConfig& Config() const { return config_; }
+
+    // Returns false (and keeps nothing) when the entry alone is over the cap.
+    bool Insert(const ChunkCoord& coord, std::shared_ptr<ChunkEntry> entry, std::size_t bytes,
+                std::vector<std::shared_ptr<ChunkEntry>>& evicted);
+    // Removes and returns the cached entry for coord, counting a hit or a miss.
+    std::shared_ptr<ChunkEntry> Take(const ChunkCoord& coord);
+    void Clear(std::vector<std::shared_ptr<ChunkEntry>>& evicted);
+
+    const ChunkCacheStats& Stats() const { return stats_; }
+
+private:
+    struct Slot {
+        ChunkCoord coord;
+        std::shared_ptr<ChunkEntry> entry;
+        std::size_t bytes = 0;
+    };
+
+    ChunkCacheConfig config_;
+    ChunkCacheStats stats_;
+    // Most recently inserted first.
+    std::list<Slot> lru_;
+    std::unordered_map<ChunkCoord, std::list<Slot>::iterator, ChunkCoordHash> slots_;
+};
+
+} // namespace voxel
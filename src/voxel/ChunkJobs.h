@@ -1,9 +1,11 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <vector>
 
+#include "voxel/BlockId.h"
 #include "voxel/ChunkCoord.h"
 #include "voxel/ChunkMesh.h"
 
@@ -15,6 +17,12 @@ struct ChunkMeshCpu {
     void Clear() {
         vertices.clear();
         indices.clear();
+        faces = {};
+        visibility = {};
+        lod = 0;
+        for (auto& quads : quadScratch) {
+            quads.clear();
+        }
     }
 
     void Reserve(std::size_t vertexCount, std::size_t indexCount) {
@@ -24,22 +32,45 @@ struct ChunkMeshCpu {
 
     std::vector<VoxelVertex> vertices;
     std::vector<std::uint32_t> indices;
+    FaceRanges faces{};
+    // First vertex of each quad, bucketed by face direction while meshing; pooled with the mesh.
+    std::array<std::vector<std::uint32_t>, kFaceDirectionCount> quadScratch;
+    ChunkVisibility visibility;
+    std::vector<std::uint16_t> floodScratch;
+    int lod = 0;
+    // Downsampled cell grid for LOD meshes.
+    std::vector<BlockId> lodCells;
 };
 
+// traceFlow links a chunk's jobs into one arrow in exported traces; 0 records no flow.
 struct GenerateJob {
     ChunkCoord coord;
     std::weak_ptr<ChunkEntry> entry;
+    std::uint64_t traceFlow = 0;
+};
+
+// core::SteadyNowNs() milestones of one mesh job, carried with the mesh so overlapping remeshes of a
+// chunk each report their own times. litNs stays 0 for LOD meshes, which skip lighting.
+struct MeshTiming {
+    std::int64_t queuedNs = 0;
+    std::int64_t startNs = 0;
+    std::int64_t litNs = 0;
+    std::int64_t meshedNs = 0;
 };
 
 struct MeshJob {
     ChunkCoord coord;
     std::weak_ptr<ChunkEntry> entry;
+    std::uint64_t traceFlow = 0;
+    std::int64_t queuedNs = 0;
 };
 
 struct MeshReady {
     ChunkCoord coord;
     std::weak_ptr<ChunkEntry> entry;
-    std::shared_ptr<ChunkMeshCpu> cpuMesh;
+    std::unique_ptr<ChunkMeshCpu> cpuMesh;
+    std::uint64_t traceFlow = 0;
+    MeshTiming timing;
 };
 
 } // namespace voxel
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "voxel/Chunk.h"
+
+namespace voxel {
+
+// LOD n meshes cells of 2^n voxels per edge: full detail, then 2x, 4x and 8x downsampled.
+constexpr int kLodLevelCount = 4;
+
+constexpr int LodCellSize(int lod) {
+    return 1 << lod;
+}
+
+static_assert(kChunkSize % LodCellSize(kLodLevelCount - 1) == 0, "Chunk size must divide into the coarsest LOD.");
+
+struct ChunkLodConfig {
+    // Largest Chebyshev chunk distance (XZ) meshed at LOD 0, 1 and 2; anything farther uses LOD 3.
+    std::array<int, kLodLevelCount - 1> maxDistance{5, 7, 9};
+    // Extra chunks a mesh must move past a ring boundary before it switches to the coarser LOD.
+    int hysteresis = 1;
+};
+
+inline int LodForDistance(int distance, const ChunkLodConfig& config) {
+    int lod = 0;
+    while (lod < kLodLevelCount - 1 && distance > config.maxDistance[static_cast<std::size_t>(lod)]) {
+        ++lod;
+    }
+    return lod;
+}
+
+// Switching to a finer LOD happens as soon as the ring is entered; coarsening waits until the chunk
+// is hysteresis chunks past the boundary so a player on a ring edge does not make meshes flip.
+inline int SelectLod(int distance, int currentLod, const ChunkLodConfig& config) {
+    const int target = LodForDistance(distance, config);
+    if (target <= currentLod) {
+        return target;
+    }
+    int lod = currentLod;
+    while (lod < kLodLevelCount - 1 &&
+           distance > config.maxDistance[static_cast<std::size_t>(lod)] + config.hysteresis) {
+        ++lod;
+    }
+    return lod;
+}
+
+} // namespace voxel
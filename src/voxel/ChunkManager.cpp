@@ -1,7 +1,5 @@
 #include "voxel/ChunkManager.h"
 
-#include "voxel/WorldGen.h"
-
 namespace voxel {
 
 Chunk& ChunkManager::GetOrCreateChunk(const ChunkCoord& coord) {
@@ -30,7 +28,7 @@ BlockId ChunkManager::GetBlock(const WorldBlockCoord& world) const {
     LocalCoord local = WorldToLocalCoord(world, kChunkSize);
     const Chunk* chunk = TryGetChunk(chunkCoord);
     if (!chunk) {
-        return SampleFlatWorld(world);
+        return generator_.SampleBlock(world);
     }
     return chunk->Get(local.x, local.y, local.z);
 }
@@ -58,7 +56,7 @@ void ChunkManager::GenerateChunk(const ChunkCoord& coord, Chunk& chunk) {
             for (int x = 0; x < kChunkSize; ++x) {
                 LocalCoord local{x, y, z};
                 WorldBlockCoord world = ChunkLocalToWorld(coord, local, kChunkSize);
-                chunk.Set(x, y, z, SampleFlatWorld(world));
+                chunk.Set(x, y, z, generator_.SampleBlock(world));
             }
         }
     }
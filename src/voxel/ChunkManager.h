@@ -6,6 +6,7 @@
 #include "voxel/Chunk.h"
 #include "voxel/ChunkCoord.h"
 #include "voxel/VoxelCoords.h"
+#include "voxel/WorldGen.h"
 
 namespace voxel {
 
@@ -22,6 +23,7 @@ private:
     void GenerateChunk(const ChunkCoord& coord, Chunk& chunk);
 
     std::unordered_map<ChunkCoord, Chunk, ChunkCoordHash> chunks_;
+    WorldGenerator generator_;
 };
 
 } // namespace voxel
@@ -1,27 +1,21 @@
-#include <glad/glad.h>
-
 #include "voxel/ChunkMesh.h"
 
 #include "core/Assert.h"
-
-#ifndef GL_ELEMENT_ARRAY_BUFFER
-#define GL_ELEMENT_ARRAY_BUFFER 0x8893
-#endif
-#ifndef GL_UNSIGNED_INT
-#define GL_UNSIGNED_INT 0x1405
-#endif
+#include "core/MemoryLedger.h"
 
 namespace voxel {
 
 void ChunkMesh::Clear() {
     vertices_.clear();
     indices_.clear();
+    faces_ = {};
     gpuIndexCount_ = 0;
 }
 
 void ChunkMesh::ClearCpu() {
     vertices_.clear();
     indices_.clear();
+    faces_ = {};
 }
 
 void ChunkMesh::Reserve(std::size_t vertexCount, std::size_t indexCount) {
@@ -37,6 +31,10 @@ std::vector<std::uint32_t>& ChunkMesh::Indices() {
     return indices_;
 }
 
+FaceRanges& ChunkMesh::Faces() {
+    return faces_;
+}
+
 const std::vector<VoxelVertex>& ChunkMesh::Vertices() const {
     return vertices_;
 }
@@ -45,6 +43,10 @@ const std::vector<std::uint32_t>& ChunkMesh::Indices() const {
     return indices_;
 }
 
+const FaceRanges& ChunkMesh::Faces() const {
+    return faces_;
+}
+
 std::size_t ChunkMesh::VertexCount() const {
     return vertices_.size();
 }
@@ -57,79 +59,74 @@ std::size_t ChunkMesh::GpuIndexCount() const {
     return gpuIndexCount_;
 }
 
-void ChunkMesh::UploadToGpu() {
-    MC_ASSERT_MAIN_THREAD_GL();
-    if (vao_ == 0) {
-        glad_glGenVertexArrays(1, &vao_);
-    }
-    if (vbo_ == 0) {
-        glad_glGenBuffers(1, &vbo_);
-    }
-    if (ebo_ == 0) {
-        glad_glGenBuffers(1, &ebo_);
-    }
-
-    glad_glBindVertexArray(vao_);
-
-    glad_glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-    glad_glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices_.size() * sizeof(VoxelVertex)),
-                      vertices_.data(), GL_STATIC_DRAW);
+std::size_t ChunkMesh::GpuBytes() const {
+    return gpuBytes_;
+}
 
-    glad_glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
-    glad_glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices_.size() * sizeof(std::uint32_t)),
-                      indices_.data(), GL_STATIC_DRAW);
+void ChunkMesh::UploadToGpu(MeshStore& store) {
+    MC_ASSERT_MAIN_THREAD_GL();
+    MC_ASSERT(store_ == nullptr || store_ == &store, "Chunk mesh moved between mesh stores.");
+    store_ = &store;
+    handle_ = store.Upload(handle_, vertices_.data(), vertices_.size(), indices_.data(), indices_.size());
     gpuIndexCount_ = indices_.size();
-
-    glad_glEnableVertexAttribArray(0);
-    glad_glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(VoxelVertex),
-                               reinterpret_cast<void*>(offsetof(VoxelVertex, position)));
-
-    glad_glEnableVertexAttribArray(1);
-    glad_glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(VoxelVertex),
-                               reinterpret_cast<void*>(offsetof(VoxelVertex, normal)));
-
-    glad_glEnableVertexAttribArray(2);
-    glad_glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(VoxelVertex),
-                               reinterpret_cast<void*>(offsetof(VoxelVertex, uv)));
-
-    glad_glEnableVertexAttribArray(3);
-    glad_glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(VoxelVertex),
-                               reinterpret_cast<void*>(offsetof(VoxelVertex, sunlight)));
-
-    glad_glEnableVertexAttribArray(4);
-    glad_glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(VoxelVertex),
-                               reinterpret_cast<void*>(offsetof(VoxelVertex, emissive)));
-
-    glad_glBindVertexArray(0);
+    gpuFaces_ = faces_;
+    core::MemoryLedger& ledger = core::MemoryLedger::Global();
+    ledger.Remove(core::MemoryCategory::GpuMesh, gpuBytes_);
+    gpuBytes_ = vertices_.size() * sizeof(VoxelVertex) + indices_.size() * sizeof(std::uint32_t);
+    ledger.Add(core::MemoryCategory::GpuMesh, gpuBytes_);
 }
 
 void ChunkMesh::DestroyGpu() {
     MC_ASSERT_MAIN_THREAD_GL();
-    if (ebo_ != 0) {
-        glad_glDeleteBuffers(1, &ebo_);
-        ebo_ = 0;
-    }
-    if (vbo_ != 0) {
-        glad_glDeleteBuffers(1, &vbo_);
-        vbo_ = 0;
-    }
-    if (vao_ != 0) {
-        glad_glDeleteVertexArrays(1, &vao_);
-        vao_ = 0;
+    if (store_ != nullptr) {
+        store_->Free(handle_);
     }
+    store_ = nullptr;
+    handle_ = MeshStore::kInvalidHandle;
     gpuIndexCount_ = 0;
+    gpuFaces_ = {};
+    core::MemoryLedger::Global().Remove(core::MemoryCategory::GpuMesh, gpuBytes_);
+    gpuBytes_ = 0;
 }
 
-void ChunkMesh::Draw() const {
-    MC_ASSERT_MAIN_THREAD_GL();
-    if (gpuIndexCount_ == 0 || vao_ == 0) {
+void ChunkMesh::QueueDraw(std::uint8_t directionMask) const {
+    if (gpuIndexCount_ == 0 || store_ == nullptr) {
         return;
     }
+    FaceRange pending;
+    for (std::size_t direction = 0; direction < kFaceDirectionCount; ++direction) {
+        const FaceRange& range = gpuFaces_[direction];
+        if ((directionMask & (1u << direction)) == 0 || range.indexCount == 0) {
+            continue;
+        }
+        if (pending.indexCount > 0 && pending.firstIndex + pending.indexCount == range.firstIndex) {
+            pending.indexCount += range.indexCount;
+            continue;
+        }
+        if (pending.indexCount > 0) {
+            store_->Queue(handle_, pending.firstIndex, pending.indexCount);
+        }
+        pending = range;
+    }
+    if (pending.indexCount > 0) {
+        store_->Queue(handle_, pending.firstIndex, pending.indexCount);
+    }
+}
+
+const ChunkVisibility& ChunkMesh::Visibility() const {
+    return visibility_;
+}
+
+void ChunkMesh::SetVisibility(const ChunkVisibility& visibility) {
+    visibility_ = visibility;
+}
+
+int ChunkMesh::Lod() const {
+    return lod_;
+}
 
-    MC_ASSERT(gpuIndexCount_ % 3 == 0, "Chunk mesh index count must be a multiple of 3.");
-    glad_glBindVertexArray(vao_);
-    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(gpuIndexCount_), GL_UNSIGNED_INT, nullptr);
-    glad_glBindVertexArray(0);
+void ChunkMesh::SetLod(int lod) {
+    lod_ = lod;
 }
 
 } // namespace voxel
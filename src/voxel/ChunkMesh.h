@@ -1,23 +1,72 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <vector>
 
-#include <glad/glad.h>
-#include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 
+#include "voxel/BlockRegistry.h"
+#include "voxel/ChunkVisibility.h"
+
 namespace voxel {
 
+// 20 bytes. Texture coordinates are derived from the position in the vertex shader, so a vertex only
+// names its texture array layer; normal and light are normalized bytes.
 struct VoxelVertex {
     glm::vec3 position;
-    glm::vec3 normal;
-    glm::vec2 uv;
-    float sunlight = 0.0f;
-    float emissive = 0.0f;
+    std::array<std::int8_t, 4> normal{};
+    TextureLayer layer = 0;
+    std::uint8_t sunlight = 0;
+    std::uint8_t emissive = 0;
+};
+
+static_assert(sizeof(VoxelVertex) == 20, "VoxelVertex layout is fixed by the mesh arena's vertex attributes.");
+
+inline std::uint8_t PackUnit(float value) {
+    const float clamped = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+    return static_cast<std::uint8_t>(clamped * 255.0f + 0.5f);
+}
+
+inline std::array<std::int8_t, 4> PackNormal(const glm::vec3& normal) {
+    auto pack = [](float value) {
+        const float clamped = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+        return static_cast<std::int8_t>(clamped * 127.0f + (clamped < 0.0f ? -0.5f : 0.5f));
+    };
+    return {pack(normal.x), pack(normal.y), pack(normal.z), 0};
+}
+
+// Indices are grouped by face direction in kBlockFaces order (+X, -X, +Y, -Y, +Z, -Z) so whole
+// directions can be skipped when they face away from the camera.
+constexpr std::size_t kFaceDirectionCount = 6;
+constexpr std::uint8_t kAllFaceDirections = (1u << kFaceDirectionCount) - 1u;
+
+struct FaceRange {
+    std::uint32_t firstIndex = 0;
+    std::uint32_t indexCount = 0;
 };
 
+using FaceRanges = std::array<FaceRange, kFaceDirectionCount>;
+
+// GPU home of chunk meshes, implemented by renderer::MeshArena. Meshes only talk to this interface, so
+// the CPU side (meshing, streaming, registry) builds and links without GL.
+class MeshStore {
+public:
+    using Handle = std::uint32_t;
+    static constexpr Handle kInvalidHandle = 0xFFFFFFFFu;
+
+    virtual ~MeshStore() = default;
+
+    // Writes a mesh and returns its handle; pass the previous handle on remesh.
+    virtual Handle Upload(Handle handle, const VoxelVertex* vertices, std::size_t vertexCount,
+                          const std::uint32_t* indices, std::size_t indexCount) = 0;
+    virtual void Free(Handle handle) = 0;
+    // Adds an index range of the mesh to the open draw batch.
+    virtual void Queue(Handle handle, std::uint32_t firstIndex, std::uint32_t indexCount) = 0;
+};
+
+// CPU vertices and indices plus the handle of their uploaded copy in a MeshStore.
 class ChunkMesh {
 public:
     void Clear();
@@ -26,24 +75,44 @@ public:
 
     std::vector<VoxelVertex>& Vertices();
     std::vector<std::uint32_t>& Indices();
+    FaceRanges& Faces();
     const std::vector<VoxelVertex>& Vertices() const;
     const std::vector<std::uint32_t>& Indices() const;
+    const FaceRanges& Faces() const;
 
     std::size_t VertexCount() const;
     std::size_t IndexCount() const;
     std::size_t GpuIndexCount() const;
+    // Vertex and index bytes of the uploaded copy, as reported to the MemoryLedger.
+    std::size_t GpuBytes() const;
 
-    void UploadToGpu();
+    // GPU storage is a sub-allocation of the shared store; remeshing reuses the same handle so the
+    // store can overwrite the old range in place. QueueDraw() adds the face directions set in
+    // directionMask to the store's open batch, merging directions whose index ranges are adjacent.
+    void UploadToGpu(MeshStore& store);
     void DestroyGpu();
-    void Draw() const;
+    void QueueDraw(std::uint8_t directionMask = kAllFaceDirections) const;
+
+    // Face connectivity of the chunk as of the last uploaded mesh; open until one is set.
+    const ChunkVisibility& Visibility() const;
+    void SetVisibility(const ChunkVisibility& visibility);
+
+    // LOD the current mesh was built at (see ChunkLod.h).
+    int Lod() const;
+    void SetLod(int lod);
 
 private:
     std::vector<VoxelVertex> vertices_;
     std::vector<std::uint32_t> indices_;
-    GLuint vao_ = 0;
-    GLuint vbo_ = 0;
-    GLuint ebo_ = 0;
+    FaceRanges faces_{};
+    FaceRanges gpuFaces_{};
+    ChunkVisibility visibility_ = ChunkVisibility::Open();
+    int lod_ = 0;
+    MeshStore* store_ = nullptr;
+    MeshStore::Handle handle_ = MeshStore::kInvalidHandle;
     std::size_t gpuIndexCount_ = 0;
+    // Reported to the memory ledger as GpuMesh while the upload is live.
+    std::size_t gpuBytes_ = 0;
 };
 
 } // namespace voxel
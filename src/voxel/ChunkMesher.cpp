@@ -1,10 +1,14 @@
 #include "voxel/ChunkMesher.h"
 
+#include <array>
 #include <cassert>
+#include <optional>
 #include <shared_mutex>
 #include <vector>
 
 #include "voxel/BlockFaces.h"
+#include "voxel/BlockRegistry.h"
+#include "voxel/ChunkVisibility.h"
 #include "voxel/LightData.h"
 #include "voxel/WorldGen.h"
 
@@ -12,20 +16,6 @@ namespace voxel {
 
 namespace {
 
-constexpr float kAtlasTileWidth = 0.5f;
-
-float AtlasOffsetForBlock(BlockId id) {
-    if (id == kBlockStone) {
-        return kAtlasTileWidth;
-    }
-    return 0.0f;
-}
-
-glm::vec2 AtlasUv(BlockId id, const glm::vec2& uv) {
-    const float offset = AtlasOffsetForBlock(id);
-    return glm::vec2{uv.x * kAtlasTileWidth + offset, uv.y};
-}
-
 struct LightReadHandle {
     std::shared_ptr<const ChunkEntry> entry;
     std::shared_lock<std::shared_mutex> lock;
@@ -42,10 +32,41 @@ LightReadHandle AcquireLightRead(const ChunkCoord& coord, const ChunkRegistry& r
     }
     handle.entry = entry;
     handle.lock = std::shared_lock<std::shared_mutex>(entry->dataMutex);
-    handle.light = &entry->light;
+    handle.light = entry->light.get();
     return handle;
 }
 
+// Border faces are culled only against a neighbour meshed at the same LOD. Across a ring boundary the
+// two sides quantize the surface differently, so both keep their border faces and the seam stays closed.
+const Chunk* CullingNeighbor(const std::optional<ChunkReadHandle>& neighbor, int lod) {
+    if (!neighbor || neighbor->entry->lod.load(std::memory_order_acquire) != lod) {
+        return nullptr;
+    }
+    return neighbor->chunk;
+}
+
+// Indices are appended direction by direction so each direction is one contiguous FaceRange.
+void EmitFaceIndices(ChunkMeshCpu& mesh) {
+    auto& indices = mesh.indices;
+    for (std::size_t direction = 0; direction < kFaceDirectionCount; ++direction) {
+        FaceRange& range = mesh.faces[direction];
+        range.firstIndex = static_cast<std::uint32_t>(indices.size());
+        for (const std::uint32_t baseIndex : mesh.quadScratch[direction]) {
+            indices.push_back(baseIndex + 0);
+            indices.push_back(baseIndex + 1);
+            indices.push_back(baseIndex + 2);
+            indices.push_back(baseIndex + 0);
+            indices.push_back(baseIndex + 2);
+            indices.push_back(baseIndex + 3);
+        }
+        range.indexCount = static_cast<std::uint32_t>(indices.size()) - range.firstIndex;
+    }
+
+#ifndef NDEBUG
+    assert(indices.empty() || indices.back() < mesh.vertices.size());
+#endif
+}
+
 } // namespace
 
 void ChunkMesher::BuildMesh(const ChunkCoord& coord, const Chunk& chunk, ChunkRegistry& registry,
@@ -56,7 +77,7 @@ void ChunkMesher::BuildMesh(const ChunkCoord& coord, const Chunk& chunk, ChunkRe
     mesh.Reserve(estimatedFaces * 4, estimatedFaces * 6);
 
     auto& vertices = mesh.vertices;
-    auto& indices = mesh.indices;
+    const BlockRegistry& blocks = BlockRegistry::Default();
 
     auto neighborPosX = registry.AcquireChunkRead({coord.x + 1, coord.y, coord.z});
     auto neighborNegX = registry.AcquireChunkRead({coord.x - 1, coord.y, coord.z});
@@ -64,13 +85,17 @@ void ChunkMesher::BuildMesh(const ChunkCoord& coord, const Chunk& chunk, ChunkRe
     auto neighborNegY = registry.AcquireChunkRead({coord.x, coord.y - 1, coord.z});
     auto neighborPosZ = registry.AcquireChunkRead({coord.x, coord.y, coord.z + 1});
     auto neighborNegZ = registry.AcquireChunkRead({coord.x, coord.y, coord.z - 1});
-
-    registry.EnsureLightForNeighborhood(coord);
+    const Chunk* cullPosX = CullingNeighbor(neighborPosX, 0);
+    const Chunk* cullNegX = CullingNeighbor(neighborNegX, 0);
+    const Chunk* cullPosY = CullingNeighbor(neighborPosY, 0);
+    const Chunk* cullNegY = CullingNeighbor(neighborNegY, 0);
+    const Chunk* cullPosZ = CullingNeighbor(neighborPosZ, 0);
+    const Chunk* cullNegZ = CullingNeighbor(neighborNegZ, 0);
 
     auto lightEntry = registry.TryGetEntry(coord);
     const LightChunk* currentLight = nullptr;
     if (lightEntry && lightEntry->lightReady.load(std::memory_order_acquire)) {
-        currentLight = &lightEntry->light;
+        currentLight = lightEntry->light.get();
     }
 
     LightReadHandle lightPosX = AcquireLightRead({coord.x + 1, coord.y, coord.z}, registry);
@@ -91,22 +116,22 @@ void ChunkMesher::BuildMesh(const ChunkCoord& coord, const Chunk& chunk, ChunkRe
             return kBlockAir;
         }
         if (nx < 0) {
-            return neighborNegX ? neighborNegX->chunk->Get(nx + kChunkSize, ny, nz) : kBlockAir;
+            return cullNegX ? cullNegX->Get(nx + kChunkSize, ny, nz) : kBlockAir;
         }
         if (nx >= kChunkSize) {
-            return neighborPosX ? neighborPosX->chunk->Get(nx - kChunkSize, ny, nz) : kBlockAir;
+            return cullPosX ? cullPosX->Get(nx - kChunkSize, ny, nz) : kBlockAir;
         }
         if (ny < 0) {
-            return neighborNegY ? neighborNegY->chunk->Get(nx, ny + kChunkSize, nz) : kBlockAir;
+            return cullNegY ? cullNegY->Get(nx, ny + kChunkSize, nz) : kBlockAir;
         }
         if (ny >= kChunkSize) {
-            return neighborPosY ? neighborPosY->chunk->Get(nx, ny - kChunkSize, nz) : kBlockAir;
+            return cullPosY ? cullPosY->Get(nx, ny - kChunkSize, nz) : kBlockAir;
         }
         if (nz < 0) {
-            return neighborNegZ ? neighborNegZ->chunk->Get(nx, ny, nz + kChunkSize) : kBlockAir;
+            return cullNegZ ? cullNegZ->Get(nx, ny, nz + kChunkSize) : kBlockAir;
         }
         if (nz >= kChunkSize) {
-            return neighborPosZ ? neighborPosZ->chunk->Get(nx, ny, nz - kChunkSize) : kBlockAir;
+            return cullPosZ ? cullPosZ->Get(nx, ny, nz - kChunkSize) : kBlockAir;
         }
         return kBlockAir;
     };
@@ -164,7 +189,8 @@ void ChunkMesher::BuildMesh(const ChunkCoord& coord, const Chunk& chunk, ChunkRe
                 LocalCoord local{x, y, z};
                 WorldBlockCoord world = ChunkLocalToWorld(coord, local, kChunkSize);
 
-                for (const BlockFace& face : kBlockFaces) {
+                for (std::size_t direction = 0; direction < kBlockFaces.size(); ++direction) {
+                    const BlockFace& face = kBlockFaces[direction];
                     const int nx = x + face.neighborOffset.x;
                     const int ny = y + face.neighborOffset.y;
                     const int nz = z + face.neighborOffset.z;
@@ -174,6 +200,8 @@ void ChunkMesher::BuildMesh(const ChunkCoord& coord, const Chunk& chunk, ChunkRe
                     }
 
                     std::uint32_t baseIndex = static_cast<std::uint32_t>(vertices.size());
+                    const auto normal = PackNormal(face.normal);
+                    const TextureLayer layer = blocks.FaceLayer(block, direction);
                     for (std::size_t i = 0; i < face.vertices.size(); ++i) {
                         const glm::vec3& vertex = face.vertices[i];
                         const int sampleX =
@@ -188,23 +216,127 @@ void ChunkMesher::BuildMesh(const ChunkCoord& coord, const Chunk& chunk, ChunkRe
                                                 static_cast<float>(world.x) + vertex.x,
                                                 static_cast<float>(world.y) + vertex.y,
                                                 static_cast<float>(world.z) + vertex.z},
-                                            face.normal,
-                                            AtlasUv(block, face.uvs[i]),
-                                            vertexSunlight,
-                                            vertexEmissive});
+                                            normal,
+                                            layer,
+                                            PackUnit(vertexSunlight),
+                                            PackUnit(vertexEmissive)});
                     }
 
-                    indices.push_back(baseIndex + 0);
-                    indices.push_back(baseIndex + 1);
-                    indices.push_back(baseIndex + 2);
-                    indices.push_back(baseIndex + 0);
-                    indices.push_back(baseIndex + 2);
-                    indices.push_back(baseIndex + 3);
+                    mesh.quadScratch[direction].push_back(baseIndex);
+                }
+            }
+        }
+    }
 
-#ifndef NDEBUG
-                    assert(indices.back() < vertices.size());
-#endif
+    EmitFaceIndices(mesh);
+    mesh.visibility = ComputeChunkVisibility(chunk, mesh.floodScratch);
+}
+
+void ChunkMesher::BuildLodMesh(const ChunkCoord& coord, const Chunk& chunk, int lod, ChunkRegistry& registry,
+                               ChunkMeshCpu& mesh) const {
+    assert(lod > 0 && lod < kLodLevelCount);
+    mesh.Clear();
+    mesh.lod = lod;
+
+    const int cellSize = LodCellSize(lod);
+    const int cells = kChunkSize / cellSize;
+    DownsampleChunk(chunk, cellSize, mesh.lodCells);
+
+    const std::array<std::optional<ChunkReadHandle>, kFaceDirectionCount> neighbors = {
+        registry.AcquireChunkRead({coord.x + 1, coord.y, coord.z}),
+        registry.AcquireChunkRead({coord.x - 1, coord.y, coord.z}),
+        registry.AcquireChunkRead({coord.x, coord.y + 1, coord.z}),
+        registry.AcquireChunkRead({coord.x, coord.y - 1, coord.z}),
+        registry.AcquireChunkRead({coord.x, coord.y, coord.z + 1}),
+        registry.AcquireChunkRead({coord.x, coord.y, coord.z - 1}),
+    };
+
+    // Cells across a chunk border are downsampled from a neighbour at the same LOD; a missing neighbour
+    // or one at another LOD counts as air, as in the full-detail mesher.
+    auto neighborCellSolid = [&](std::size_t direction, int cx, int cy, int cz) -> bool {
+        const Chunk* neighbor = CullingNeighbor(neighbors[direction], lod);
+        if (!neighbor) {
+            return false;
+        }
+        const auto wrap = [cells](int value) { return (value + cells) % cells; };
+        return DownsampleCell(*neighbor, wrap(cx), wrap(cy), wrap(cz), cellSize) != kBlockAir;
+    };
+
+    auto& vertices = mesh.vertices;
+    const BlockRegistry& blocks = BlockRegistry::Default();
+    const glm::vec3 origin = glm::vec3(coord.x, coord.y, coord.z) * static_cast<float>(kChunkSize);
+    const float scale = static_cast<float>(cellSize);
+    for (int cz = 0; cz < cells; ++cz) {
+        for (int cy = 0; cy < cells; ++cy) {
+            for (int cx = 0; cx < cells; ++cx) {
+                const BlockId block = mesh.lodCells[static_cast<std::size_t>(cx + cells * (cy + cells * cz))];
+                if (block == kBlockAir) {
+                    continue;
                 }
+                for (std::size_t direction = 0; direction < kBlockFaces.size(); ++direction) {
+                    const BlockFace& face = kBlockFaces[direction];
+                    const int nx = cx + face.neighborOffset.x;
+                    const int ny = cy + face.neighborOffset.y;
+                    const int nz = cz + face.neighborOffset.z;
+                    const bool inside = nx >= 0 && nx < cells && ny >= 0 && ny < cells && nz >= 0 && nz < cells;
+                    const bool covered =
+                        inside ? mesh.lodCells[static_cast<std::size_t>(nx + cells * (ny + cells * nz))] != kBlockAir
+                               : neighborCellSolid(direction, nx, ny, nz);
+                    if (covered) {
+                        continue;
+                    }
+
+                    // No light volume at LOD: far terrain is shaded as fully sky-lit.
+                    const std::uint32_t baseIndex = static_cast<std::uint32_t>(vertices.size());
+                    const glm::vec3 cellOrigin = origin + glm::vec3(cx, cy, cz) * scale;
+                    const auto normal = PackNormal(face.normal);
+                    const TextureLayer layer = blocks.FaceLayer(block, direction);
+                    for (std::size_t i = 0; i < face.vertices.size(); ++i) {
+                        vertices.push_back({cellOrigin + face.vertices[i] * scale, normal, layer, PackUnit(1.0f), 0});
+                    }
+                    mesh.quadScratch[direction].push_back(baseIndex);
+                }
+            }
+        }
+    }
+
+    EmitFaceIndices(mesh);
+    mesh.visibility = ComputeChunkVisibility(chunk, mesh.floodScratch);
+}
+
+BlockId DownsampleCell(const Chunk& chunk, int cellX, int cellY, int cellZ, int cellSize) {
+    const int x0 = cellX * cellSize;
+    const int y0 = cellY * cellSize;
+    const int z0 = cellZ * cellSize;
+    int solid = 0;
+    BlockId top = kBlockAir;
+    int topY = -1;
+    for (int y = y0 + cellSize - 1; y >= y0; --y) {
+        for (int z = z0; z < z0 + cellSize; ++z) {
+            for (int x = x0; x < x0 + cellSize; ++x) {
+                const BlockId block = chunk.Get(x, y, z);
+                if (block == kBlockAir) {
+                    continue;
+                }
+                ++solid;
+                if (y > topY) {
+                    topY = y;
+                    top = block;
+                }
+            }
+        }
+    }
+    return solid * 2 >= cellSize * cellSize * cellSize ? top : kBlockAir;
+}
+
+void DownsampleChunk(const Chunk& chunk, int cellSize, std::vector<BlockId>& cells) {
+    const int count = kChunkSize / cellSize;
+    cells.resize(static_cast<std::size_t>(count * count * count));
+    for (int cz = 0; cz < count; ++cz) {
+        for (int cy = 0; cy < count; ++cy) {
+            for (int cx = 0; cx < count; ++cx) {
+                cells[static_cast<std::size_t>(cx + count * (cy + count * cz))] =
+                    DownsampleCell(chunk, cx, cy, cz, cellSize);
             }
         }
     }
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <vector>
+
 #include "voxel/Chunk.h"
 #include "voxel/ChunkCoord.h"
+#include "voxel/ChunkLod.h"
 #include "voxel/ChunkJobs.h"
 #include "voxel/ChunkRegistry.h"
 
@@ -9,8 +12,19 @@ namespace voxel {
 
 class ChunkMesher {
 public:
+    // Reads light only; call ChunkRegistry::EnsureLightForNeighborhood first, before taking any chunk locks.
     void BuildMesh(const ChunkCoord& coord, const Chunk& chunk, ChunkRegistry& registry,
                    ChunkMeshCpu& mesh) const;
+
+    // Meshes cells of LodCellSize(lod) voxels (lod >= 1). Reads neighbour blocks but no light, so
+    // callers skip EnsureLightForNeighborhood for far chunks.
+    void BuildLodMesh(const ChunkCoord& coord, const Chunk& chunk, int lod, ChunkRegistry& registry,
+                      ChunkMeshCpu& mesh) const;
 };
 
+// A cell is solid when at least half of its voxels are; it takes the block of its highest solid
+// voxel so surface blocks stay on top.
+BlockId DownsampleCell(const Chunk& chunk, int cellX, int cellY, int cellZ, int cellSize);
+void DownsampleChunk(const Chunk& chunk, int cellSize, std::vector<BlockId>& cells);
+
 } // namespace voxel
@@ -0,0 +1,40 @@
+#include "voxel/ChunkPools.h"
+
+#include <iomanip>
+#include <sstream>
+
+namespace voxel {
+
+namespace {
+
+void AppendPool(std::ostringstream& out, const char* label, const core::PoolStats& stats) {
+    constexpr double kBytesPerMiB = 1024.0 * 1024.0;
+    out << ' ' << label << " hit " << stats.hits << " miss " << stats.misses << " live " << stats.inUse
+        << " free " << stats.freeCount << " peak " << std::fixed << std::setprecision(1)
+        << static_cast<double>(stats.peakBytes) / kBytesPerMiB << "MiB";
+}
+
+} // namespace
+
+void TrackBuiltMesh(const ChunkMeshCpu& mesh) {
+    core::MemoryLedger::Global().Add(core::MemoryCategory::CpuMesh, MeshScratchFootprint(mesh));
+}
+
+void RecycleMeshScratch(ChunkPools& pools, std::unique_ptr<ChunkMeshCpu> mesh) {
+    if (!mesh) {
+        return;
+    }
+    core::MemoryLedger::Global().Remove(core::MemoryCategory::CpuMesh, MeshScratchFootprint(*mesh));
+    pools.meshScratch.Release(std::move(mesh));
+}
+
+std::string DescribePools(const ChunkPools& pools) {
+    std::ostringstream out;
+    out << "[Pools]";
+    AppendPool(out, "chunk", pools.chunks.Stats());
+    AppendPool(out, "| light", pools.lights.Stats());
+    AppendPool(out, "| mesh", pools.meshScratch.Stats());
+    return out.str();
+}
+
+} // namespace voxel
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "core/ObjectPool.h"
+#include "voxel/Chunk.h"
+#include "voxel/ChunkJobs.h"
+#include "voxel/LightData.h"
+
+namespace voxel {
+
+inline std::unique_ptr<Chunk> CreateUninitializedChunk() {
+    return std::make_unique<Chunk>(Chunk::kUninitialized);
+}
+
+inline std::size_t MeshScratchFootprint(const ChunkMeshCpu& mesh) {
+    std::size_t bytes = sizeof(ChunkMeshCpu) + mesh.vertices.capacity() * sizeof(VoxelVertex) +
+                        mesh.indices.capacity() * sizeof(std::uint32_t);
+    for (const auto& quads : mesh.quadScratch) {
+        bytes += quads.capacity() * sizeof(std::uint32_t);
+    }
+    return bytes + mesh.floodScratch.capacity() * sizeof(std::uint16_t) + mesh.lodCells.capacity() * sizeof(BlockId);
+}
+
+struct ChunkPools {
+    static constexpr std::size_t kMaxFreeChunks = 256;
+    static constexpr std::size_t kMaxFreeLights = 256;
+    static constexpr std::size_t kMaxFreeMeshScratch = 16;
+
+    // Acquired chunks have unspecified contents (fresh or recycled); fill every voxel before use.
+    core::ObjectPool<Chunk> chunks{kMaxFreeChunks, nullptr, &CreateUninitializedChunk,
+                                   core::MemoryCategory::BlockData};
+    core::ObjectPool<LightChunk> lights{kMaxFreeLights, nullptr, nullptr, core::MemoryCategory::Light};
+    // Scratch grows while meshing, so its live bytes are reported as CpuMesh once a mesh is built.
+    core::ObjectPool<ChunkMeshCpu> meshScratch{kMaxFreeMeshScratch, &MeshScratchFootprint};
+};
+
+// A built mesh counts as CpuMesh in the memory ledger from TrackBuiltMesh() until RecycleMeshScratch()
+// returns its scratch to the pool; its vector capacities must not change in between.
+void TrackBuiltMesh(const ChunkMeshCpu& mesh);
+void RecycleMeshScratch(ChunkPools& pools, std::unique_ptr<ChunkMeshCpu> mesh);
+
+std::string DescribePools(const ChunkPools& pools);
+
+} // namespace voxel
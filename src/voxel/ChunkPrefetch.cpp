@@ -0,0 +1,61 @@
+#include "voxel/ChunkPrefetch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include <glm/glm.hpp>
+
+#include "voxel/Chunk.h"
+
+namespace voxel {
+
+std::size_t PrefetchPlan::ExtraChunks(int loadRadius, std::size_t layers) const {
+    const std::size_t side = static_cast<std::size_t>(loadRadius) * 2 + 1;
+    const std::size_t grownX = side + static_cast<std::size_t>(std::abs(aheadX));
+    const std::size_t grownZ = side + static_cast<std::size_t>(std::abs(aheadZ));
+    return (grownX * grownZ - side * side) * layers;
+}
+
+bool PrefetchPlan::NearPath(const ChunkCoord& center, const ChunkCoord& coord, int radius) const {
+    const int steps = std::max(std::abs(aheadX), std::abs(aheadZ));
+    for (int i = 0; i <= steps; ++i) {
+        const float t = steps == 0 ? 0.0f : static_cast<float>(i) / static_cast<float>(steps);
+        const int x = center.x + static_cast<int>(std::lround(static_cast<float>(aheadX) * t));
+        const int z = center.z + static_cast<int>(std::lround(static_cast<float>(aheadZ) * t));
+        if (std::max(std::abs(coord.x - x), std::abs(coord.z - z)) <= radius) {
+            return true;
+        }
+    }
+    return false;
+}
+
+PrefetchPlan PlanPrefetch(const ChunkPrefetchConfig& config, const StreamingMotion& motion, int loadRadius,
+                          std::size_t layers, std::size_t bytesPerChunk) {
+    PrefetchPlan plan;
+    const glm::vec3 velocity{motion.velocity.x, 0.0f, motion.velocity.z};
+    const float speed = glm::length(velocity);
+    if (!config.enabled || speed < config.minSpeed || speed <= 0.0f) {
+        return plan;
+    }
+
+    glm::vec3 heading = velocity / speed;
+    const glm::vec3 forward{motion.forward.x, 0.0f, motion.forward.z};
+    const float forwardLength = glm::length(forward);
+    // Looking backwards while moving says nothing about where the player goes next.
+    if (forwardLength > 0.0f && glm::dot(forward / forwardLength, heading) > 0.0f) {
+        heading = glm::normalize(heading + (forward / forwardLength) * config.viewWeight);
+    }
+    const glm::vec3 lead = heading * (speed * config.lookaheadSeconds / static_cast<float>(kChunkSize));
+    plan.aheadX = static_cast<int>(std::lround(lead.x));
+    plan.aheadZ = static_cast<int>(std::lround(lead.z));
+
+    const std::size_t chunkBytes = std::max<std::size_t>(bytesPerChunk, 1);
+    while (plan.Active() && plan.ExtraChunks(loadRadius, layers) * chunkBytes > config.memoryCapBytes) {
+        int& longer = std::abs(plan.aheadX) >= std::abs(plan.aheadZ) ? plan.aheadX : plan.aheadZ;
+        longer -= longer > 0 ? 1 : -1;
+    }
+    return plan;
+}
+
+} // namespace voxel
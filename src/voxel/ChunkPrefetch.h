@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+
+#include <glm/vec3.hpp>
+
+#include "voxel/ChunkCoord.h"
+
+namespace voxel {
+
+struct ChunkPrefetchConfig {
+    // Off keeps the desired region centred on the player (deterministic test runs).
+    bool enabled = true;
+    // How far ahead the player's motion is extrapolated.
+    float lookaheadSeconds = 2.0f;
+    // Below this speed (blocks per second) the load radius margin already covers the next chunks.
+    float minSpeed = 8.0f;
+    // Pull of the camera direction on the predicted heading; 0 follows the velocity alone.
+    float viewWeight = 0.25f;
+    // Chunks loaded ahead of the region may add at most this many bytes.
+    std::size_t memoryCapBytes = 64u * 1024u * 1024u;
+};
+
+struct StreamingMotion {
+    // Blocks per second.
+    glm::vec3 velocity{0.0f};
+    glm::vec3 forward{0.0f, 0.0f, -1.0f};
+};
+
+// Where the player is expected after lookaheadSeconds, in whole chunks on the XZ plane. The desired
+// region grows by |ahead| toward the sign of each axis, and chunks within the render radius of the path
+// to it are streamed before the rest of the pending list.
+struct PrefetchPlan {
+    int aheadX = 0;
+    int aheadZ = 0;
+
+    bool Active() const { return aheadX != 0 || aheadZ != 0; }
+    // Chunks the grown region adds to a (2 * loadRadius + 1)^2 x layers box.
+    std::size_t ExtraChunks(int loadRadius, std::size_t layers) const;
+    // Chebyshev XZ distance from coord to the path from center to center + ahead is within radius.
+    bool NearPath(const ChunkCoord& center, const ChunkCoord& coord, int radius) const;
+};
+
+// Extrapolates motion, then shortens the lead until ExtraChunks * bytesPerChunk fits memoryCapBytes.
+PrefetchPlan PlanPrefetch(const ChunkPrefetchConfig& config, const StreamingMotion& motion, int loadRadius,
+                          std::size_t layers, std::size_t bytesPerChunk);
+
+} // namespace voxel
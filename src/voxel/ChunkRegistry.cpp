@@ -3,39 +3,18 @@
 #include <atomic>
 #include <chrono>
 #include <iostream>
-#include <queue>
 #include <shared_mutex>
 #include <utility>
 #include <vector>
 
 #include "persistence/ChunkStorage.h"
+#include "voxel/BlockRegistry.h"
 #include "voxel/WorldGen.h"
 
 namespace voxel {
 
 namespace {
 
-bool IsOpaque(BlockId id) {
-    switch (id) {
-    case kBlockAir:
-    case kBlockTorch:
-        return false;
-    default:
-        return true;
-    }
-}
-
-std::uint8_t EmissiveLevel(BlockId id) {
-    switch (id) {
-    case kBlockTorch:
-        return 14;
-    case kBlockLava:
-        return kLightMax;
-    default:
-        return kLightMin;
-    }
-}
-
 struct LightCoord {
     int x;
     int y;
@@ -76,8 +55,21 @@ struct EmissiveVolume {
     }
 };
 
+struct LightScratch {
+    SunlightVolume sunlight;
+    EmissiveVolume emissive;
+    std::vector<LightCoord> queue;
+};
+
+LightScratch& ThreadLightScratch() {
+    thread_local LightScratch scratch;
+    return scratch;
+}
+
 } // namespace
 
+ChunkRegistry::ChunkRegistry(WorldGenConfig worldGen) : generator_(std::move(worldGen)) {}
+
 std::shared_ptr<ChunkEntry> ChunkRegistry::GetOrCreateEntry(const ChunkCoord& coord) {
     std::lock_guard<std::mutex> lock(entriesMutex_);
     auto [it, inserted] = entries_.emplace(coord, std::make_shared<ChunkEntry>());
@@ -88,21 +80,60 @@ std::shared_ptr<ChunkEntry> ChunkRegistry::GetOrCreateEntry(const ChunkCoord& co
 }
 
 void ChunkRegistry::RemoveChunk(const ChunkCoord& coord) {
+    if (auto entry = DetachEntry(coord)) {
+        ReleaseEntry(*entry);
+    }
+}
+
+std::shared_ptr<ChunkEntry> ChunkRegistry::DetachEntry(const ChunkCoord& coord) {
     std::shared_ptr<ChunkEntry> entry;
     {
         std::lock_guard<std::mutex> lock(entriesMutex_);
         auto it = entries_.find(coord);
         if (it == entries_.end()) {
-            return;
+            return nullptr;
         }
-        entry = it->second;
+        entry = std::move(it->second);
         entries_.erase(it);
     }
-
     entry->wanted.store(false);
-    entry->mesh.DestroyGpu();
-    entry->mesh.Clear();
-    entry->gpuState.store(GpuState::NotUploaded);
+    return entry;
+}
+
+bool ChunkRegistry::AttachEntry(const ChunkCoord& coord, const std::shared_ptr<ChunkEntry>& entry) {
+    std::lock_guard<std::mutex> lock(entriesMutex_);
+    if (!entries_.emplace(coord, entry).second) {
+        return false;
+    }
+    entry->wanted.store(true);
+    return true;
+}
+
+void ChunkRegistry::ReleaseEntry(ChunkEntry& entry) {
+    entry.mesh.DestroyGpu();
+    entry.mesh.Clear();
+    entry.gpuState.store(GpuState::NotUploaded);
+
+    std::unique_ptr<Chunk> chunk;
+    std::unique_ptr<LightChunk> light;
+    {
+        std::unique_lock<std::shared_mutex> lock(entry.dataMutex);
+        chunk = std::move(entry.chunk);
+        light = std::move(entry.light);
+        entry.lightReady.store(false, std::memory_order_release);
+    }
+    pools_.chunks.Release(std::move(chunk));
+    pools_.lights.Release(std::move(light));
+}
+
+void ChunkRegistry::ReleaseLight(ChunkEntry& entry) {
+    std::unique_ptr<LightChunk> light;
+    {
+        std::unique_lock<std::shared_mutex> lock(entry.dataMutex);
+        light = std::move(entry.light);
+        entry.lightReady.store(false, std::memory_order_release);
+    }
+    pools_.lights.Release(std::move(light));
 }
 
 void ChunkRegistry::DestroyAll() {
@@ -118,6 +149,18 @@ void ChunkRegistry::DestroyAll() {
     }
 }
 
+ChunkPools& ChunkRegistry::Pools() {
+    return pools_;
+}
+
+const ChunkPools& ChunkRegistry::Pools() const {
+    return pools_;
+}
+
+const WorldGenerator& ChunkRegistry::Generator() const {
+    return generator_;
+}
+
 void ChunkRegistry::SetStorage(persistence::ChunkStorage* storage) {
     storage_ = storage;
 }
@@ -251,7 +294,7 @@ BlockId ChunkRegistry::GetBlock(const WorldBlockCoord& world) const {
     LocalCoord local = WorldToLocalCoord(world, kChunkSize);
     auto handle = AcquireChunkRead(chunkCoord);
     if (!handle) {
-        return SampleFlatWorld(world);
+        return generator_.SampleBlock(world);
     }
     return handle->chunk->Get(local.x, local.y, local.z);
 }
@@ -275,7 +318,7 @@ void ChunkRegistry::SetBlock(const WorldBlockCoord& world, BlockId id) {
     std::unique_lock<std::shared_mutex> lock(entry->dataMutex);
     if (entry->generationState.load(std::memory_order_acquire) != GenerationState::Ready || !entry->chunk) {
         if (!entry->chunk) {
-            auto chunk = std::make_unique<Chunk>();
+            auto chunk = pools_.chunks.Acquire();
             bool loaded = false;
             if (storage_) {
                 loaded = storage_->LoadChunk(chunkCoord, *chunk);
@@ -341,11 +384,14 @@ void ChunkRegistry::RebuildLightForChunk(const ChunkCoord& coord) {
         return;
     }
 
-    std::unique_lock<std::shared_mutex> lock(entry->dataMutex);
+    // Sample under a shared lock so neighboring rebuilds on other threads cannot deadlock; an edit
+    // landing before the write lock re-marks the chunk dirty and triggers another rebuild.
+    std::shared_lock<std::shared_mutex> readLock(entry->dataMutex);
     const Chunk* chunk = entry->chunk.get();
     if (!chunk) {
         return;
     }
+    entry->lightDirty.store(false, std::memory_order_release);
 
     const int chunkBaseX = coord.x * kChunkSize;
     const int chunkBaseY = coord.y * kChunkSize;
@@ -361,7 +407,9 @@ void ChunkRegistry::RebuildLightForChunk(const ChunkCoord& coord) {
         return GetBlock(world);
     };
 
-    SunlightVolume sunlight;
+    const BlockRegistry& blocks = BlockRegistry::Default();
+    LightScratch& scratch = ThreadLightScratch();
+    SunlightVolume& sunlight = scratch.sunlight;
     const int volumeSize = sunlight.size;
     const std::size_t volumeCount = static_cast<std::size_t>(volumeSize * volumeSize * volumeSize);
     sunlight.light.assign(volumeCount, kLightMin);
@@ -374,7 +422,7 @@ void ChunkRegistry::RebuildLightForChunk(const ChunkCoord& coord) {
         for (int y = 0; y < volumeSize; ++y) {
             for (int x = 0; x < volumeSize; ++x) {
                 WorldBlockCoord world{sunlight.baseX + x, sunlight.baseY + y, sunlight.baseZ + z};
-                if (IsOpaque(sampleBlock(world))) {
+                if (blocks.IsOpaque(sampleBlock(world))) {
                     sunlight.opaque[sunlight.Index(x, y, z)] = 1;
                 }
             }
@@ -392,7 +440,7 @@ void ChunkRegistry::RebuildLightForChunk(const ChunkCoord& coord) {
             for (int worldY = kWorldMaxY - 1; worldY >= kWorldMinY; --worldY) {
                 WorldBlockCoord world{worldX, worldY, worldZ};
                 BlockId block = sampleBlock(world);
-                if (IsOpaque(block)) {
+                if (blocks.IsOpaque(block)) {
                     blocked = true;
                 }
                 if (worldY < minWorldY || worldY > maxWorldY) {
@@ -400,7 +448,7 @@ void ChunkRegistry::RebuildLightForChunk(const ChunkCoord& coord) {
                 }
                 const int localY = worldY - sunlight.baseY;
                 const std::size_t idx = sunlight.Index(x, localY, z);
-                if (!blocked && !IsOpaque(block)) {
+                if (!blocked && !blocks.IsOpaque(block)) {
                     sunlight.light[idx] = kLightMax;
                 } else {
                     sunlight.light[idx] = kLightMin;
@@ -409,12 +457,14 @@ void ChunkRegistry::RebuildLightForChunk(const ChunkCoord& coord) {
         }
     }
 
-    std::queue<LightCoord> queue;
+    std::vector<LightCoord>& queue = scratch.queue;
+    queue.clear();
+    std::size_t head = 0;
     for (int z = 0; z < volumeSize; ++z) {
         for (int y = 0; y < volumeSize; ++y) {
             for (int x = 0; x < volumeSize; ++x) {
                 if (sunlight.light[sunlight.Index(x, y, z)] > kLightMin) {
-                    queue.push({x, y, z});
+                    queue.push_back({x, y, z});
                 }
             }
         }
@@ -422,9 +472,8 @@ void ChunkRegistry::RebuildLightForChunk(const ChunkCoord& coord) {
 
     const LightCoord offsets[] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
 
-    while (!queue.empty()) {
-        LightCoord current = queue.front();
-        queue.pop();
+    while (head < queue.size()) {
+        const LightCoord current = queue[head++];
         const std::uint8_t level = sunlight.light[sunlight.Index(current.x, current.y, current.z)];
         if (level <= kLightMin + 1) {
             continue;
@@ -443,12 +492,14 @@ void ChunkRegistry::RebuildLightForChunk(const ChunkCoord& coord) {
             }
             if (nextLevel > sunlight.light[nidx]) {
                 sunlight.light[nidx] = nextLevel;
-                queue.push({nx, ny, nz});
+                queue.push_back({nx, ny, nz});
             }
         }
     }
 
-    EmissiveVolume emissive;
+    EmissiveVolume& emissive = scratch.emissive;
+    queue.clear();
+    head = 0;
     emissive.light.assign(volumeCount, kLightMin);
     emissive.opaque.assign(volumeCount, 0);
     emissive.baseX = sunlight.baseX;
@@ -461,21 +512,20 @@ void ChunkRegistry::RebuildLightForChunk(const ChunkCoord& coord) {
                 WorldBlockCoord world{emissive.baseX + x, emissive.baseY + y, emissive.baseZ + z};
                 BlockId block = sampleBlock(world);
                 const std::size_t idx = emissive.Index(x, y, z);
-                if (IsOpaque(block)) {
+                if (blocks.IsOpaque(block)) {
                     emissive.opaque[idx] = 1;
                 }
-                const std::uint8_t level = EmissiveLevel(block);
+                const std::uint8_t level = blocks.Emissive(block);
                 if (level > kLightMin) {
                     emissive.light[idx] = level;
-                    queue.push({x, y, z});
+                    queue.push_back({x, y, z});
                 }
             }
         }
     }
 
-    while (!queue.empty()) {
-        LightCoord current = queue.front();
-        queue.pop();
+    while (head < queue.size()) {
+        const LightCoord current = queue[head++];
         const std::uint8_t level = emissive.light[emissive.Index(current.x, current.y, current.z)];
         if (level <= kLightMin + 1) {
             continue;
@@ -494,11 +544,22 @@ void ChunkRegistry::RebuildLightForChunk(const ChunkCoord& coord) {
             }
             if (nextLevel > emissive.light[nidx]) {
                 emissive.light[nidx] = nextLevel;
-                queue.push({nx, ny, nz});
+                queue.push_back({nx, ny, nz});
             }
         }
     }
 
+    readLock.unlock();
+
+    std::unique_lock<std::shared_mutex> writeLock(entry->dataMutex);
+    // An unloaded entry may already be released; light acquired for it would never go back to the pool.
+    if (!entry->chunk || !entry->wanted.load()) {
+        return;
+    }
+    if (!entry->light) {
+        entry->light = pools_.lights.Acquire();
+    }
+    LightChunk& light = *entry->light;
     for (int z = 0; z < kChunkSize; ++z) {
         for (int y = 0; y < kChunkSize; ++y) {
             for (int x = 0; x < kChunkSize; ++x) {
@@ -506,13 +567,12 @@ void ChunkRegistry::RebuildLightForChunk(const ChunkCoord& coord) {
                 const int vy = y + 1;
                 const int vz = z + 1;
                 const std::size_t vidx = sunlight.Index(vx, vy, vz);
-                entry->light.SetSunlight(x, y, z, sunlight.light[vidx]);
-                entry->light.SetEmissive(x, y, z, emissive.light[vidx]);
+                light.SetSunlight(x, y, z, sunlight.light[vidx]);
+                light.SetEmissive(x, y, z, emissive.light[vidx]);
             }
         }
     }
 
-    entry->lightDirty.store(false, std::memory_order_release);
     entry->lightReady.store(true, std::memory_order_release);
 }
 
@@ -562,16 +622,8 @@ std::vector<std::shared_ptr<ChunkEntry>> ChunkRegistry::EntriesSnapshot() const
     return entries;
 }
 
-void ChunkRegistry::GenerateChunkData(const ChunkCoord& coord, Chunk& chunk) {
-    for (int z = 0; z < kChunkSize; ++z) {
-        for (int y = 0; y < kChunkSize; ++y) {
-            for (int x = 0; x < kChunkSize; ++x) {
-                LocalCoord local{x, y, z};
-                WorldBlockCoord world = ChunkLocalToWorld(coord, local, kChunkSize);
-                chunk.Set(x, y, z, SampleFlatWorld(world));
-            }
-        }
-    }
+void ChunkRegistry::GenerateChunkData(const ChunkCoord& coord, Chunk& chunk) const {
+    generator_.GenerateChunk(coord, chunk);
 }
 
 } // namespace voxel
@@ -15,8 +15,10 @@
 #include "voxel/ChunkCoord.h"
 #include "voxel/ChunkJobs.h"
 #include "voxel/ChunkMesh.h"
+#include "voxel/ChunkPools.h"
 #include "voxel/LightData.h"
 #include "voxel/VoxelCoords.h"
+#include "voxel/WorldGen.h"
 
 namespace persistence {
 class ChunkStorage;
@@ -44,9 +46,19 @@ enum class GpuState {
     Uploaded
 };
 
+// core::SteadyNowNs() milestones of a chunk's first trip through the pipeline; 0 until reached. The
+// streamer stamps desired, queued and visible on the main thread, workers stamp the generate job.
+struct ChunkTimeline {
+    std::atomic<std::int64_t> desiredNs{0};
+    std::atomic<std::int64_t> generateQueuedNs{0};
+    std::atomic<std::int64_t> generateStartNs{0};
+    std::atomic<std::int64_t> generatedNs{0};
+    std::atomic<std::int64_t> visibleNs{0};
+};
+
 struct ChunkEntry {
     ChunkMesh mesh;
-    LightChunk light;
+    std::unique_ptr<LightChunk> light;
 
     std::unique_ptr<Chunk> chunk;
     std::atomic<GenerationState> generationState{GenerationState::NotScheduled};
@@ -56,6 +68,15 @@ struct ChunkEntry {
     std::atomic<bool> lightDirty{true};
     std::atomic<bool> lightReady{false};
     std::atomic<bool> wanted{true};
+    // LOD for the next mesh build; written by the streamer on the main thread, read by mesh workers.
+    std::atomic<int> lod{0};
+    // Trace flow of the last generate job, continued by the first mesh job.
+    std::atomic<std::uint64_t> traceFlow{0};
+    // On ChunkStreaming's pending list; main thread only.
+    bool streamPending = false;
+    // A remesh was requested while the mesh ring was full; retried from the pending list. Main thread only.
+    bool remeshPending = false;
+    ChunkTimeline timeline;
     mutable std::shared_mutex dataMutex;
 };
 
@@ -69,10 +90,25 @@ struct ChunkReadHandle {
 
 class ChunkRegistry {
 public:
+    explicit ChunkRegistry(WorldGenConfig worldGen = {});
+
     std::shared_ptr<ChunkEntry> GetOrCreateEntry(const ChunkCoord& coord);
     void RemoveChunk(const ChunkCoord& coord);
+    // RemoveChunk in two steps, so a caller can keep a removed entry (GPU mesh, block data and light) and
+    // put it back later. Detached entries are not wanted; AttachEntry fails if the coord has an entry.
+    std::shared_ptr<ChunkEntry> DetachEntry(const ChunkCoord& coord);
+    bool AttachEntry(const ChunkCoord& coord, const std::shared_ptr<ChunkEntry>& entry);
+    // Frees the GPU mesh and returns block data and light to the pools. Main thread.
+    void ReleaseEntry(ChunkEntry& entry);
+    // Returns the light volume to the pool; the next full-detail mesh job around the chunk rebuilds it.
+    void ReleaseLight(ChunkEntry& entry);
     void DestroyAll();
 
+    ChunkPools& Pools();
+    const ChunkPools& Pools() const;
+
+    const WorldGenerator& Generator() const;
+
     void SetStorage(persistence::ChunkStorage* storage);
     bool SaveChunkIfDirty(const ChunkCoord& coord, persistence::ChunkStorage& storage);
     std::size_t SaveAllDirty(persistence::ChunkStorage& storage);
@@ -100,12 +136,14 @@ public:
     void ForEachEntry(const std::function<void(const ChunkCoord&, const std::shared_ptr<ChunkEntry>&)>& fn) const;
     std::vector<std::shared_ptr<ChunkEntry>> EntriesSnapshot() const;
 
-    static void GenerateChunkData(const ChunkCoord& coord, Chunk& chunk);
+    void GenerateChunkData(const ChunkCoord& coord, Chunk& chunk) const;
 
 private:
     mutable std::mutex entriesMutex_;
     std::unordered_map<ChunkCoord, std::shared_ptr<ChunkEntry>, ChunkCoordHash> entries_;
     persistence::ChunkStorage* storage_ = nullptr;
+    ChunkPools pools_;
+    WorldGenerator generator_;
 };
 
 } // namespace voxel
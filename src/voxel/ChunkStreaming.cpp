@@ -1,23 +1,48 @@
 #include "voxel/ChunkStreaming.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <iomanip>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <sstream>
 
+#include "core/Assert.h"
+#include "core/Trace.h"
 #include "persistence/ChunkStorage.h"
+#include "voxel/BlockFaces.h"
 #include "voxel/Chunk.h"
 
 #include "voxel/ChunkMesher.h"
 #include "voxel/ChunkRegistry.h"
+#include "voxel/LightData.h"
 #include "voxel/VoxelCoords.h"
 #include "voxel/WorldGen.h"
 
 namespace voxel {
 
-ChunkStreaming::ChunkStreaming(const ChunkStreamingConfig& config) : config_(config) {
+namespace {
+
+struct MeshScratchRecycler {
+    ChunkPools& pools;
+    std::unique_ptr<ChunkMeshCpu>& mesh;
+
+    ~MeshScratchRecycler() {
+        RecycleMeshScratch(pools, std::move(mesh));
+    }
+};
+
+} // namespace
+
+ChunkStreaming::ChunkStreaming(const ChunkStreamingConfig& config)
+    : config_(config),
+      cache_(config.cache),
+      uploadBudget_(config.uploadBudget),
+      budget_(config.budget, StreamingBudgets{config.maxChunkCreatesPerFrame, config.maxChunkMeshesPerFrame,
+                                              config.maxGpuUploadsPerFrame}) {
     if (config_.loadRadius < config_.renderRadius) {
         config_.loadRadius = config_.renderRadius;
     }
@@ -55,22 +80,38 @@ bool ChunkStreaming::Enabled() const {
 }
 
 void ChunkStreaming::Tick(const ChunkCoord& playerChunk, ChunkRegistry& registry, const ChunkMesher& mesher) {
+    core::TraceScope traceScope("Streaming");
     stats_.playerChunk = playerChunk;
     stats_.createdThisFrame = 0;
     stats_.meshedThisFrame = 0;
     stats_.uploadedThisFrame = 0;
+    stats_.uploadedBytesThisFrame = 0;
+    stats_.lodSwitchesThisFrame = 0;
+
+    const std::int64_t now = core::SteadyNowNs();
+    if (lastTickNs_ != 0) {
+        frameSample_.frameMs = static_cast<double>(now - lastTickNs_) / 1.0e6;
+        frameSample_.workerIdle = workerIdle_;
+        budget_.Update(frameSample_);
+    }
+    lastTickNs_ = now;
+    frameSample_ = {};
 
     if (!config_.enabled) {
         UpdateStats(registry);
         return;
     }
 
-    BuildDesiredSet(playerChunk);
-
+    UpdateDesiredRegion(playerChunk, registry);
     UnloadOutOfRange(registry);
     EnqueueMissing(registry);
     ProcessUploads(registry);
     UpdateStats(registry);
+    core::TraceCounter("Generate queue", static_cast<std::int64_t>(stats_.createQueue));
+    core::TraceCounter("Mesh queue", static_cast<std::int64_t>(stats_.meshQueue));
+    core::TraceCounter("Upload queue", static_cast<std::int64_t>(stats_.uploadQueue));
+    core::TraceCounter("Upload KiB", static_cast<std::int64_t>(stats_.uploadedBytesThisFrame / 1024));
+    core::TraceCounter("Memory MiB", static_cast<std::int64_t>(stats_.memory.totalBytes / (1024 * 1024)));
     WarnIfQueuesLarge();
     (void)mesher;
 }
@@ -100,90 +141,311 @@ bool ChunkStreaming::RequestRemesh(const ChunkCoord& coord, ChunkRegistry& regis
     MeshingState state = entry->meshingState.load(std::memory_order_acquire);
     while (state == MeshingState::NotScheduled || state == MeshingState::Ready) {
         if (entry->meshingState.compare_exchange_weak(state, MeshingState::Queued)) {
-            meshQueue_.push(MeshJob{coord, entry});
-            return true;
+            const std::uint64_t flow = core::Tracer::Global().NextFlowId();
+            if (PushMeshJob(coord, entry, flow)) {
+                core::TraceFlow(core::TracePhase::FlowStart, "Chunk", flow);
+                return true;
+            }
+            // Mesh ring full: keep the old mesh and retry from the pending list.
+            entry->meshingState.store(state, std::memory_order_release);
+            entry->remeshPending = true;
+            if (IsDesired(coord)) {
+                AddPending(coord, entry);
+            }
+            return false;
         }
     }
 
     return false;
 }
 
-void ChunkStreaming::BuildDesiredSet(const ChunkCoord& playerChunk) {
+bool ChunkStreaming::PushMeshJob(const ChunkCoord& coord, const std::shared_ptr<ChunkEntry>& entry,
+                                 std::uint64_t flow) {
+    if (!meshQueue_.try_push(MeshJob{coord, entry, flow, core::SteadyNowNs()})) {
+        return false;
+    }
+    entry->remeshPending = false;
+    return true;
+}
+
+void ChunkStreaming::UpdateDesiredRegion(const ChunkCoord& playerChunk, ChunkRegistry& registry) {
     const int radius = config_.loadRadius;
     const int minChunkY = WorldToChunkCoord(WorldBlockCoord{0, kWorldMinY, 0}, kChunkSize).y;
     const int maxChunkY = WorldToChunkCoord(WorldBlockCoord{0, kWorldMaxY, 0}, kChunkSize).y;
     const int clampedPlayerY = std::clamp(playerChunk.y, minChunkY, maxChunkY);
-    const int minY = std::max(clampedPlayerY - config_.verticalRadius, minChunkY);
-    const int maxY = std::min(clampedPlayerY + config_.verticalRadius, maxChunkY);
-    const std::size_t layers = static_cast<std::size_t>(maxY - minY + 1);
-    const std::size_t capacity = static_cast<std::size_t>((radius * 2 + 1) * (radius * 2 + 1)) * layers;
-    desiredCoords_.clear();
-    desiredCoords_.reserve(capacity);
-    desiredSet_.clear();
-    desiredSet_.reserve(capacity);
-
-    for (int dy = minY; dy <= maxY; ++dy) {
-        for (int dz = -radius; dz <= radius; ++dz) {
-            for (int dx = -radius; dx <= radius; ++dx) {
-                if (std::max(std::abs(dx), std::abs(dz)) > radius) {
-                    continue;
+    ChunkRegion region;
+    region.min = ChunkCoord{playerChunk.x - radius, std::max(clampedPlayerY - config_.verticalRadius, minChunkY),
+                            playerChunk.z - radius};
+    region.max = ChunkCoord{playerChunk.x + radius, std::min(clampedPlayerY + config_.verticalRadius, maxChunkY),
+                            playerChunk.z + radius};
+    // Grow the box toward where the player is heading so fast movement finds its chunks already loaded.
+    const std::size_t layers = static_cast<std::size_t>(region.max.y - region.min.y + 1);
+    prefetch_ = PlanPrefetch(config_.prefetch, motion_, radius, layers, EstimateChunkBytes());
+    stats_.prefetchChunks = prefetch_.ExtraChunks(radius, layers);
+    (prefetch_.aheadX > 0 ? region.max.x : region.min.x) += prefetch_.aheadX;
+    (prefetch_.aheadZ > 0 ? region.max.z : region.min.z) += prefetch_.aheadZ;
+    const bool moved = !(playerChunk == regionCenter_);
+    regionCenter_ = playerChunk;
+    if (region == desiredRegion_ && !moved) {
+        return;
+    }
+
+    // Chunks stay loaded until they are unloadMargin chunks outside the region, so walking back and forth
+    // over a border does not unload and reload the same slab.
+    const int margin = std::max(0, config_.unloadMargin);
+    ChunkRegion keep = region;
+    keep.min = ChunkCoord{region.min.x - margin, std::max(region.min.y - margin, minChunkY), region.min.z - margin};
+    keep.max = ChunkCoord{region.max.x + margin, std::min(region.max.y + margin, maxChunkY), region.max.z + margin};
+    const ChunkRegion previous = desiredRegion_;
+    const ChunkRegion previousKeep = keepRegion_;
+    desiredRegion_ = region;
+    keepRegion_ = keep;
+    ForEachOutside(previousKeep, keep, [&](const ChunkCoord& coord) { UnloadChunk(coord, registry); });
+
+    const std::int64_t now = core::SteadyNowNs();
+    ForEachOutside(region, previous, [&](const ChunkCoord& coord) {
+        auto entry = LoadChunk(coord, registry);
+        if (entry->timeline.desiredNs.load(std::memory_order_relaxed) == 0) {
+            entry->timeline.desiredNs.store(now, std::memory_order_relaxed);
+        }
+        AddPending(coord, entry);
+    });
+
+    // Distances changed for every chunk that stayed; only drawn chunks can need a LOD switch, and those
+    // that do go back on the pending list until the new mesh is up.
+    if (previous.Empty() || !moved) {
+        return;
+    }
+    for (const auto& chunk : renderList_.Chunks()) {
+        if (!IsDesired(chunk.coord)) {
+            continue;
+        }
+        const int targetLod = TargetLod(chunk.coord, *chunk.entry);
+        SetTargetLod(chunk.coord, *chunk.entry, targetLod, registry);
+        if (chunk.entry->mesh.Lod() != targetLod) {
+            AddPending(chunk.coord, chunk.entry);
+        }
+    }
+}
+
+void ChunkStreaming::AddPending(const ChunkCoord& coord, const std::shared_ptr<ChunkEntry>& entry) {
+    if (entry->streamPending) {
+        return;
+    }
+    entry->streamPending = true;
+    pending_.push_back(PendingChunk{coord, entry});
+}
+
+std::size_t ChunkStreaming::EstimateChunkBytes() const {
+    const auto& bytes = stats_.memory.bytes;
+    const std::size_t chunkBytes = bytes[static_cast<std::size_t>(core::MemoryCategory::BlockData)] +
+                                   bytes[static_cast<std::size_t>(core::MemoryCategory::Light)] +
+                                   bytes[static_cast<std::size_t>(core::MemoryCategory::CpuMesh)] +
+                                   bytes[static_cast<std::size_t>(core::MemoryCategory::GpuMesh)];
+    if (stats_.loadedChunks == 0 || chunkBytes == 0) {
+        return sizeof(Chunk);
+    }
+    return std::max(chunkBytes / stats_.loadedChunks, sizeof(Chunk));
+}
+
+int ChunkStreaming::TargetLod(const ChunkCoord& coord, const ChunkEntry& entry) const {
+    const int distance = std::max(std::abs(coord.x - regionCenter_.x), std::abs(coord.z - regionCenter_.z));
+    return entry.gpuState.load(std::memory_order_acquire) == GpuState::Uploaded
+               ? SelectLod(distance, entry.mesh.Lod(), config_.lod)
+               : LodForDistance(distance, config_.lod);
+}
+
+void ChunkStreaming::SetTargetLod(const ChunkCoord& coord, ChunkEntry& entry, int lod, ChunkRegistry& registry) {
+    const int previous = entry.lod.exchange(lod, std::memory_order_acq_rel);
+    if (previous == lod || entry.generationState.load(std::memory_order_acquire) != GenerationState::Ready) {
+        return;
+    }
+    // Border faces are culled only between chunks at the same LOD, so a meshed neighbour at the old or
+    // the new LOD has to mesh its border again.
+    for (const BlockFace& face : kBlockFaces) {
+        const ChunkCoord neighborCoord{coord.x + face.neighborOffset.x, coord.y + face.neighborOffset.y,
+                                       coord.z + face.neighborOffset.z};
+        auto neighbor = registry.TryGetEntry(neighborCoord);
+        if (!neighbor || !neighbor->wanted.load() ||
+            neighbor->meshingState.load(std::memory_order_acquire) == MeshingState::NotScheduled) {
+            continue;
+        }
+        const int neighborLod = neighbor->lod.load(std::memory_order_acquire);
+        if (neighborLod != previous && neighborLod != lod) {
+            continue;
+        }
+        neighbor->remeshPending = true;
+        if (IsDesired(neighborCoord)) {
+            AddPending(neighborCoord, neighbor);
+        }
+    }
+}
+
+std::shared_ptr<ChunkEntry> ChunkStreaming::LoadChunk(const ChunkCoord& coord, ChunkRegistry& registry) {
+    if (auto entry = registry.TryGetEntry(coord)) {
+        return entry;
+    }
+    ++expectedLoaded_;
+    if (auto cached = cache_.Take(coord)) {
+        if (registry.AttachEntry(coord, cached)) {
+            if (cached->gpuState.load(std::memory_order_acquire) == GpuState::Uploaded) {
+                renderList_.SetVisibility(coord, cached->mesh.Visibility());
+                if (cached->mesh.GpuIndexCount() > 0) {
+                    renderList_.Upsert(coord, cached);
                 }
-                ChunkCoord coord{playerChunk.x + dx, dy, playerChunk.z + dz};
-                desiredCoords_.push_back(coord);
-                desiredSet_.insert(coord);
             }
+            return cached;
         }
+        registry.ReleaseEntry(*cached);
+    }
+    auto entry = registry.GetOrCreateEntry(coord);
+    entry->wanted.store(true);
+    return entry;
+}
+
+void ChunkStreaming::UnloadChunk(const ChunkCoord& coord, ChunkRegistry& registry) {
+    if (storage_) {
+        registry.SaveChunkIfDirty(coord, *storage_);
+    }
+    renderList_.Remove(coord);
+    renderList_.ClearVisibility(coord);
+    std::shared_ptr<ChunkEntry> entry = registry.DetachEntry(coord);
+    if (!entry) {
+        return;
+    }
+    --expectedLoaded_;
+
+    // Chunks with jobs in flight are released; a worker or an upload may still touch their state.
+    const MeshingState meshing = entry->meshingState.load(std::memory_order_acquire);
+    const bool settled = entry->generationState.load(std::memory_order_acquire) == GenerationState::Ready &&
+                         (meshing == MeshingState::NotScheduled || meshing == MeshingState::Ready) &&
+                         entry->gpuState.load(std::memory_order_acquire) != GpuState::UploadQueued;
+    if (!settled || cache_.Config().memoryCapBytes == 0) {
+        registry.ReleaseEntry(*entry);
+        return;
+    }
+    if (!cache_.Config().keepMeshes) {
+        entry->mesh.DestroyGpu();
+        entry->mesh.Clear();
+        entry->gpuState.store(GpuState::NotUploaded, std::memory_order_release);
+        entry->meshingState.store(MeshingState::NotScheduled, std::memory_order_release);
     }
+    std::size_t bytes = entry->mesh.GpuBytes();
+    {
+        std::shared_lock<std::shared_mutex> lock(entry->dataMutex);
+        bytes += (entry->chunk ? sizeof(Chunk) : 0) + (entry->light ? sizeof(LightChunk) : 0);
+    }
+    if (!cache_.Insert(coord, entry, bytes, evicted_)) {
+        registry.ReleaseEntry(*entry);
+    }
+    for (auto& evicted : evicted_) {
+        registry.ReleaseEntry(*evicted);
+    }
+    evicted_.clear();
+}
+
+void ChunkStreaming::ClearCache(ChunkRegistry& registry) {
+    cache_.Clear(evicted_);
+    for (auto& evicted : evicted_) {
+        registry.ReleaseEntry(*evicted);
+    }
+    evicted_.clear();
 }
 
 void ChunkStreaming::UnloadOutOfRange(ChunkRegistry& registry) {
+    // The region diff already dropped everything that left it; a full sweep is only needed for entries
+    // created by other code (edits, tests) and on the first tick.
+    if (!needsSweep_ && registry.LoadedCount() == expectedLoaded_) {
+        return;
+    }
+    needsSweep_ = false;
     unloadList_.clear();
     unloadList_.reserve(registry.LoadedCount());
 
     registry.ForEachEntry([&](const ChunkCoord& coord, const std::shared_ptr<ChunkEntry>& entry) {
         (void)entry;
-        if (!IsDesired(coord)) {
+        if (!keepRegion_.Contains(coord)) {
             unloadList_.push_back(coord);
         }
     });
 
     for (const ChunkCoord& coord : unloadList_) {
-        if (storage_) {
-            registry.SaveChunkIfDirty(coord, *storage_);
-        }
-        registry.RemoveChunk(coord);
+        UnloadChunk(coord, registry);
     }
+    expectedLoaded_ = registry.LoadedCount();
 }
 
 void ChunkStreaming::EnqueueMissing(ChunkRegistry& registry) {
     const int layerCount = config_.verticalRadius * 2 + 1;
-    int createBudget = config_.maxChunkCreatesPerFrame * layerCount;
-    int meshBudget = config_.maxChunkMeshesPerFrame * layerCount;
+    int createBudget = budget_.Current().creates * layerCount;
+    int meshBudget = budget_.Current().meshes * layerCount;
+    const std::int64_t now = core::SteadyNowNs();
+    if (prefetch_.Active()) {
+        // What the player will see along the predicted path goes before the rest of the region.
+        std::stable_partition(pending_.begin(), pending_.end(), [this](const PendingChunk& chunk) {
+            return prefetch_.NearPath(regionCenter_, chunk.coord, config_.renderRadius);
+        });
+    }
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < pending_.size(); ++i) {
+        const ChunkCoord coord = pending_[i].coord;
+        std::shared_ptr<ChunkEntry> entry = std::move(pending_[i].entry);
+        entry->streamPending = false;
+        if (!IsDesired(coord)) {
+            continue;
+        }
+        if (!entry->wanted.load()) {
+            // Unloaded by a full sweep and reloaded since; follow the live entry unless it is queued too.
+            entry = registry.GetOrCreateEntry(coord);
+            entry->wanted.store(true);
+            if (entry->streamPending) {
+                continue;
+            }
+        }
+        // Still listed while it is processed, so a remesh that finds the ring full does not list it twice.
+        entry->streamPending = true;
 
-    for (const ChunkCoord& coord : desiredCoords_) {
-        auto entry = registry.GetOrCreateEntry(coord);
-        entry->wanted.store(true);
+        const int targetLod = TargetLod(coord, *entry);
+        SetTargetLod(coord, *entry, targetLod, registry);
+        const bool uploaded = entry->gpuState.load(std::memory_order_acquire) == GpuState::Uploaded;
 
         if (createBudget > 0) {
             GenerationState genExpected = GenerationState::NotScheduled;
             if (entry->generationState.compare_exchange_strong(genExpected, GenerationState::Generating)) {
                 bool loaded = false;
                 if (storage_) {
-                    voxel::Chunk chunk;
-                    if (storage_->LoadChunk(coord, chunk)) {
+                    auto chunk = registry.Pools().chunks.Acquire();
+                    if (storage_->LoadChunk(coord, *chunk)) {
                         std::unique_lock<std::shared_mutex> lock(entry->dataMutex);
-                        entry->chunk = std::make_unique<voxel::Chunk>(std::move(chunk));
+                        entry->chunk = std::move(chunk);
                         entry->generationState.store(GenerationState::Ready, std::memory_order_release);
                         entry->dirty.store(false, std::memory_order_release);
+                        entry->timeline.generatedNs.store(core::SteadyNowNs(), std::memory_order_relaxed);
                         loaded = true;
+                    } else {
+                        registry.Pools().chunks.Release(std::move(chunk));
                     }
                 }
+                bool queued = true;
                 if (!loaded) {
                     entry->generationState.store(GenerationState::Queued, std::memory_order_release);
-                    generateQueue_.push(GenerateJob{coord, entry});
+                    const std::uint64_t flow = core::Tracer::Global().NextFlowId();
+                    queued = generateQueue_.try_push(GenerateJob{coord, entry, flow});
+                    // Stamped only once the job is in the ring, so a refused push leaves no wait or flow behind.
+                    if (queued) {
+                        entry->timeline.generateQueuedNs.store(now, std::memory_order_relaxed);
+                        core::TraceFlow(core::TracePhase::FlowStart, "Chunk", flow);
+                    }
+                }
+                if (queued) {
+                    ++stats_.createdThisFrame;
+                    --createBudget;
+                } else {
+                    // Generate ring full: the chunk stays pending and no more creates fit this frame.
+                    entry->generationState.store(GenerationState::NotScheduled, std::memory_order_release);
+                    createBudget = 0;
                 }
-                ++stats_.createdThisFrame;
-                --createBudget;
             }
         }
 
@@ -191,45 +453,116 @@ void ChunkStreaming::EnqueueMissing(ChunkRegistry& registry) {
             entry->generationState.load(std::memory_order_acquire) == GenerationState::Ready) {
             MeshingState meshExpected = MeshingState::NotScheduled;
             if (entry->meshingState.compare_exchange_strong(meshExpected, MeshingState::Queued)) {
-                meshQueue_.push(MeshJob{coord, entry});
-                ++stats_.meshedThisFrame;
-                --meshBudget;
+                // A chunk generated on a worker carries its flow on; one loaded from disk starts a new one.
+                const std::uint64_t carried = entry->traceFlow.exchange(0, std::memory_order_acq_rel);
+                const std::uint64_t flow = carried != 0 ? carried : core::Tracer::Global().NextFlowId();
+                if (PushMeshJob(coord, entry, flow)) {
+                    if (carried == 0) {
+                        core::TraceFlow(core::TracePhase::FlowStart, "Chunk", flow);
+                    }
+                    ++stats_.meshedThisFrame;
+                    --meshBudget;
+                } else {
+                    entry->traceFlow.store(carried, std::memory_order_release);
+                    entry->meshingState.store(MeshingState::NotScheduled, std::memory_order_release);
+                    meshBudget = 0;
+                }
             }
         }
+
+        if (meshBudget > 0 && entry->remeshPending && RequestRemesh(coord, registry)) {
+            ++stats_.meshedThisFrame;
+            --meshBudget;
+        }
+
+        // The uploaded mesh stays on screen until the mesh at the new LOD replaces it.
+        if (meshBudget > 0 && uploaded && entry->mesh.Lod() != targetLod &&
+            entry->meshingState.load(std::memory_order_acquire) == MeshingState::Ready &&
+            RequestRemesh(coord, registry)) {
+            ++stats_.lodSwitchesThisFrame;
+            --meshBudget;
+        }
+
+        // Done once its mesh is on the GPU at the wanted LOD; later edits remesh through RequestRemesh.
+        const bool done = uploaded && entry->mesh.Lod() == targetLod && !entry->remeshPending &&
+                          entry->meshingState.load(std::memory_order_acquire) == MeshingState::Ready;
+        if (done) {
+            entry->streamPending = false;
+        } else {
+            pending_[kept++] = PendingChunk{coord, std::move(entry)};
+        }
     }
+    pending_.resize(kept);
+    frameSample_.createBacklog = createBudget <= 0;
+    frameSample_.meshBacklog = meshBudget <= 0;
 }
 
 bool ChunkStreaming::IsDesired(const ChunkCoord& coord) const {
-    return desiredSet_.contains(coord);
+    return desiredRegion_.Contains(coord);
 }
 
 void ChunkStreaming::SetWorkerThreads(std::size_t workerThreads) {
     config_.workerThreads = static_cast<int>(workerThreads);
 }
 
+void ChunkStreaming::SetWorkerIdleRatio(double idleRatio) {
+    workerIdle_ = idleRatio;
+}
+
+void ChunkStreaming::SetMotion(const StreamingMotion& motion) {
+    motion_ = motion;
+}
+
 void ChunkStreaming::SetStorage(persistence::ChunkStorage* storage) {
     storage_ = storage;
 }
 
-core::ThreadSafeQueue<GenerateJob>& ChunkStreaming::GenerateQueue() {
+void ChunkStreaming::SetMeshStore(MeshStore* store) {
+    meshStore_ = store;
+}
+
+core::MpmcQueue<GenerateJob>& ChunkStreaming::GenerateQueue() {
     return generateQueue_;
 }
 
-core::ThreadSafeQueue<MeshJob>& ChunkStreaming::MeshQueue() {
+core::MpmcQueue<MeshJob>& ChunkStreaming::MeshQueue() {
     return meshQueue_;
 }
 
-core::ThreadSafeQueue<MeshReady>& ChunkStreaming::UploadQueue() {
+core::MpmcQueue<MeshReady>& ChunkStreaming::UploadQueue() {
     return uploadQueue_;
 }
 
+const renderer::ChunkRenderList& ChunkStreaming::RenderList() const {
+    return renderList_;
+}
+
 void ChunkStreaming::ProcessUploads(ChunkRegistry& registry) {
     core::ScopedTimer uploadTimer(profiler_, core::Metric::Upload);
-    while (stats_.uploadedThisFrame < config_.maxGpuUploadsPerFrame) {
+    MC_ASSERT(meshStore_ != nullptr || uploadQueue_.empty(), "ChunkStreaming uploads need a mesh store.");
+    if (meshStore_ == nullptr) {
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    auto elapsedMs = [&start] {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+    const int uploadLimit = budget_.Current().uploads;
+    while (stats_.uploadedThisFrame < uploadLimit) {
         MeshReady ready;
-        if (!uploadQueue_.try_pop(ready)) {
+        if (heldUpload_) {
+            ready = std::move(*heldUpload_);
+            heldUpload_.reset();
+        } else if (!uploadQueue_.try_pop(ready)) {
+            break;
+        }
+        const std::size_t bytes = ready.cpuMesh->vertices.size() * sizeof(VoxelVertex) +
+                                  ready.cpuMesh->indices.size() * sizeof(std::uint32_t);
+        if (config_.budget.adaptive && !uploadBudget_.Allows(stats_.uploadedBytesThisFrame, bytes, elapsedMs())) {
+            heldUpload_ = std::move(ready);
             break;
         }
+        MeshScratchRecycler recycler{registry.Pools(), ready.cpuMesh};
 
         auto entry = registry.TryGetEntry(ready.coord);
         if (!entry) {
@@ -252,13 +585,17 @@ void ChunkStreaming::ProcessUploads(ChunkRegistry& registry) {
             std::cout << "[Streaming] Dropped mesh upload for unloaded chunk (" << ready.coord.x << ", "
                       << ready.coord.y << ", " << ready.coord.z << ").\n";
 #endif
+            renderList_.Remove(ready.coord);
+            renderList_.ClearVisibility(ready.coord);
             entry->gpuState.store(GpuState::NotUploaded, std::memory_order_release);
             entry->meshingState.store(MeshingState::NotScheduled, std::memory_order_release);
             continue;
         }
 
-        if (!IsDesired(ready.coord)) {
+        if (!keepRegion_.Contains(ready.coord)) {
             std::cout << "[Streaming] Dropped mesh upload for out-of-range chunk.\n";
+            renderList_.Remove(ready.coord);
+            renderList_.ClearVisibility(ready.coord);
             entry->gpuState.store(GpuState::NotUploaded, std::memory_order_release);
             entry->meshingState.store(MeshingState::NotScheduled, std::memory_order_release);
             continue;
@@ -269,20 +606,84 @@ void ChunkStreaming::ProcessUploads(ChunkRegistry& registry) {
         }
 
         entry->mesh.Clear();
-        entry->mesh.Vertices() = std::move(ready.cpuMesh->vertices);
-        entry->mesh.Indices() = std::move(ready.cpuMesh->indices);
-        entry->mesh.UploadToGpu();
-        entry->mesh.ClearCpu();
+        entry->mesh.Vertices().swap(ready.cpuMesh->vertices);
+        entry->mesh.Indices().swap(ready.cpuMesh->indices);
+        entry->mesh.Faces() = ready.cpuMesh->faces;
+        entry->mesh.SetVisibility(ready.cpuMesh->visibility);
+        entry->mesh.SetLod(ready.cpuMesh->lod);
+        entry->mesh.UploadToGpu(*meshStore_);
+        entry->mesh.Vertices().swap(ready.cpuMesh->vertices);
+        entry->mesh.Indices().swap(ready.cpuMesh->indices);
         entry->gpuState.store(GpuState::Uploaded, std::memory_order_release);
+        if (entry->mesh.Lod() > 0 && entry->lightReady.load(std::memory_order_acquire) &&
+            !NearFullDetail(ready.coord, registry)) {
+            // Coarse meshes are unlit; the volume is rebuilt if the chunk or a neighbour returns to LOD 0.
+            registry.ReleaseLight(*entry);
+        }
+        renderList_.SetVisibility(ready.coord, entry->mesh.Visibility());
+        if (entry->mesh.GpuIndexCount() > 0) {
+            renderList_.Upsert(ready.coord, entry);
+        } else {
+            renderList_.Remove(ready.coord);
+        }
+        core::TraceFlow(core::TracePhase::FlowEnd, "Chunk", ready.traceFlow);
+        RecordPipelineLatency(entry->timeline, ready.timing);
         ++stats_.uploadedThisFrame;
+        stats_.uploadedBytesThisFrame += bytes;
     }
+    frameSample_.uploadMs = elapsedMs();
+    frameSample_.uploadBacklog = stats_.uploadedThisFrame >= uploadLimit;
+    uploadBudget_.Record(stats_.uploadedBytesThisFrame, frameSample_.uploadMs);
+    stats_.uploadBudgetBytes = uploadBudget_.FrameBytes();
+    stats_.uploadBytesPerMs = uploadBudget_.BytesPerMs();
 }
 
-void ChunkStreaming::UpdateStats(const ChunkRegistry& registry) {
+bool ChunkStreaming::NearFullDetail(const ChunkCoord& coord, const ChunkRegistry& registry) const {
+    // A LOD 0 mesh job lights its whole 3x3 neighbourhood; LOD is per column, so one layer is enough.
+    for (int dz = -1; dz <= 1; ++dz) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            auto neighbor = registry.TryGetEntry({coord.x + dx, coord.y, coord.z + dz});
+            if ((dx != 0 || dz != 0) && neighbor && neighbor->lod.load(std::memory_order_acquire) == 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ChunkStreaming::RecordPipelineLatency(ChunkTimeline& timeline, const MeshTiming& mesh) {
+    const std::int64_t uploadedNs = core::SteadyNowNs();
+    const std::uint64_t track = core::Tracer::Global().NextFlowId();
+    auto record = [&](PipelineStage stage, std::int64_t beginNs, std::int64_t endNs) {
+        if (beginNs <= 0 || endNs < beginNs) {
+            return;
+        }
+        pipelineLatency_[static_cast<std::size_t>(stage)].Record(static_cast<std::uint64_t>(endNs - beginNs) / 1000);
+        core::TraceAsyncSpan(PipelineStageName(stage), track, beginNs, endNs);
+    };
+
+    // The generate stages and the headline latency belong to the first upload only; later uploads are
+    // remeshes after edits or LOD switches.
+    if (timeline.visibleNs.load(std::memory_order_relaxed) == 0) {
+        timeline.visibleNs.store(uploadedNs, std::memory_order_relaxed);
+        const std::int64_t generateStartNs = timeline.generateStartNs.load(std::memory_order_relaxed);
+        record(PipelineStage::Visible, timeline.desiredNs.load(std::memory_order_relaxed), uploadedNs);
+        record(PipelineStage::GenerateWait, timeline.generateQueuedNs.load(std::memory_order_relaxed),
+               generateStartNs);
+        record(PipelineStage::Generate, generateStartNs, timeline.generatedNs.load(std::memory_order_relaxed));
+    }
+    record(PipelineStage::MeshWait, mesh.queuedNs, mesh.startNs);
+    record(PipelineStage::Light, mesh.startNs, mesh.litNs);
+    record(PipelineStage::Mesh, mesh.litNs != 0 ? mesh.litNs : mesh.startNs, mesh.meshedNs);
+    record(PipelineStage::UploadWait, mesh.meshedNs, uploadedNs);
+}
+
+void ChunkStreaming::TakeCensus(const ChunkRegistry& registry) {
     stats_.loadedChunks = 0;
     stats_.generatedChunksReady = 0;
     stats_.meshedCpuReady = 0;
     stats_.gpuReadyChunks = 0;
+    stats_.lodChunks = {};
 
     registry.ForEachEntry([&](const ChunkCoord& coord, const std::shared_ptr<ChunkEntry>& entry) {
         (void)coord;
@@ -295,13 +696,39 @@ void ChunkStreaming::UpdateStats(const ChunkRegistry& registry) {
         }
         if (entry->gpuState.load(std::memory_order_acquire) == GpuState::Uploaded) {
             ++stats_.gpuReadyChunks;
+            ++stats_.lodChunks[static_cast<std::size_t>(entry->mesh.Lod())];
         }
     });
+}
+
+void ChunkStreaming::UpdateStats(const ChunkRegistry& registry) {
+    // Per-frame counts that need no registry walk; the per-state census is left to TakeCensus.
+    stats_.loadedChunks = registry.LoadedCount();
+    stats_.gpuReadyChunks = renderList_.Size();
 
     stats_.createQueue = generateQueue_.size();
     stats_.meshQueue = meshQueue_.size();
-    stats_.uploadQueue = uploadQueue_.size();
+    stats_.uploadQueue = uploadQueue_.size() + (heldUpload_ ? 1u : 0u);
     stats_.workerThreads = static_cast<std::size_t>(config_.workerThreads);
+    stats_.pendingChunks = pending_.size();
+    stats_.cache = cache_.Stats();
+    stats_.budgets = budget_.Current();
+    stats_.adaptiveBudgets = config_.budget.adaptive;
+    stats_.targetFrameMs = config_.budget.targetFrameMs;
+    stats_.frameMs = budget_.FrameMs();
+    stats_.uploadMs = budget_.UploadMs();
+    stats_.workerIdle = budget_.WorkerIdle();
+    stats_.memory = core::MemoryLedger::Global().Snapshot();
+
+    const auto now = std::chrono::steady_clock::now();
+    const bool rotate =
+        std::chrono::duration<double>(now - pipelineWindowStart_).count() >= core::Profiler::kLatencyWindowSeconds;
+    for (std::size_t i = 0; i < kPipelineStageCount; ++i) {
+        stats_.pipeline[i] = pipelineLatency_[i].Percentiles(rotate);
+    }
+    if (rotate) {
+        pipelineWindowStart_ = now;
+    }
 }
 
 void ChunkStreaming::WarnIfQueuesLarge() {
@@ -338,4 +765,86 @@ void ChunkStreaming::WarnIfQueuesLarge() {
     }
 }
 
+const char* PipelineStageName(PipelineStage stage) {
+    switch (stage) {
+    case PipelineStage::Visible:
+        return "Desired to visible";
+    case PipelineStage::GenerateWait:
+        return "Generate wait";
+    case PipelineStage::Generate:
+        return "Generate run";
+    case PipelineStage::MeshWait:
+        return "Mesh wait";
+    case PipelineStage::Light:
+        return "Light run";
+    case PipelineStage::Mesh:
+        return "Mesh run";
+    case PipelineStage::UploadWait:
+        return "Upload wait";
+    case PipelineStage::Count:
+        break;
+    }
+    return "Unknown";
+}
+
+std::string DescribePipeline(const ChunkStreamingStats& stats) {
+    auto stage = [&stats](PipelineStage value) -> const core::LatencyPercentiles& {
+        return stats.pipeline[static_cast<std::size_t>(value)];
+    };
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    auto column = [&out](const core::LatencyPercentiles& percentiles) {
+        out << percentiles.p50Ms << '/' << percentiles.p99Ms;
+    };
+    out << "[Pipeline] p50/p99 ms visible ";
+    column(stage(PipelineStage::Visible));
+    out << " | gen wait ";
+    column(stage(PipelineStage::GenerateWait));
+    out << " run ";
+    column(stage(PipelineStage::Generate));
+    out << " | mesh wait ";
+    column(stage(PipelineStage::MeshWait));
+    out << " light ";
+    column(stage(PipelineStage::Light));
+    out << " run ";
+    column(stage(PipelineStage::Mesh));
+    out << " | upload wait ";
+    column(stage(PipelineStage::UploadWait));
+    return out.str();
+}
+
+std::string DescribeUploads(const ChunkStreamingStats& stats) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << "[Upload] " << stats.uploadedThisFrame << " chunks "
+        << static_cast<double>(stats.uploadedBytesThisFrame) / 1024.0 << '/'
+        << static_cast<double>(stats.uploadBudgetBytes) / 1024.0 << " KiB "
+        << stats.uploadBytesPerMs * 1000.0 / (1024.0 * 1024.0) << " MiB/s";
+    return out.str();
+}
+
+std::string DescribeCache(const ChunkStreamingStats& stats) {
+    const ChunkCacheStats& cache = stats.cache;
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << "[Cache] " << cache.chunks << " chunks "
+        << static_cast<double>(cache.bytes) / (1024.0 * 1024.0) << " MiB | hits " << cache.hits << " misses "
+        << cache.misses << " (" << std::setprecision(0) << cache.HitRate() * 100.0 << "% hit) | evictions "
+        << cache.evictions;
+    return out.str();
+}
+
+std::string DescribeBudgets(const ChunkStreamingStats& stats) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << "[Budget] " << (stats.adaptiveBudgets ? "adaptive" : "fixed")
+        << " creates " << stats.budgets.creates << " meshes " << stats.budgets.meshes << " uploads "
+        << stats.budgets.uploads << " | frame " << stats.frameMs << '/' << stats.targetFrameMs << " ms upload "
+        << std::setprecision(2) << stats.uploadMs << " ms | workers idle ";
+    if (stats.workerIdle < 0.0) {
+        out << '-';
+    } else {
+        out << std::setprecision(0) << stats.workerIdle * 100.0 << '%';
+    }
+    out << " | pending " << stats.pendingChunks << " | prefetch +" << stats.prefetchChunks;
+    return out.str();
+}
+
 } // namespace voxel
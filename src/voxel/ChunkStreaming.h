@@ -1,13 +1,26 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstddef>
-#include <unordered_set>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
+#include "core/MemoryLedger.h"
+#include "core/MpmcQueue.h"
 #include "core/Profiler.h"
-#include "core/ThreadSafeQueue.h"
+#include "renderer/ChunkRenderList.h"
+#include "voxel/ChunkCache.h"
 #include "voxel/ChunkCoord.h"
 #include "voxel/ChunkJobs.h"
+#include "voxel/ChunkLod.h"
+#include "voxel/ChunkPrefetch.h"
+#include "voxel/StreamingBudget.h"
+#include "voxel/UploadBudget.h"
 
 namespace persistence {
 class ChunkStorage;
@@ -17,31 +30,139 @@ namespace voxel {
 
 class ChunkMesher;
 class ChunkRegistry;
+struct ChunkEntry;
+struct ChunkTimeline;
+
+// Inclusive box of chunk coordinates; empty until max >= min on every axis.
+struct ChunkRegion {
+    ChunkCoord min{0, 0, 0};
+    ChunkCoord max{-1, -1, -1};
+
+    bool Empty() const { return max.x < min.x || max.y < min.y || max.z < min.z; }
+    bool Contains(const ChunkCoord& coord) const {
+        return coord.x >= min.x && coord.x <= max.x && coord.y >= min.y && coord.y <= max.y && coord.z >= min.z &&
+               coord.z <= max.z;
+    }
+    std::size_t Volume() const {
+        return Empty() ? 0
+                       : static_cast<std::size_t>(max.x - min.x + 1) * static_cast<std::size_t>(max.y - min.y + 1) *
+                             static_cast<std::size_t>(max.z - min.z + 1);
+    }
+    bool operator==(const ChunkRegion& other) const { return min == other.min && max == other.max; }
+};
+
+// Calls fn for every coordinate of a that lies outside b, walking at most six slabs, so a one-chunk move
+// visits one face of the region instead of all of it.
+template <typename Fn>
+void ForEachOutside(const ChunkRegion& a, const ChunkRegion& b, Fn&& fn) {
+    auto forEach = [&fn](int x0, int x1, int y0, int y1, int z0, int z1) {
+        for (int y = y0; y <= y1; ++y) {
+            for (int z = z0; z <= z1; ++z) {
+                for (int x = x0; x <= x1; ++x) {
+                    fn(ChunkCoord{x, y, z});
+                }
+            }
+        }
+    };
+    if (a.Empty()) {
+        return;
+    }
+    if (b.Empty() || b.max.x < a.min.x || b.min.x > a.max.x || b.max.y < a.min.y || b.min.y > a.max.y ||
+        b.max.z < a.min.z || b.min.z > a.max.z) {
+        forEach(a.min.x, a.max.x, a.min.y, a.max.y, a.min.z, a.max.z);
+        return;
+    }
+    forEach(a.min.x, std::min(a.max.x, b.min.x - 1), a.min.y, a.max.y, a.min.z, a.max.z);
+    forEach(std::max(a.min.x, b.max.x + 1), a.max.x, a.min.y, a.max.y, a.min.z, a.max.z);
+    const int x0 = std::max(a.min.x, b.min.x);
+    const int x1 = std::min(a.max.x, b.max.x);
+    forEach(x0, x1, a.min.y, a.max.y, a.min.z, std::min(a.max.z, b.min.z - 1));
+    forEach(x0, x1, a.min.y, a.max.y, std::max(a.min.z, b.max.z + 1), a.max.z);
+    const int z0 = std::max(a.min.z, b.min.z);
+    const int z1 = std::min(a.max.z, b.max.z);
+    forEach(x0, x1, a.min.y, std::min(a.max.y, b.min.y - 1), z0, z1);
+    forEach(x0, x1, std::max(a.min.y, b.max.y + 1), a.max.y, z0, z1);
+}
 
 struct ChunkStreamingConfig {
     int loadRadius = 10;
     int renderRadius = 8;
     int verticalRadius = 2;
+    // Loaded chunks are unloaded only this many chunks outside the load region (hysteresis).
+    int unloadMargin = 2;
+    // Starting per-frame limits; with budget.adaptive the controller moves them within its bounds.
+    // Creates and meshes are per vertical layer.
     int maxChunkCreatesPerFrame = 3;
     int maxChunkMeshesPerFrame = 2;
-    int maxGpuUploadsPerFrame = 3;
+    // Ceiling on uploads per frame; with budget.adaptive, uploadBudget sets byte and time limits below it.
+    // Without it uploads are limited by count alone, so frame-indexed test runs do not depend on timing.
+    int maxGpuUploadsPerFrame = 64;
     int workerThreads = 2;
     bool enabled = true;
+    ChunkLodConfig lod;
+    UploadBudgetConfig uploadBudget;
+    StreamingBudgetConfig budget;
+    ChunkPrefetchConfig prefetch;
+    // Unloaded chunks are kept here and put back when they are wanted again.
+    ChunkCacheConfig cache;
 };
 
+// Spans between a chunk's pipeline milestones. Waits are time spent queued (upload wait includes frames
+// held back by the upload budget); runs are worker time. Visible runs from the chunk first becoming
+// desired to its first upload, empty meshes included.
+enum class PipelineStage : std::size_t {
+    Visible = 0,
+    GenerateWait,
+    Generate,
+    MeshWait,
+    Light,
+    Mesh,
+    UploadWait,
+    Count
+};
+
+inline constexpr std::size_t kPipelineStageCount = static_cast<std::size_t>(PipelineStage::Count);
+
+// Also the slice name in exported traces, where each uploaded chunk gets an async track of its stages.
+const char* PipelineStageName(PipelineStage stage);
+
 struct ChunkStreamingStats {
     ChunkCoord playerChunk{0, 0, 0};
+    // Registry entries and chunks in the render list, updated every tick.
     std::size_t loadedChunks = 0;
+    std::size_t gpuReadyChunks = 0;
+    // Entries per state, updated only by ChunkStreaming::TakeCensus (which also recounts the two above).
     std::size_t generatedChunksReady = 0;
     std::size_t meshedCpuReady = 0;
-    std::size_t gpuReadyChunks = 0;
     std::size_t createQueue = 0;
     std::size_t meshQueue = 0;
     std::size_t uploadQueue = 0;
     std::size_t workerThreads = 0;
+    // Desired chunks still waiting on generation, meshing, upload or a LOD switch.
+    std::size_t pendingChunks = 0;
+    // Chunks loaded ahead of the player's motion beyond the load radius box.
+    std::size_t prefetchChunks = 0;
+    ChunkCacheStats cache;
     int createdThisFrame = 0;
     int meshedThisFrame = 0;
     int uploadedThisFrame = 0;
+    int lodSwitchesThisFrame = 0;
+    std::size_t uploadedBytesThisFrame = 0;
+    std::size_t uploadBudgetBytes = 0;
+    double uploadBytesPerMs = 0.0;
+    // Uploaded chunks per LOD ring; census only.
+    std::array<std::size_t, kLodLevelCount> lodChunks{};
+    // Per PipelineStage, over the last one to two latency windows.
+    std::array<core::LatencyPercentiles, kPipelineStageCount> pipeline{};
+    // Limits used this frame and the smoothed inputs that chose them.
+    StreamingBudgets budgets{};
+    bool adaptiveBudgets = false;
+    double targetFrameMs = 0.0;
+    double frameMs = 0.0;
+    double uploadMs = 0.0;
+    double workerIdle = -1.0;
+    // Process-wide MemoryLedger snapshot taken with the rest of the stats.
+    core::MemorySnapshot memory{};
 };
 
 class ChunkStreaming {
@@ -59,43 +180,116 @@ public:
     void Tick(const ChunkCoord& playerChunk, ChunkRegistry& registry, const ChunkMesher& mesher);
     void SetProfiler(core::Profiler* profiler);
     void SetWorkerThreads(std::size_t workerThreads);
+    // Worker idle share since the last frame (WorkerPool::SampleIdleRatio), read by the next Tick.
+    void SetWorkerIdleRatio(double idleRatio);
+    // Player velocity and camera direction for prefetching, read by the next Tick.
+    void SetMotion(const StreamingMotion& motion);
     void SetStorage(persistence::ChunkStorage* storage);
+    // Where uploads go; the renderer passes its MeshArena.
+    void SetMeshStore(MeshStore* store);
+
+    core::MpmcQueue<GenerateJob>& GenerateQueue();
+    core::MpmcQueue<MeshJob>& MeshQueue();
+    core::MpmcQueue<MeshReady>& UploadQueue();
 
-    core::ThreadSafeQueue<GenerateJob>& GenerateQueue();
-    core::ThreadSafeQueue<MeshJob>& MeshQueue();
-    core::ThreadSafeQueue<MeshReady>& UploadQueue();
+    // Chunks with a non-empty GPU mesh, maintained by uploads and unloads on the main thread.
+    const renderer::ChunkRenderList& RenderList() const;
 
     const ChunkStreamingConfig& Config() const;
     const ChunkStreamingStats& Stats() const;
+    // Walks the registry to count entries per state. Tick never does this, so per-frame cost stays with
+    // the changes; call it where the counts are reported (soak and interaction summaries, F4).
+    void TakeCensus(const ChunkRegistry& registry);
 
+    // Never waits on a full mesh ring; the remesh is then retried from the pending list.
     bool RequestRemesh(const ChunkCoord& coord, ChunkRegistry& registry);
+    // Releases the cached chunks; call before ChunkRegistry::DestroyAll on the main thread.
+    void ClearCache(ChunkRegistry& registry);
 
 private:
+    struct PendingChunk {
+        ChunkCoord coord;
+        std::shared_ptr<ChunkEntry> entry;
+    };
+
     void ProcessUploads(ChunkRegistry& registry);
-    void BuildDesiredSet(const ChunkCoord& playerChunk);
+    void UpdateDesiredRegion(const ChunkCoord& playerChunk, ChunkRegistry& registry);
+    void AddPending(const ChunkCoord& coord, const std::shared_ptr<ChunkEntry>& entry);
+    // Queues a mesh job without waiting; false when the mesh ring is full.
+    bool PushMeshJob(const ChunkCoord& coord, const std::shared_ptr<ChunkEntry>& entry, std::uint64_t flow);
+    int TargetLod(const ChunkCoord& coord, const ChunkEntry& entry) const;
+    // Stores the LOD for the next mesh build and re-pends meshed neighbours whose border culling changes.
+    void SetTargetLod(const ChunkCoord& coord, ChunkEntry& entry, int lod, ChunkRegistry& registry);
+    // True when a horizontal neighbour is meshed at full detail and so needs this chunk's light.
+    bool NearFullDetail(const ChunkCoord& coord, const ChunkRegistry& registry) const;
+    std::size_t EstimateChunkBytes() const;
+    // The entry for a coord entering the region: the loaded one, the cached one, or a new one.
+    std::shared_ptr<ChunkEntry> LoadChunk(const ChunkCoord& coord, ChunkRegistry& registry);
+    void UnloadChunk(const ChunkCoord& coord, ChunkRegistry& registry);
     void UnloadOutOfRange(ChunkRegistry& registry);
     void EnqueueMissing(ChunkRegistry& registry);
 
     bool IsDesired(const ChunkCoord& coord) const;
     void UpdateStats(const ChunkRegistry& registry);
+    void RecordPipelineLatency(ChunkTimeline& timeline, const MeshTiming& mesh);
     void WarnIfQueuesLarge();
 
     ChunkStreamingConfig config_;
     ChunkStreamingStats stats_;
 
-    std::vector<ChunkCoord> desiredCoords_;
-    std::unordered_set<ChunkCoord, ChunkCoordHash> desiredSet_;
+    // Only the slabs that enter and leave are visited when the region moves; pending_ holds entered
+    // chunks until they are uploaded at their target LOD, so a settled world costs nothing per frame.
+    ChunkRegion desiredRegion_;
+    // desiredRegion_ grown by unloadMargin; chunks are unloaded when they leave this one.
+    ChunkRegion keepRegion_;
+    ChunkCoord regionCenter_{0, 0, 0};
+    StreamingMotion motion_;
+    PrefetchPlan prefetch_;
+    std::vector<PendingChunk> pending_;
+    // Set until the first full registry sweep removes chunks loaded outside the region.
+    bool needsSweep_ = true;
+    // Registry entries the streamer loaded itself; any more were created elsewhere and trigger a sweep.
+    std::size_t expectedLoaded_ = 0;
+    ChunkCache cache_;
+    std::vector<std::shared_ptr<ChunkEntry>> evicted_;
     std::vector<ChunkCoord> unloadList_;
+    renderer::ChunkRenderList renderList_;
+    UploadBudget uploadBudget_;
+    StreamingBudget budget_;
+    // Filled in during a frame and fed to budget_ at the start of the next one.
+    StreamingFrameSample frameSample_;
+    std::int64_t lastTickNs_ = 0;
+    double workerIdle_ = -1.0;
+    // Popped upload that did not fit the previous frame's budget; goes first next frame.
+    std::optional<MeshReady> heldUpload_;
+
+    core::MpmcQueue<GenerateJob> generateQueue_;
+    core::MpmcQueue<MeshJob> meshQueue_;
+    core::MpmcQueue<MeshReady> uploadQueue_;
 
-    core::ThreadSafeQueue<GenerateJob> generateQueue_;
-    core::ThreadSafeQueue<MeshJob> meshQueue_;
-    core::ThreadSafeQueue<MeshReady> uploadQueue_;
+    std::array<core::LatencyWindow, kPipelineStageCount> pipelineLatency_{};
+    std::chrono::steady_clock::time_point pipelineWindowStart_ = std::chrono::steady_clock::now();
 
     core::Profiler* profiler_ = nullptr;
     persistence::ChunkStorage* storage_ = nullptr;
+    MeshStore* meshStore_ = nullptr;
     bool warnedGenerateQueue_ = false;
     bool warnedMeshQueue_ = false;
     bool warnedUploadQueue_ = false;
 };
 
+// "[Pipeline] p50/p99 ms visible a/b | gen wait a/b run a/b | mesh wait a/b light a/b run a/b |
+// upload wait a/b": where chunks spend their time between becoming desired and reaching the GPU.
+std::string DescribePipeline(const ChunkStreamingStats& stats);
+
+// "[Upload] n chunks x/y KiB z MiB/s": this frame's uploads against the adaptive byte budget.
+std::string DescribeUploads(const ChunkStreamingStats& stats);
+
+// "[Budget] adaptive creates c meshes m uploads u | frame x/target ms upload y ms | workers idle z% |
+// pending n | prefetch +p"
+std::string DescribeBudgets(const ChunkStreamingStats& stats);
+
+// "[Cache] n chunks x MiB | hits h misses m (r% hit) | evictions e"
+std::string DescribeCache(const ChunkStreamingStats& stats);
+
 } // namespace voxel
@@ -0,0 +1,188 @@
+#include "voxel/ChunkVisibility.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "math/Frustum.h"
+#include "voxel/BlockId.h"
+#include "voxel/BlockRegistry.h"
+#include "voxel/ChunkBounds.h"
+
+namespace voxel {
+
+namespace {
+
+constexpr std::array<ChunkCoord, 6> kFaceSteps = {{
+    {1, 0, 0},
+    {-1, 0, 0},
+    {0, 1, 0},
+    {0, -1, 0},
+    {0, 0, 1},
+    {0, 0, -1},
+}};
+
+constexpr std::size_t Opposite(std::size_t face) {
+    return face ^ 1u;
+}
+
+constexpr std::uint16_t ToIndex(int x, int y, int z) {
+    return static_cast<std::uint16_t>(x + kChunkSize * (y + kChunkSize * z));
+}
+
+// Faces of the chunk that voxel (x, y, z) lies on, as a bit mask.
+std::uint8_t BoundaryFaces(int x, int y, int z) {
+    unsigned faces = 0;
+    faces |= x == kChunkSize - 1 ? 0x01u : 0u;
+    faces |= x == 0 ? 0x02u : 0u;
+    faces |= y == kChunkSize - 1 ? 0x04u : 0u;
+    faces |= y == 0 ? 0x08u : 0u;
+    faces |= z == kChunkSize - 1 ? 0x10u : 0u;
+    faces |= z == 0 ? 0x20u : 0u;
+    return static_cast<std::uint8_t>(faces);
+}
+
+} // namespace
+
+ChunkVisibility ChunkVisibility::Open() {
+    ChunkVisibility visibility;
+    visibility.connected.fill(0x3F);
+    return visibility;
+}
+
+ChunkVisibility ComputeChunkVisibility(const Chunk& chunk, std::vector<std::uint16_t>& scratch) {
+    static_assert(kChunkVolume <= 0x10000, "Flood-fill indices are 16-bit.");
+    const BlockId* blocks = chunk.Data();
+    std::array<std::uint64_t, kChunkVolume / 64> seen{};
+    auto markSeen = [&seen](std::uint16_t index) {
+        const std::uint64_t bit = std::uint64_t{1} << (index & 63u);
+        std::uint64_t& word = seen[index >> 6];
+        const bool wasSeen = (word & bit) != 0;
+        word |= bit;
+        return wasSeen;
+    };
+
+    const BlockRegistry& registry = BlockRegistry::Default();
+    ChunkVisibility visibility;
+    // Only voxels on the chunk boundary can start a region that touches a face.
+    for (int z = 0; z < kChunkSize; ++z) {
+        for (int y = 0; y < kChunkSize; ++y) {
+            for (int x = 0; x < kChunkSize; ++x) {
+                if (BoundaryFaces(x, y, z) == 0) {
+                    continue;
+                }
+                const std::uint16_t start = ToIndex(x, y, z);
+                if (registry.IsOpaque(blocks[start]) || markSeen(start)) {
+                    continue;
+                }
+
+                unsigned touched = 0;
+                scratch.clear();
+                scratch.push_back(start);
+                while (!scratch.empty()) {
+                    const std::uint16_t index = scratch.back();
+                    scratch.pop_back();
+                    const int vx = index % kChunkSize;
+                    const int vy = (index / kChunkSize) % kChunkSize;
+                    const int vz = index / (kChunkSize * kChunkSize);
+                    touched |= BoundaryFaces(vx, vy, vz);
+
+                    const auto visit = [&](int nx, int ny, int nz) {
+                        const std::uint16_t next = ToIndex(nx, ny, nz);
+                        if (!registry.IsOpaque(blocks[next]) && !markSeen(next)) {
+                            scratch.push_back(next);
+                        }
+                    };
+                    if (vx + 1 < kChunkSize) {
+                        visit(vx + 1, vy, vz);
+                    }
+                    if (vx > 0) {
+                        visit(vx - 1, vy, vz);
+                    }
+                    if (vy + 1 < kChunkSize) {
+                        visit(vx, vy + 1, vz);
+                    }
+                    if (vy > 0) {
+                        visit(vx, vy - 1, vz);
+                    }
+                    if (vz + 1 < kChunkSize) {
+                        visit(vx, vy, vz + 1);
+                    }
+                    if (vz > 0) {
+                        visit(vx, vy, vz - 1);
+                    }
+                }
+
+                for (std::size_t face = 0; face < visibility.connected.size(); ++face) {
+                    if ((touched >> face) & 1u) {
+                        visibility.connected[face] = static_cast<std::uint8_t>(visibility.connected[face] | touched);
+                    }
+                }
+            }
+        }
+    }
+    return visibility;
+}
+
+void VisibilityGraph::Clear() {
+    nodes_.clear();
+}
+
+void VisibilityGraph::SetVisibility(const ChunkCoord& coord, const ChunkVisibility& visibility) {
+    nodes_[coord].visibility = visibility;
+}
+
+OcclusionStats VisibilityGraph::Traverse(const ChunkCoord& cameraChunk, const Frustum* frustum, int horizontalRadius,
+                                         int verticalRadius) {
+    ++pass_;
+    OcclusionStats stats;
+    queue_.clear();
+    Node& cameraNode = nodes_[cameraChunk];
+    cameraNode.visitedPass = pass_;
+    cameraNode.reachablePass = pass_;
+    queue_.push_back({cameraChunk, -1, 0});
+
+    while (!queue_.empty()) {
+        const Step step = queue_.front();
+        queue_.pop_front();
+        ++stats.reachable;
+        const ChunkVisibility visibility = nodes_[step.coord].visibility;
+
+        for (std::size_t face = 0; face < kFaceSteps.size(); ++face) {
+            if ((step.travelled >> Opposite(face)) & 1u) {
+                continue;
+            }
+            if (step.enteredFace >= 0 && !visibility.Connects(static_cast<std::size_t>(step.enteredFace), face)) {
+                continue;
+            }
+            const ChunkCoord next{step.coord.x + kFaceSteps[face].x, step.coord.y + kFaceSteps[face].y,
+                                  step.coord.z + kFaceSteps[face].z};
+            if (std::max(std::abs(next.x - cameraChunk.x), std::abs(next.z - cameraChunk.z)) > horizontalRadius ||
+                std::abs(next.y - cameraChunk.y) > verticalRadius) {
+                continue;
+            }
+            Node& node = nodes_[next];
+            if (node.visitedPass == pass_) {
+                continue;
+            }
+            node.visitedPass = pass_;
+            ++stats.visited;
+            if (frustum != nullptr) {
+                const ChunkBounds bounds = GetChunkBounds(next);
+                if (!frustum->IntersectsAabb(bounds.min, bounds.max)) {
+                    continue;
+                }
+            }
+            node.reachablePass = pass_;
+            queue_.push_back({next, static_cast<int>(Opposite(face)),
+                              static_cast<std::uint8_t>(step.travelled | (1u << face))});
+        }
+    }
+    return stats;
+}
+
+bool VisibilityGraph::IsReachable(const ChunkCoord& coord) const {
+    const auto it = nodes_.find(coord);
+    return it != nodes_.end() && it->second.reachablePass == pass_;
+}
+
+} // namespace voxel
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "voxel/Chunk.h"
+#include "voxel/ChunkCoord.h"
+
+class Frustum;
+
+namespace voxel {
+
+// Which of the six chunk faces (kBlockFaces order: +X, -X, +Y, -Y, +Z, -Z) can see each other
+// through connected non-opaque voxels. connected[a] has bit b set when faces a and b connect.
+struct ChunkVisibility {
+    std::array<std::uint8_t, 6> connected{};
+
+    static ChunkVisibility Open();
+    bool Connects(std::size_t from, std::size_t to) const { return (connected[from] >> to) & 1u; }
+};
+
+// Flood-fills the non-opaque voxels (air, torches) inside a chunk. scratch is a reusable stack (pooled with the mesh scratch).
+ChunkVisibility ComputeChunkVisibility(const Chunk& chunk, std::vector<std::uint16_t>& scratch);
+
+struct OcclusionStats {
+    std::size_t visited = 0;
+    std::size_t reachable = 0;
+};
+
+// Breadth-first walk over chunks from the camera chunk: a chunk is reachable when some path of
+// neighbours that never turns back toward the camera enters and leaves every chunk through
+// connected faces. Chunks without a known visibility (unloaded, not yet meshed) are treated as open.
+class VisibilityGraph {
+public:
+    void Clear();
+    void SetVisibility(const ChunkCoord& coord, const ChunkVisibility& visibility);
+
+    // frustum may be null. Walks at most horizontalRadius chunks (Chebyshev, XZ) and verticalRadius
+    // chunks vertically from the camera chunk.
+    OcclusionStats Traverse(const ChunkCoord& cameraChunk, const Frustum* frustum, int horizontalRadius,
+                            int verticalRadius);
+    bool IsReachable(const ChunkCoord& coord) const;
+
+private:
+    struct Node {
+        ChunkVisibility visibility = ChunkVisibility::Open();
+        std::uint64_t visitedPass = 0;
+        std::uint64_t reachablePass = 0;
+    };
+
+    struct Step {
+        ChunkCoord coord;
+        int enteredFace = -1;
+        std::uint8_t travelled = 0;
+    };
+
+    std::unordered_map<ChunkCoord, Node, ChunkCoordHash> nodes_;
+    std::deque<Step> queue_;
+    std::uint64_t pass_ = 0;
+};
+
+} // namespace voxel
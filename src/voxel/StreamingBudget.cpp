@@ -0,0 +1,90 @@
+#include "voxel/StreamingBudget.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace voxel {
+
+namespace {
+
+double Grow(double value, double step, int maxValue) {
+    return std::min(value + step, static_cast<double>(maxValue));
+}
+
+double Shrink(double value, double factor, int minValue) {
+    return std::max(value * factor, static_cast<double>(minValue));
+}
+
+} // namespace
+
+StreamingBudget::StreamingBudget(const StreamingBudgetConfig& config, const StreamingBudgets& initial)
+    : config_(config) {
+    config_.minCreates = std::max(1, config_.minCreates);
+    config_.minMeshes = std::max(1, config_.minMeshes);
+    config_.minUploads = std::max(1, config_.minUploads);
+    config_.maxCreates = std::max(config_.minCreates, config_.maxCreates);
+    config_.maxMeshes = std::max(config_.minMeshes, config_.maxMeshes);
+    config_.maxUploads = std::max(config_.minUploads, config_.maxUploads);
+    if (!config_.adaptive) {
+        current_ = initial;
+        return;
+    }
+    creates_ = std::clamp(initial.creates, config_.minCreates, config_.maxCreates);
+    meshes_ = std::clamp(initial.meshes, config_.minMeshes, config_.maxMeshes);
+    uploads_ = std::clamp(initial.uploads, config_.minUploads, config_.maxUploads);
+    Publish();
+}
+
+void StreamingBudget::Update(const StreamingFrameSample& sample) {
+    if (sample.frameMs <= 0.0) {
+        return;
+    }
+    frameMs_ = frameMs_ == 0.0 ? sample.frameMs : frameMs_ + config_.smoothing * (sample.frameMs - frameMs_);
+    uploadMs_ = uploadMs_ + config_.smoothing * (sample.uploadMs - uploadMs_);
+    if (sample.workerIdle >= 0.0) {
+        workerIdle_ = workerIdle_ < 0.0 ? sample.workerIdle
+                                        : workerIdle_ + config_.smoothing * (sample.workerIdle - workerIdle_);
+    }
+    if (!config_.adaptive) {
+        return;
+    }
+
+    if (frameMs_ > config_.targetFrameMs * (1.0 + config_.overshoot)) {
+        if (uploadMs_ > config_.targetFrameMs * config_.uploadShare) {
+            uploads_ = Shrink(uploads_, config_.shrinkFactor, config_.minUploads);
+        } else {
+            creates_ = Shrink(creates_, config_.shrinkFactor, config_.minCreates);
+            meshes_ = Shrink(meshes_, config_.shrinkFactor, config_.minMeshes);
+            uploads_ = Shrink(uploads_, config_.shrinkFactor, config_.minUploads);
+        }
+        Publish();
+        return;
+    }
+
+    const bool workersIdle = workerIdle_ < 0.0 || workerIdle_ >= config_.workerIdleToGrow;
+    const bool workersSaturated = workerIdle_ >= 0.0 && workerIdle_ < config_.workerSaturated;
+    if (workersSaturated) {
+        // More jobs would only lengthen the queues and the wait of every chunk behind them.
+        creates_ = Shrink(creates_, config_.shrinkFactor, config_.minCreates);
+        meshes_ = Shrink(meshes_, config_.shrinkFactor, config_.minMeshes);
+    } else if (workersIdle) {
+        if (sample.createBacklog) {
+            creates_ = Grow(creates_, config_.growStep, config_.maxCreates);
+        }
+        if (sample.meshBacklog) {
+            meshes_ = Grow(meshes_, config_.growStep, config_.maxMeshes);
+        }
+    }
+    if (sample.uploadBacklog) {
+        uploads_ = Grow(uploads_, config_.uploadGrowStep, config_.maxUploads);
+    }
+    Publish();
+}
+
+void StreamingBudget::Publish() {
+    current_.creates = static_cast<int>(std::lround(creates_));
+    current_.meshes = static_cast<int>(std::lround(meshes_));
+    current_.uploads = static_cast<int>(std::lround(uploads_));
+}
+
+} // namespace voxel
@@ -0,0 +1,76 @@
+#pragma once
+
+namespace voxel {
+
+struct StreamingBudgetConfig {
+    // Off keeps the configured per-frame limits fixed (deterministic test runs).
+    bool adaptive = true;
+    double targetFrameMs = 16.6;
+    // Smoothed frames more than this fraction over the target count as over budget.
+    double overshoot = 0.05;
+    // Over budget, uploads are cut first when they took more than this share of the target frame.
+    double uploadShare = 0.15;
+    // Workers idler than this can take more jobs; below workerSaturated extra jobs only queue up.
+    double workerIdleToGrow = 0.2;
+    double workerSaturated = 0.05;
+    // Weight of the newest frame in the frame time, upload time and worker idle averages.
+    double smoothing = 0.1;
+    // Additive growth per frame with headroom and multiplicative decay per frame over budget.
+    double growStep = 0.25;
+    double uploadGrowStep = 1.0;
+    double shrinkFactor = 0.9;
+    int minCreates = 1;
+    int maxCreates = 16;
+    int minMeshes = 1;
+    int maxMeshes = 16;
+    int minUploads = 4;
+    int maxUploads = 256;
+};
+
+// Per-frame job limits; creates and meshes are per vertical layer, as in ChunkStreamingConfig.
+struct StreamingBudgets {
+    int creates = 0;
+    int meshes = 0;
+    int uploads = 0;
+};
+
+// What the previous frame measured. Backlogs say the limit, not the work, ended that pass.
+struct StreamingFrameSample {
+    double frameMs = 0.0;
+    double uploadMs = 0.0;
+    // Share of worker time spent idle, 0..1; negative when unknown.
+    double workerIdle = -1.0;
+    bool createBacklog = false;
+    bool meshBacklog = false;
+    bool uploadBacklog = false;
+};
+
+// AIMD controller for the streaming limits. While smoothed frames stay under the target, a limit that
+// ran out grows by its step per frame (creates and meshes only while workers have idle time to run the
+// jobs); over the target, limits decay by shrinkFactor per frame, uploads first when they are the
+// expensive part of the frame.
+class StreamingBudget {
+public:
+    StreamingBudget(const StreamingBudgetConfig& config, const StreamingBudgets& initial);
+
+    void Update(const StreamingFrameSample& sample);
+
+    const StreamingBudgets& Current() const { return current_; }
+    double FrameMs() const { return frameMs_; }
+    double UploadMs() const { return uploadMs_; }
+    double WorkerIdle() const { return workerIdle_; }
+
+private:
+    void Publish();
+
+    StreamingBudgetConfig config_;
+    StreamingBudgets current_;
+    double creates_ = 0.0;
+    double meshes_ = 0.0;
+    double uploads_ = 0.0;
+    double frameMs_ = 0.0;
+    double uploadMs_ = 0.0;
+    double workerIdle_ = -1.0;
+};
+
+} // namespace voxel
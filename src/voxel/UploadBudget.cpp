@@ -0,0 +1,36 @@
+#include "voxel/UploadBudget.h"
+
+#include <algorithm>
+
+namespace voxel {
+
+namespace {
+// Timer resolution noise dominates below this, so such frames say little about throughput.
+constexpr double kMinSampleMs = 0.02;
+} // namespace
+
+UploadBudget::UploadBudget(const UploadBudgetConfig& config) : config_(config) {
+    config_.minBytes = std::max<std::size_t>(1, config_.minBytes);
+    config_.maxBytes = std::max(config_.minBytes, config_.maxBytes);
+    frameBytes_ = std::clamp(config_.initialBytes, config_.minBytes, config_.maxBytes);
+}
+
+bool UploadBudget::Allows(std::size_t usedBytes, std::size_t nextBytes, double elapsedMs) const {
+    if (usedBytes == 0) {
+        return true;
+    }
+    return usedBytes + nextBytes <= frameBytes_ && elapsedMs < config_.targetMs;
+}
+
+void UploadBudget::Record(std::size_t bytes, double elapsedMs) {
+    if (bytes == 0 || elapsedMs < kMinSampleMs) {
+        return;
+    }
+    const double sample = static_cast<double>(bytes) / elapsedMs;
+    bytesPerMs_ = bytesPerMs_ == 0.0 ? sample : bytesPerMs_ + config_.smoothing * (sample - bytesPerMs_);
+    const double target = bytesPerMs_ * config_.targetMs;
+    frameBytes_ = static_cast<std::size_t>(
+        std::clamp(target, static_cast<double>(config_.minBytes), static_cast<double>(config_.maxBytes)));
+}
+
+} // namespace voxel
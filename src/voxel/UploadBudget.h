@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+
+namespace voxel {
+
+struct UploadBudgetConfig {
+    // Upload time allowed per frame; the byte limit follows measured throughput times this.
+    double targetMs = 1.5;
+    std::size_t initialBytes = 2u << 20;
+    std::size_t minBytes = 256u << 10;
+    std::size_t maxBytes = 32u << 20;
+    // Weight of the newest frame in the throughput average.
+    double smoothing = 0.2;
+};
+
+// Per-frame mesh upload budget in bytes and time. The byte limit adapts to the throughput measured
+// over the span Metric::Upload times, so a dense chunk gets a frame to itself while small ones batch.
+class UploadBudget {
+public:
+    explicit UploadBudget(const UploadBudgetConfig& config = {});
+
+    // Whether nextBytes may follow usedBytes already uploaded elapsedMs into the frame. The first
+    // upload of a frame always fits so an oversized mesh cannot stall the queue.
+    bool Allows(std::size_t usedBytes, std::size_t nextBytes, double elapsedMs) const;
+
+    // Feeds one frame's uploaded bytes and time; frames that uploaded nothing are ignored.
+    void Record(std::size_t bytes, double elapsedMs);
+
+    std::size_t FrameBytes() const { return frameBytes_; }
+    double BytesPerMs() const { return bytesPerMs_; }
+
+private:
+    UploadBudgetConfig config_;
+    std::size_t frameBytes_ = 0;
+    double bytesPerMs_ = 0.0;
+};
+
+} // namespace voxel
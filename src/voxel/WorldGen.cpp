@@ -1,14 +1,28 @@
 #include "voxel/WorldGen.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MINECLONE_WORLDGEN_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#define MINECLONE_WORLDGEN_AVX2 1
+#include <immintrin.h>
+#endif
 
 namespace voxel {
 
 namespace {
 
-constexpr std::uint32_t kTerrainSeed = 0x9E3779B9u;
+constexpr std::uint32_t kBiomeSalt = 0xB10E5EEDu;
+constexpr std::uint32_t kCaveSalt = 0xCA7E5EEDu;
+constexpr int kMaxBiomes = 255;
 
 float Fade(float t) {
     return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
@@ -18,12 +32,7 @@ float Lerp(float a, float b, float t) {
     return a + (b - a) * t;
 }
 
-std::uint32_t Hash2D(int x, int z) {
-    std::uint32_t hx = static_cast<std::uint32_t>(x);
-    std::uint32_t hz = static_cast<std::uint32_t>(z);
-    std::uint32_t h = kTerrainSeed;
-    h ^= hx + 0x9e3779b9u + (h << 6) + (h >> 2);
-    h ^= hz + 0x85ebca6bu + (h << 6) + (h >> 2);
+std::uint32_t Finalize(std::uint32_t h) {
     h ^= h >> 16;
     h *= 0x7feb352du;
     h ^= h >> 15;
@@ -32,12 +41,38 @@ std::uint32_t Hash2D(int x, int z) {
     return h;
 }
 
-float RandomValue(int x, int z) {
-    constexpr float invMax = 1.0f / static_cast<float>(std::numeric_limits<std::uint32_t>::max());
-    return static_cast<float>(Hash2D(x, z)) * invMax;
+std::uint32_t MixSeed(std::uint32_t seed, std::uint32_t salt) {
+    return Finalize(seed ^ (salt * 0x9E3779B9u));
 }
 
-float ValueNoise(float x, float z, float scale) {
+std::uint32_t Hash2D(std::uint32_t seed, int x, int z) {
+    std::uint32_t hx = static_cast<std::uint32_t>(x);
+    std::uint32_t hz = static_cast<std::uint32_t>(z);
+    std::uint32_t h = seed;
+    h ^= hx + 0x9e3779b9u + (h << 6) + (h >> 2);
+    h ^= hz + 0x85ebca6bu + (h << 6) + (h >> 2);
+    return Finalize(h);
+}
+
+std::uint32_t Hash3D(std::uint32_t seed, int x, int y, int z) {
+    std::uint32_t h = seed;
+    h ^= static_cast<std::uint32_t>(x) + 0x9e3779b9u + (h << 6) + (h >> 2);
+    h ^= static_cast<std::uint32_t>(y) + 0x7f4a7c15u + (h << 6) + (h >> 2);
+    h ^= static_cast<std::uint32_t>(z) + 0x85ebca6bu + (h << 6) + (h >> 2);
+    return Finalize(h);
+}
+
+constexpr float kInvHashMax = 1.0f / static_cast<float>(std::numeric_limits<std::uint32_t>::max());
+
+float RandomValue(std::uint32_t seed, int x, int z) {
+    return static_cast<float>(Hash2D(seed, x, z)) * kInvHashMax;
+}
+
+float RandomValue3D(std::uint32_t seed, int x, int y, int z) {
+    return static_cast<float>(Hash3D(seed, x, y, z)) * kInvHashMax;
+}
+
+float ValueNoise(std::uint32_t seed, float x, float z, float scale) {
     const float xf = x / scale;
     const float zf = z / scale;
     const int x0 = static_cast<int>(std::floor(xf));
@@ -48,49 +83,539 @@ float ValueNoise(float x, float z, float scale) {
     const float tx = Fade(xf - static_cast<float>(x0));
     const float tz = Fade(zf - static_cast<float>(z0));
 
-    const float v00 = RandomValue(x0, z0);
-    const float v10 = RandomValue(x1, z0);
-    const float v01 = RandomValue(x0, z1);
-    const float v11 = RandomValue(x1, z1);
+    const float v00 = RandomValue(seed, x0, z0);
+    const float v10 = RandomValue(seed, x1, z0);
+    const float v01 = RandomValue(seed, x0, z1);
+    const float v11 = RandomValue(seed, x1, z1);
 
     const float vx0 = Lerp(v00, v10, tx);
     const float vx1 = Lerp(v01, v11, tx);
     return Lerp(vx0, vx1, tz);
 }
 
-int SampleHeight(int x, int z) {
-    constexpr float baseHeight = 10.0f;
-    constexpr float amplitude = 14.0f;
-    const float noiseLow = ValueNoise(static_cast<float>(x), static_cast<float>(z), 64.0f);
-    const float noiseHigh = ValueNoise(static_cast<float>(x), static_cast<float>(z), 24.0f);
-    const float noise = noiseLow * 0.65f + noiseHigh * 0.35f;
-    return static_cast<int>(std::round(baseHeight + (noise * 2.0f - 1.0f) * amplitude));
+float CaveFade(int offset, int cellSize) {
+    return Fade(static_cast<float>(offset) / static_cast<float>(cellSize));
+}
+
+// Trilinear blend of the 8 lattice corners, x first, then z, then y. Shared by the per-voxel and
+// per-chunk cave paths so both round identically.
+float BlendCorners(const float (&c)[8], float tx, float ty, float tz) {
+    const float x00 = Lerp(c[0], c[1], tx);
+    const float x10 = Lerp(c[2], c[3], tx);
+    const float x01 = Lerp(c[4], c[5], tx);
+    const float x11 = Lerp(c[6], c[7], tx);
+    const float z0 = Lerp(x00, x10, tz);
+    const float z1 = Lerp(x01, x11, tz);
+    return Lerp(z0, z1, ty);
+}
+
+// The SIMD lanes below replay ValueNoise operation-for-operation (same division, floor and
+// evaluation order, exact uint32->float conversion), so their results are bit-identical to it.
+#if defined(MINECLONE_WORLDGEN_SSE2)
+struct Sse2Lanes {
+    static constexpr int kWidth = 4;
+    using F = __m128;
+    using I = __m128i;
+
+    static F Set(float v) { return _mm_set1_ps(v); }
+    static I SetI(std::uint32_t v) { return _mm_set1_epi32(static_cast<int>(v)); }
+    static I Ramp(int start, int step) {
+        return _mm_setr_epi32(start, start + step, start + 2 * step, start + 3 * step);
+    }
+    static F Add(F a, F b) { return _mm_add_ps(a, b); }
+    static F Sub(F a, F b) { return _mm_sub_ps(a, b); }
+    static F Mul(F a, F b) { return _mm_mul_ps(a, b); }
+    static F Div(F a, F b) { return _mm_div_ps(a, b); }
+    static I AddI(I a, I b) { return _mm_add_epi32(a, b); }
+    static I Xor(I a, I b) { return _mm_xor_si128(a, b); }
+    static I And(I a, I b) { return _mm_and_si128(a, b); }
+    template <int N> static I Shl(I a) { return _mm_slli_epi32(a, N); }
+    template <int N> static I Shr(I a) { return _mm_srli_epi32(a, N); }
+    static F ToFloat(I a) { return _mm_cvtepi32_ps(a); }
+    static I Truncate(F a) { return _mm_cvttps_epi32(a); }
+    static I MaskGt(F a, F b) { return _mm_castps_si128(_mm_cmpgt_ps(a, b)); }
+    static void Store(float* out, F a) { _mm_storeu_ps(out, a); }
+
+    static I MulLo(I a, I b) {
+        const __m128i even = _mm_mul_epu32(a, b);
+        const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                  _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    }
+};
+#endif
+
+#if defined(MINECLONE_WORLDGEN_AVX2)
+struct Avx2Lanes {
+    static constexpr int kWidth = 8;
+    using F = __m256;
+    using I = __m256i;
+
+    static F Set(float v) { return _mm256_set1_ps(v); }
+    static I SetI(std::uint32_t v) { return _mm256_set1_epi32(static_cast<int>(v)); }
+    static I Ramp(int start, int step) {
+        return _mm256_setr_epi32(start, start + step, start + 2 * step, start + 3 * step, start + 4 * step,
+                                 start + 5 * step, start + 6 * step, start + 7 * step);
+    }
+    static F Add(F a, F b) { return _mm256_add_ps(a, b); }
+    static F Sub(F a, F b) { return _mm256_sub_ps(a, b); }
+    static F Mul(F a, F b) { return _mm256_mul_ps(a, b); }
+    static F Div(F a, F b) { return _mm256_div_ps(a, b); }
+    static I AddI(I a, I b) { return _mm256_add_epi32(a, b); }
+    static I Xor(I a, I b) { return _mm256_xor_si256(a, b); }
+    static I And(I a, I b) { return _mm256_and_si256(a, b); }
+    template <int N> static I Shl(I a) { return _mm256_slli_epi32(a, N); }
+    template <int N> static I Shr(I a) { return _mm256_srli_epi32(a, N); }
+    static F ToFloat(I a) { return _mm256_cvtepi32_ps(a); }
+    static I Truncate(F a) { return _mm256_cvttps_epi32(a); }
+    static I MaskGt(F a, F b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+    static void Store(float* out, F a) { _mm256_storeu_ps(out, a); }
+    static I MulLo(I a, I b) { return _mm256_mullo_epi32(a, b); }
+};
+#endif
+
+template <typename L>
+typename L::F LaneRandomValue(std::uint32_t seed, typename L::I x, typename L::I z) {
+    const std::uint32_t seedMix = 0x9e3779b9u + (seed << 6) + (seed >> 2);
+    typename L::I h = L::Xor(L::SetI(seed), L::AddI(x, L::SetI(seedMix)));
+    h = L::Xor(h, L::AddI(L::AddI(L::AddI(z, L::SetI(0x85ebca6bu)), L::template Shl<6>(h)), L::template Shr<2>(h)));
+    h = L::Xor(h, L::template Shr<16>(h));
+    h = L::MulLo(h, L::SetI(0x7feb352du));
+    h = L::Xor(h, L::template Shr<15>(h));
+    h = L::MulLo(h, L::SetI(0x846ca68bu));
+    h = L::Xor(h, L::template Shr<16>(h));
+
+    // Exact uint32 -> float: both halves convert exactly, so the sum rounds once like a scalar cast.
+    const typename L::F high = L::Mul(L::ToFloat(L::template Shr<16>(h)), L::Set(65536.0f));
+    const typename L::F low = L::ToFloat(L::And(h, L::SetI(0xFFFFu)));
+    return L::Mul(L::Add(high, low), L::Set(kInvHashMax));
+}
+
+template <typename L>
+typename L::F LaneFade(typename L::F t) {
+    const typename L::F t3 = L::Mul(L::Mul(t, t), t);
+    const typename L::F inner = L::Add(L::Mul(t, L::Sub(L::Mul(t, L::Set(6.0f)), L::Set(15.0f))), L::Set(10.0f));
+    return L::Mul(t3, inner);
+}
+
+template <typename L>
+typename L::F LaneLerp(typename L::F a, typename L::F b, typename L::F t) {
+    return L::Add(a, L::Mul(L::Sub(b, a), t));
+}
+
+template <typename L>
+typename L::F LaneValueNoise(std::uint32_t seed, typename L::F x, typename L::F z, float scale) {
+    const typename L::F xf = L::Div(x, L::Set(scale));
+    const typename L::F zf = L::Div(z, L::Set(scale));
+    typename L::I x0 = L::Truncate(xf);
+    typename L::I z0 = L::Truncate(zf);
+    x0 = L::AddI(x0, L::MaskGt(L::ToFloat(x0), xf));
+    z0 = L::AddI(z0, L::MaskGt(L::ToFloat(z0), zf));
+    const typename L::I one = L::SetI(1u);
+    const typename L::I x1 = L::AddI(x0, one);
+    const typename L::I z1 = L::AddI(z0, one);
+
+    const typename L::F tx = LaneFade<L>(L::Sub(xf, L::ToFloat(x0)));
+    const typename L::F tz = LaneFade<L>(L::Sub(zf, L::ToFloat(z0)));
+
+    const typename L::F v00 = LaneRandomValue<L>(seed, x0, z0);
+    const typename L::F v10 = LaneRandomValue<L>(seed, x1, z0);
+    const typename L::F v01 = LaneRandomValue<L>(seed, x0, z1);
+    const typename L::F v11 = LaneRandomValue<L>(seed, x1, z1);
+
+    const typename L::F vx0 = LaneLerp<L>(v00, v10, tx);
+    const typename L::F vx1 = LaneLerp<L>(v01, v11, tx);
+    return LaneLerp<L>(vx0, vx1, tz);
+}
+
+struct NoiseStages {
+    const std::vector<NoiseOctave>& octaves;
+    const std::vector<std::uint32_t>& octaveSeeds;
+    std::uint32_t biomeSeed;
+    float biomeScale;
+};
+
+float SampleOctaves(const NoiseStages& stages, float x, float z) {
+    float noise = 0.0f;
+    for (std::size_t i = 0; i < stages.octaves.size(); ++i) {
+        noise = noise + ValueNoise(stages.octaveSeeds[i], x, z, stages.octaves[i].scale) * stages.octaves[i].weight;
+    }
+    return noise;
+}
+
+// Fills noise/selector for columns [0, n) of a row; returns how many were produced with full lanes.
+template <typename L>
+int SampleStagesLanes(const NoiseStages& stages, int x0, int z, int n, int step, float* noiseOut,
+                      float* selectorOut) {
+    const typename L::F zLane = L::ToFloat(L::SetI(static_cast<std::uint32_t>(z)));
+    int x = 0;
+    for (; x + L::kWidth <= n; x += L::kWidth) {
+        const typename L::F xLane = L::ToFloat(L::Ramp(x0 + x * step, step));
+        typename L::F noise = L::Set(0.0f);
+        for (std::size_t i = 0; i < stages.octaves.size(); ++i) {
+            const typename L::F octave = LaneValueNoise<L>(stages.octaveSeeds[i], xLane, zLane, stages.octaves[i].scale);
+            noise = L::Add(noise, L::Mul(octave, L::Set(stages.octaves[i].weight)));
+        }
+        L::Store(noiseOut + x, noise);
+        L::Store(selectorOut + x, LaneValueNoise<L>(stages.biomeSeed, xLane, zLane, stages.biomeScale));
+    }
+    return x;
+}
+
+std::uint64_t ColumnKey(int chunkX, int chunkZ) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkX)) << 32) |
+           static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkZ));
 }
 
 } // namespace
 
-int GetSurfaceHeight(int x, int z) {
-    return SampleHeight(x, z);
+WorldGenConfig WorldGenConfigForVersion(std::uint32_t version, std::uint32_t seed) {
+    WorldGenConfig config;
+    config.seed = seed;
+    if (version == kWorldGenLegacy) {
+        config.version = kWorldGenLegacy;
+        config.biomes = {{0.5f, 1.0f, 0.0f, kBlockDirt, kBlockDirt, 3}};
+        config.caves.enabled = false;
+    }
+    return config;
 }
 
-BlockId SampleFlatWorld(const WorldBlockCoord& coord) {
+WorldGenerator::WorldGenerator(WorldGenConfig config) : config_(std::move(config)) {
+    if (config_.biomes.empty()) {
+        config_.biomes.push_back(BiomeLayer{});
+    }
+    if (config_.biomes.size() > static_cast<std::size_t>(kMaxBiomes)) {
+        config_.biomes.resize(static_cast<std::size_t>(kMaxBiomes));
+    }
+    std::stable_sort(config_.biomes.begin(), config_.biomes.end(),
+                     [](const BiomeLayer& a, const BiomeLayer& b) { return a.anchor < b.anchor; });
+    for (BiomeLayer& biome : config_.biomes) {
+        biome.fillerDepth = std::max(0, biome.fillerDepth);
+        maxFillerDepth_ = std::max(maxFillerDepth_, biome.fillerDepth);
+    }
+    for (CaveOctave& octave : config_.caves.octaves) {
+        octave.cellSize = std::max(1, octave.cellSize);
+    }
+    config_.caves.minDepth = std::max(0, config_.caves.minDepth);
+    config_.columnCacheCapacity = std::max<std::size_t>(1, config_.columnCacheCapacity);
+
+    for (std::size_t i = 0; i < config_.octaves.size(); ++i) {
+        // Legacy terrain hashed every octave with the raw seed.
+        octaveSeeds_.push_back(config_.version == kWorldGenLegacy
+                                   ? config_.seed
+                                   : MixSeed(config_.seed, static_cast<std::uint32_t>(i + 1)));
+    }
+    for (std::size_t i = 0; i < config_.caves.octaves.size(); ++i) {
+        caveSeeds_.push_back(MixSeed(config_.seed ^ kCaveSalt, static_cast<std::uint32_t>(i + 1)));
+    }
+    biomeSeed_ = MixSeed(config_.seed, kBiomeSalt);
+}
+
+WorldGenerator::HeightSample WorldGenerator::CombineStages(float noise, float selector) const {
+    const std::vector<BiomeLayer>& biomes = config_.biomes;
+    float relief = biomes.back().relief;
+    float offset = biomes.back().heightOffset;
+    std::size_t biome = biomes.size() - 1;
+    if (selector <= biomes.front().anchor) {
+        relief = biomes.front().relief;
+        offset = biomes.front().heightOffset;
+        biome = 0;
+    } else {
+        for (std::size_t i = 0; i + 1 < biomes.size(); ++i) {
+            const BiomeLayer& lower = biomes[i];
+            const BiomeLayer& upper = biomes[i + 1];
+            if (selector < upper.anchor) {
+                const float t = (selector - lower.anchor) / (upper.anchor - lower.anchor);
+                relief = Lerp(lower.relief, upper.relief, t);
+                offset = Lerp(lower.heightOffset, upper.heightOffset, t);
+                biome = t < 0.5f ? i : i + 1;
+                break;
+            }
+        }
+    }
+
+    const float height = config_.baseHeight + offset + (noise * 2.0f - 1.0f) * config_.amplitude * relief;
+    return HeightSample{static_cast<int>(std::round(height)), static_cast<std::uint8_t>(biome)};
+}
+
+WorldGenerator::HeightSample WorldGenerator::SampleColumn(int x, int z) const {
+    const NoiseStages stages{config_.octaves, octaveSeeds_, biomeSeed_, config_.biomeScale};
+    const float xf = static_cast<float>(x);
+    const float zf = static_cast<float>(z);
+    return CombineStages(SampleOctaves(stages, xf, zf), ValueNoise(biomeSeed_, xf, zf, config_.biomeScale));
+}
+
+int WorldGenerator::SurfaceHeight(int x, int z) const {
+    return SampleColumn(x, z).height;
+}
+
+std::uint8_t WorldGenerator::BiomeAt(int x, int z) const {
+    return SampleColumn(x, z).biome;
+}
+
+BlockId WorldGenerator::ColumnBlock(int y, int surfaceHeight, std::uint8_t biome) const {
+    if (y >= kWorldMaxY) {
+        return kBlockAir;
+    }
+    if (y <= kWorldMinY) {
+        return kBlockStone;
+    }
+    if (y > surfaceHeight) {
+        return kBlockAir;
+    }
+    const BiomeLayer& layer = config_.biomes[biome];
+    if (y == surfaceHeight) {
+        return layer.topBlock;
+    }
+    if (y >= surfaceHeight - layer.fillerDepth) {
+        return layer.fillerBlock;
+    }
+    return kBlockStone;
+}
+
+bool WorldGenerator::IsCaveCandidate(int y, int surfaceHeight) const {
+    return config_.caves.enabled && y > kWorldMinY + 1 && y < kWorldMaxY &&
+           y <= surfaceHeight - config_.caves.minDepth;
+}
+
+float WorldGenerator::CaveDensity(int x, int y, int z) const {
+    float density = 0.0f;
+    for (std::size_t i = 0; i < config_.caves.octaves.size(); ++i) {
+        const int cell = config_.caves.octaves[i].cellSize;
+        const int cx = floor_div(x, cell);
+        const int cy = floor_div(y, cell);
+        const int cz = floor_div(z, cell);
+        const std::uint32_t seed = caveSeeds_[i];
+        const float corners[8] = {
+            RandomValue3D(seed, cx, cy, cz),         RandomValue3D(seed, cx + 1, cy, cz),
+            RandomValue3D(seed, cx, cy, cz + 1),     RandomValue3D(seed, cx + 1, cy, cz + 1),
+            RandomValue3D(seed, cx, cy + 1, cz),     RandomValue3D(seed, cx + 1, cy + 1, cz),
+            RandomValue3D(seed, cx, cy + 1, cz + 1), RandomValue3D(seed, cx + 1, cy + 1, cz + 1),
+        };
+        const float value = BlendCorners(corners, CaveFade(floor_mod(x, cell), cell),
+                                         CaveFade(floor_mod(y, cell), cell), CaveFade(floor_mod(z, cell), cell));
+        density = density + value * config_.caves.octaves[i].weight;
+    }
+    return density;
+}
+
+BlockId WorldGenerator::SampleBlock(const WorldBlockCoord& coord) const {
     if (coord.y >= kWorldMaxY) {
         return kBlockAir;
     }
     if (coord.y <= kWorldMinY) {
         return kBlockStone;
     }
-    const int height = GetSurfaceHeight(coord.x, coord.z);
-    if (coord.y > height) {
+    const HeightSample column = SampleColumn(coord.x, coord.z);
+    const BlockId block = ColumnBlock(coord.y, column.height, column.biome);
+    if (block != kBlockAir && IsCaveCandidate(coord.y, column.height) &&
+        CaveDensity(coord.x, coord.y, coord.z) > config_.caves.threshold) {
         return kBlockAir;
     }
-    if (coord.y == height) {
-        return kBlockDirt;
+    return block;
+}
+
+void WorldGenerator::SampleHeightColumns(int x0, int z0, int width, int depth, int* outHeights,
+                                         std::uint8_t* outBiomes, int step) const {
+    constexpr int kSegment = 64;
+    const NoiseStages stages{config_.octaves, octaveSeeds_, biomeSeed_, config_.biomeScale};
+    float noise[kSegment];
+    float selector[kSegment];
+    for (int dz = 0; dz < depth; ++dz) {
+        const int z = z0 + dz * step;
+        const std::ptrdiff_t rowOffset = static_cast<std::ptrdiff_t>(dz) * width;
+        for (int segment = 0; segment < width; segment += kSegment) {
+            const int n = std::min(kSegment, width - segment);
+            const int segmentX = x0 + segment * step;
+            int dx = 0;
+#if defined(MINECLONE_WORLDGEN_AVX2)
+            dx = SampleStagesLanes<Avx2Lanes>(stages, segmentX, z, n, step, noise, selector);
+#elif defined(MINECLONE_WORLDGEN_SSE2)
+            dx = SampleStagesLanes<Sse2Lanes>(stages, segmentX, z, n, step, noise, selector);
+#endif
+            for (; dx < n; ++dx) {
+                const float xf = static_cast<float>(segmentX + dx * step);
+                const float zf = static_cast<float>(z);
+                noise[dx] = SampleOctaves(stages, xf, zf);
+                selector[dx] = ValueNoise(biomeSeed_, xf, zf, config_.biomeScale);
+            }
+            for (int i = 0; i < n; ++i) {
+                const HeightSample sample = CombineStages(noise[i], selector[i]);
+                outHeights[rowOffset + segment + i] = sample.height;
+                if (outBiomes) {
+                    outBiomes[rowOffset + segment + i] = sample.biome;
+                }
+            }
+        }
     }
-    if (coord.y >= height - 3) {
-        return kBlockDirt;
+}
+
+std::shared_ptr<const ColumnData> WorldGenerator::Column(int chunkX, int chunkZ) const {
+    const std::uint64_t key = ColumnKey(chunkX, chunkZ);
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto it = cache_.find(key);
+        if (it != cache_.end()) {
+            cacheLru_.splice(cacheLru_.begin(), cacheLru_, it->second.lruIt);
+            ++cacheHits_;
+            return it->second.data;
+        }
     }
-    return kBlockStone;
+
+    auto column = std::make_shared<ColumnData>();
+    SampleHeightColumns(chunkX * kChunkSize, chunkZ * kChunkSize, kChunkSize, kChunkSize, column->heights.data(),
+                        column->biomes.data());
+    const auto [minIt, maxIt] = std::minmax_element(column->heights.begin(), column->heights.end());
+    column->minHeight = *minIt;
+    column->maxHeight = *maxIt;
+
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    ++cacheMisses_;
+    auto [it, inserted] = cache_.try_emplace(key);
+    if (!inserted) {
+        // Another worker built the same column meanwhile; both results are identical.
+        return it->second.data;
+    }
+    cacheLru_.push_front(key);
+    it->second = CachedColumn{column, cacheLru_.begin()};
+    while (cache_.size() > config_.columnCacheCapacity) {
+        cache_.erase(cacheLru_.back());
+        cacheLru_.pop_back();
+    }
+    return column;
+}
+
+ColumnCacheStats WorldGenerator::CacheStats() const {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return ColumnCacheStats{cacheHits_, cacheMisses_, cache_.size()};
+}
+
+void WorldGenerator::GenerateChunk(const ChunkCoord& coord, Chunk& chunk) const {
+    const std::shared_ptr<const ColumnData> column = Column(coord.x, coord.z);
+    const int originY = coord.y * kChunkSize;
+
+    BlockId* data = chunk.Data();
+    for (int z = 0; z < kChunkSize; ++z) {
+        const int* rowHeights = column->heights.data() + kChunkSize * z;
+        const std::uint8_t* rowBiomes = column->biomes.data() + kChunkSize * z;
+        const auto [minIt, maxIt] = std::minmax_element(rowHeights, rowHeights + kChunkSize);
+        const int minHeight = *minIt;
+        const int maxHeight = *maxIt;
+
+        for (int y = 0; y < kChunkSize; ++y) {
+            const int worldY = originY + y;
+            BlockId* row = data + static_cast<std::size_t>(kChunkSize * (y + kChunkSize * z));
+            if (worldY >= kWorldMaxY || worldY > maxHeight) {
+                std::fill_n(row, kChunkSize, kBlockAir);
+                continue;
+            }
+            if (worldY <= kWorldMinY || worldY < minHeight - maxFillerDepth_) {
+                std::fill_n(row, kChunkSize, kBlockStone);
+                continue;
+            }
+            for (int x = 0; x < kChunkSize; ++x) {
+                row[x] = ColumnBlock(worldY, rowHeights[x], rowBiomes[x]);
+            }
+        }
+    }
+
+    if (config_.caves.enabled && !config_.caves.octaves.empty() &&
+        originY <= column->maxHeight - config_.caves.minDepth) {
+        CarveCaves(coord, *column, chunk);
+    }
+}
+
+void WorldGenerator::CarveCaves(const ChunkCoord& coord, const ColumnData& column, Chunk& chunk) const {
+    struct AxisSample {
+        int cell = 0;
+        float t = 0.0f;
+    };
+    struct OctaveLattice {
+        std::array<AxisSample, kChunkSize> x;
+        std::array<AxisSample, kChunkSize> y;
+        std::array<AxisSample, kChunkSize> z;
+        int sizeX = 0;
+        int sizeY = 0;
+        std::vector<float> values;
+
+        float At(int ix, int iy, int iz) const {
+            return values[static_cast<std::size_t>(ix + sizeX * (iy + sizeY * iz))];
+        }
+    };
+
+    const WorldBlockCoord origin = ChunkLocalToWorld(coord, LocalCoord{0, 0, 0}, kChunkSize);
+    const int topY = std::min(kChunkSize - 1, column.maxHeight - config_.caves.minDepth - origin.y);
+
+    // Lattice corner values are hashed once per chunk instead of eight times per voxel.
+    std::vector<OctaveLattice> lattices(config_.caves.octaves.size());
+    for (std::size_t i = 0; i < lattices.size(); ++i) {
+        const int cellSize = config_.caves.octaves[i].cellSize;
+        OctaveLattice& lattice = lattices[i];
+        const int baseX = floor_div(origin.x, cellSize);
+        const int baseY = floor_div(origin.y, cellSize);
+        const int baseZ = floor_div(origin.z, cellSize);
+        for (int l = 0; l < kChunkSize; ++l) {
+            lattice.x[static_cast<std::size_t>(l)] = {floor_div(origin.x + l, cellSize) - baseX,
+                                                      CaveFade(floor_mod(origin.x + l, cellSize), cellSize)};
+            lattice.y[static_cast<std::size_t>(l)] = {floor_div(origin.y + l, cellSize) - baseY,
+                                                      CaveFade(floor_mod(origin.y + l, cellSize), cellSize)};
+            lattice.z[static_cast<std::size_t>(l)] = {floor_div(origin.z + l, cellSize) - baseZ,
+                                                      CaveFade(floor_mod(origin.z + l, cellSize), cellSize)};
+        }
+        lattice.sizeX = lattice.x.back().cell + 2;
+        lattice.sizeY = lattice.y.back().cell + 2;
+        const int sizeZ = lattice.z.back().cell + 2;
+        lattice.values.resize(static_cast<std::size_t>(lattice.sizeX * lattice.sizeY * sizeZ));
+        for (int iz = 0; iz < sizeZ; ++iz) {
+            for (int iy = 0; iy < lattice.sizeY; ++iy) {
+                for (int ix = 0; ix < lattice.sizeX; ++ix) {
+                    lattice.values[static_cast<std::size_t>(ix + lattice.sizeX * (iy + lattice.sizeY * iz))] =
+                        RandomValue3D(caveSeeds_[i], baseX + ix, baseY + iy, baseZ + iz);
+                }
+            }
+        }
+    }
+
+    BlockId* data = chunk.Data();
+    for (int z = 0; z < kChunkSize; ++z) {
+        for (int y = 0; y <= topY; ++y) {
+            const int worldY = origin.y + y;
+            BlockId* row = data + static_cast<std::size_t>(kChunkSize * (y + kChunkSize * z));
+            for (int x = 0; x < kChunkSize; ++x) {
+                if (row[x] == kBlockAir ||
+                    !IsCaveCandidate(worldY, column.heights[static_cast<std::size_t>(x + kChunkSize * z)])) {
+                    continue;
+                }
+                float density = 0.0f;
+                for (std::size_t i = 0; i < lattices.size(); ++i) {
+                    const OctaveLattice& lattice = lattices[i];
+                    const AxisSample& ax = lattice.x[static_cast<std::size_t>(x)];
+                    const AxisSample& ay = lattice.y[static_cast<std::size_t>(y)];
+                    const AxisSample& az = lattice.z[static_cast<std::size_t>(z)];
+                    const float corners[8] = {
+                        lattice.At(ax.cell, ay.cell, az.cell),         lattice.At(ax.cell + 1, ay.cell, az.cell),
+                        lattice.At(ax.cell, ay.cell, az.cell + 1),     lattice.At(ax.cell + 1, ay.cell, az.cell + 1),
+                        lattice.At(ax.cell, ay.cell + 1, az.cell),     lattice.At(ax.cell + 1, ay.cell + 1, az.cell),
+                        lattice.At(ax.cell, ay.cell + 1, az.cell + 1), lattice.At(ax.cell + 1, ay.cell + 1, az.cell + 1),
+                    };
+                    density = density + BlendCorners(corners, ax.t, ay.t, az.t) * config_.caves.octaves[i].weight;
+                }
+                if (density > config_.caves.threshold) {
+                    row[x] = kBlockAir;
+                }
+            }
+        }
+    }
+}
+
+const char* HeightColumnsBackend() {
+#if defined(MINECLONE_WORLDGEN_AVX2)
+    return "avx2";
+#elif defined(MINECLONE_WORLDGEN_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
 }
 
 } // namespace voxel
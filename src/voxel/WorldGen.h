@@ -1,15 +1,152 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include "voxel/BlockId.h"
+#include "voxel/Chunk.h"
+#include "voxel/ChunkCoord.h"
 #include "voxel/VoxelCoords.h"
 
 namespace voxel {
 
 constexpr int kWorldMinY = -32;
 constexpr int kWorldMaxY = 64;
+constexpr std::uint32_t kDefaultWorldSeed = 0x9E3779B9u;
+// Generator versions persisted per world. Legacy is the terrain saved before the layered pipeline
+// (two height octaves on the raw seed, dirt over stone, no biomes or caves).
+constexpr std::uint32_t kWorldGenLegacy = 1;
+constexpr std::uint32_t kWorldGenLayered = 2;
+constexpr std::uint32_t kWorldGenVersion = kWorldGenLayered;
+constexpr int kColumnArea = kChunkSize * kChunkSize;
+
+struct NoiseOctave {
+    float scale = 64.0f;
+    float weight = 1.0f;
+};
+
+// Biomes are anchored on a low-frequency selector noise in [0, 1]. Relief and height offset blend
+// linearly between neighbouring anchors; block layers come from the nearest anchor.
+struct BiomeLayer {
+    float anchor = 0.5f;
+    float relief = 1.0f;
+    float heightOffset = 0.0f;
+    BlockId topBlock = kBlockDirt;
+    BlockId fillerBlock = kBlockDirt;
+    int fillerDepth = 3;
+};
+
+struct CaveOctave {
+    int cellSize = 16;
+    float weight = 1.0f;
+};
+
+struct CaveConfig {
+    bool enabled = true;
+    std::vector<CaveOctave> octaves = {{16, 0.7f}, {8, 0.3f}};
+    float threshold = 0.72f;
+    // Blocks directly below the surface that are never carved.
+    int minDepth = 4;
+};
+
+struct WorldGenConfig {
+    std::uint32_t version = kWorldGenVersion;
+    std::uint32_t seed = kDefaultWorldSeed;
+    float baseHeight = 10.0f;
+    float amplitude = 14.0f;
+    std::vector<NoiseOctave> octaves = {{64.0f, 0.65f}, {24.0f, 0.35f}};
+    float biomeScale = 192.0f;
+    std::vector<BiomeLayer> biomes = {
+        {0.3f, 0.45f, -2.0f, kBlockDirt, kBlockDirt, 5},
+        {0.5f, 1.0f, 0.0f, kBlockDirt, kBlockDirt, 3},
+        {0.7f, 1.6f, 5.0f, kBlockStone, kBlockStone, 0},
+    };
+    CaveConfig caves;
+    std::size_t columnCacheCapacity = 2048;
+};
+
+// Default config for a persisted generator version; unknown versions fall back to the current one.
+WorldGenConfig WorldGenConfigForVersion(std::uint32_t version, std::uint32_t seed);
+
+// 2D stages for one chunk column, indexed x + kChunkSize * z; shared by every chunk stacked on it.
+struct ColumnData {
+    std::array<int, kColumnArea> heights{};
+    std::array<std::uint8_t, kColumnArea> biomes{};
+    int minHeight = 0;
+    int maxHeight = 0;
+};
+
+struct ColumnCacheStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::size_t size = 0;
+};
+
+// Seeded terrain pipeline: octave height noise -> biome layers -> column blocks -> 3D caves.
+// All sampling is deterministic for a given config; methods are safe to call from worker threads.
+class WorldGenerator {
+public:
+    explicit WorldGenerator(WorldGenConfig config = {});
+
+    WorldGenerator(const WorldGenerator&) = delete;
+    WorldGenerator& operator=(const WorldGenerator&) = delete;
+
+    const WorldGenConfig& Config() const { return config_; }
+
+    int SurfaceHeight(int x, int z) const;
+    std::uint8_t BiomeAt(int x, int z) const;
+
+    // Per-voxel reference path; GenerateChunk produces identical blocks.
+    BlockId SampleBlock(const WorldBlockCoord& coord) const;
+
+    // Batched SurfaceHeight over a width x depth grid of columns step blocks apart, starting at (x0, z0);
+    // out[x + width * z]. The noise stages are vectorized with SSE2/AVX2 where the build enables them,
+    // bit-identical to the scalar path.
+    void SampleHeightColumns(int x0, int z0, int width, int depth, int* outHeights,
+                             std::uint8_t* outBiomes = nullptr, int step = 1) const;
+
+    std::shared_ptr<const ColumnData> Column(int chunkX, int chunkZ) const;
+    void GenerateChunk(const ChunkCoord& coord, Chunk& chunk) const;
+
+    ColumnCacheStats CacheStats() const;
+
+private:
+    struct HeightSample {
+        int height = 0;
+        std::uint8_t biome = 0;
+    };
+
+    struct CachedColumn {
+        std::shared_ptr<const ColumnData> data;
+        std::list<std::uint64_t>::iterator lruIt;
+    };
+
+    HeightSample CombineStages(float noise, float selector) const;
+    HeightSample SampleColumn(int x, int z) const;
+    BlockId ColumnBlock(int y, int surfaceHeight, std::uint8_t biome) const;
+    bool IsCaveCandidate(int y, int surfaceHeight) const;
+    float CaveDensity(int x, int y, int z) const;
+    void CarveCaves(const ChunkCoord& coord, const ColumnData& column, Chunk& chunk) const;
+
+    WorldGenConfig config_;
+    std::vector<std::uint32_t> octaveSeeds_;
+    std::vector<std::uint32_t> caveSeeds_;
+    std::uint32_t biomeSeed_ = 0;
+    int maxFillerDepth_ = 0;
 
-int GetSurfaceHeight(int x, int z);
+    mutable std::mutex cacheMutex_;
+    mutable std::list<std::uint64_t> cacheLru_;
+    mutable std::unordered_map<std::uint64_t, CachedColumn> cache_;
+    mutable std::uint64_t cacheHits_ = 0;
+    mutable std::uint64_t cacheMisses_ = 0;
+};
 
-BlockId SampleFlatWorld(const WorldBlockCoord& coord);
+const char* HeightColumnsBackend();
 
 } // namespace voxel
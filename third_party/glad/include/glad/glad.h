@@ -43,6 +43,7 @@ typedef short GLhalf;
 typedef float GLclampf;
 typedef double GLclampd;
 typedef int GLsizei;
+typedef struct __GLsync *GLsync;
 
 typedef void (APIENTRY *GLDEBUGPROC)(GLenum source, GLenum type, GLuint id, GLenum severity,
                                      GLsizei length, const GLchar *message, const void *userParam);
@@ -57,8 +58,27 @@ typedef void (APIENTRY *GLDEBUGPROC)(GLenum source, GLenum type, GLuint id, GLen
 #define GL_CONTEXT_FLAG_DEBUG_BIT 0x00000002
 
 #define GL_ARRAY_BUFFER 0x8892
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#define GL_COPY_READ_BUFFER 0x8F36
+#define GL_COPY_WRITE_BUFFER 0x8F37
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
 #define GL_STATIC_DRAW 0x88E4
 
+#define GL_MAP_WRITE_BIT 0x0002
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_COHERENT_BIT 0x0080
+
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_WAIT_FAILED 0x911D
+
+#define GL_BYTE 0x1400
+#define GL_UNSIGNED_SHORT 0x1403
+#define GL_UNSIGNED_INT 0x1405
+
 #define GL_FLOAT 0x1406
 
 #define GL_TRIANGLES 0x0004
@@ -67,11 +87,13 @@ typedef void (APIENTRY *GLDEBUGPROC)(GLenum source, GLenum type, GLuint id, GLen
 #define GL_DEPTH_BUFFER_BIT 0x00000100
 
 #define GL_TEXTURE_2D 0x0DE1
+#define GL_TEXTURE_2D_ARRAY 0x8C1A
 #define GL_TEXTURE_MIN_FILTER 0x2801
 #define GL_TEXTURE_MAG_FILTER 0x2800
 #define GL_TEXTURE_WRAP_S 0x2802
 #define GL_TEXTURE_WRAP_T 0x2803
 #define GL_NEAREST 0x2600
+#define GL_NEAREST_MIPMAP_LINEAR 0x2702
 #define GL_REPEAT 0x2901
 #define GL_CLAMP_TO_EDGE 0x812F
 
@@ -184,6 +206,26 @@ typedef void (APIENTRY *PFNGLDELETEVERTEXARRAYSPROC)(GLsizei n, const GLuint *ar
 typedef void (APIENTRY *PFNGLDELETEBUFFERSPROC)(GLsizei n, const GLuint *buffers);
 typedef void (APIENTRY *PFNGLGETINTEGERVPROC)(GLenum pname, GLint *data);
 typedef void (APIENTRY *PFNGLDEBUGMESSAGECALLBACKPROC)(GLDEBUGPROC callback, const void *userParam);
+typedef void (APIENTRY *PFNGLBUFFERSTORAGEPROC)(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags);
+typedef void *(APIENTRY *PFNGLMAPBUFFERRANGEPROC)(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+typedef GLboolean (APIENTRY *PFNGLUNMAPBUFFERPROC)(GLenum target);
+typedef void (APIENTRY *PFNGLCOPYBUFFERSUBDATAPROC)(GLenum readTarget, GLenum writeTarget, GLintptr readOffset,
+                                                    GLintptr writeOffset, GLsizeiptr size);
+typedef void (APIENTRY *PFNGLDRAWELEMENTSBASEVERTEXPROC)(GLenum mode, GLsizei count, GLenum type, const void *indices,
+                                                        GLint basevertex);
+typedef void (APIENTRY *PFNGLMULTIDRAWELEMENTSINDIRECTPROC)(GLenum mode, GLenum type, const void *indirect,
+                                                          GLsizei drawcount, GLsizei stride);
+typedef GLsync (APIENTRY *PFNGLFENCESYNCPROC)(GLenum condition, GLbitfield flags);
+typedef GLenum (APIENTRY *PFNGLCLIENTWAITSYNCPROC)(GLsync sync, GLbitfield flags, GLuint64 timeout);
+typedef void (APIENTRY *PFNGLDELETESYNCPROC)(GLsync sync);
+typedef void (APIENTRY *PFNGLTEXSTORAGE3DPROC)(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width,
+                                              GLsizei height, GLsizei depth);
+typedef void (APIENTRY *PFNGLTEXSUBIMAGE3DPROC)(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset,
+                                               GLsizei width, GLsizei height, GLsizei depth, GLenum format,
+                                               GLenum type, const void *pixels);
+typedef void (APIENTRY *PFNGLGENERATEMIPMAPPROC)(GLenum target);
+typedef void (APIENTRY *PFNGLVERTEXATTRIBIPOINTERPROC)(GLuint index, GLint size, GLenum type, GLsizei stride,
+                                                      const void *pointer);
 typedef void (APIENTRY *PFNGLDEBUGMESSAGECONTROLPROC)(GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint *ids, GLboolean enabled);
 
 GLAPI PFNGLGETSTRINGPROC glad_glGetString;
@@ -246,6 +288,19 @@ GLAPI PFNGLDELETEBUFFERSPROC glad_glDeleteBuffers;
 GLAPI PFNGLGETINTEGERVPROC glad_glGetIntegerv;
 GLAPI PFNGLDEBUGMESSAGECALLBACKPROC glad_glDebugMessageCallback;
 GLAPI PFNGLDEBUGMESSAGECONTROLPROC glad_glDebugMessageControl;
+GLAPI PFNGLBUFFERSTORAGEPROC glad_glBufferStorage;
+GLAPI PFNGLMAPBUFFERRANGEPROC glad_glMapBufferRange;
+GLAPI PFNGLUNMAPBUFFERPROC glad_glUnmapBuffer;
+GLAPI PFNGLCOPYBUFFERSUBDATAPROC glad_glCopyBufferSubData;
+GLAPI PFNGLDRAWELEMENTSBASEVERTEXPROC glad_glDrawElementsBaseVertex;
+GLAPI PFNGLMULTIDRAWELEMENTSINDIRECTPROC glad_glMultiDrawElementsIndirect;
+GLAPI PFNGLFENCESYNCPROC glad_glFenceSync;
+GLAPI PFNGLCLIENTWAITSYNCPROC glad_glClientWaitSync;
+GLAPI PFNGLDELETESYNCPROC glad_glDeleteSync;
+GLAPI PFNGLTEXSTORAGE3DPROC glad_glTexStorage3D;
+GLAPI PFNGLTEXSUBIMAGE3DPROC glad_glTexSubImage3D;
+GLAPI PFNGLGENERATEMIPMAPPROC glad_glGenerateMipmap;
+GLAPI PFNGLVERTEXATTRIBIPOINTERPROC glad_glVertexAttribIPointer;
 
 #define glGetString glad_glGetString
 #define glClearColor glad_glClearColor
@@ -305,6 +360,19 @@ GLAPI PFNGLDEBUGMESSAGECONTROLPROC glad_glDebugMessageControl;
 #define glGetIntegerv glad_glGetIntegerv
 #define glDebugMessageCallback glad_glDebugMessageCallback
 #define glDebugMessageControl glad_glDebugMessageControl
+#define glBufferStorage glad_glBufferStorage
+#define glMapBufferRange glad_glMapBufferRange
+#define glUnmapBuffer glad_glUnmapBuffer
+#define glCopyBufferSubData glad_glCopyBufferSubData
+#define glDrawElementsBaseVertex glad_glDrawElementsBaseVertex
+#define glMultiDrawElementsIndirect glad_glMultiDrawElementsIndirect
+#define glFenceSync glad_glFenceSync
+#define glClientWaitSync glad_glClientWaitSync
+#define glDeleteSync glad_glDeleteSync
+#define glTexStorage3D glad_glTexStorage3D
+#define glTexSubImage3D glad_glTexSubImage3D
+#define glGenerateMipmap glad_glGenerateMipmap
+#define glVertexAttribIPointer glad_glVertexAttribIPointer
 
 #ifdef __cplusplus
 }
@@ -63,6 +63,19 @@ PFNGLDELETEBUFFERSPROC glad_glDeleteBuffers = NULL;
 PFNGLGETINTEGERVPROC glad_glGetIntegerv = NULL;
 PFNGLDEBUGMESSAGECALLBACKPROC glad_glDebugMessageCallback = NULL;
 PFNGLDEBUGMESSAGECONTROLPROC glad_glDebugMessageControl = NULL;
+PFNGLBUFFERSTORAGEPROC glad_glBufferStorage = NULL;
+PFNGLMAPBUFFERRANGEPROC glad_glMapBufferRange = NULL;
+PFNGLUNMAPBUFFERPROC glad_glUnmapBuffer = NULL;
+PFNGLCOPYBUFFERSUBDATAPROC glad_glCopyBufferSubData = NULL;
+PFNGLDRAWELEMENTSBASEVERTEXPROC glad_glDrawElementsBaseVertex = NULL;
+PFNGLMULTIDRAWELEMENTSINDIRECTPROC glad_glMultiDrawElementsIndirect = NULL;
+PFNGLFENCESYNCPROC glad_glFenceSync = NULL;
+PFNGLCLIENTWAITSYNCPROC glad_glClientWaitSync = NULL;
+PFNGLDELETESYNCPROC glad_glDeleteSync = NULL;
+PFNGLTEXSTORAGE3DPROC glad_glTexStorage3D = NULL;
+PFNGLTEXSUBIMAGE3DPROC glad_glTexSubImage3D = NULL;
+PFNGLGENERATEMIPMAPPROC glad_glGenerateMipmap = NULL;
+PFNGLVERTEXATTRIBIPOINTERPROC glad_glVertexAttribIPointer = NULL;
 
 static void *glad_get_proc(GLADloadproc load, const char *name) {
     return (void *)load(name);
@@ -133,6 +146,20 @@ int gladLoadGLLoader(GLADloadproc load) {
     glad_glGetIntegerv = (PFNGLGETINTEGERVPROC)glad_get_proc(load, "glGetIntegerv");
     glad_glDebugMessageCallback = (PFNGLDEBUGMESSAGECALLBACKPROC)glad_get_proc(load, "glDebugMessageCallback");
     glad_glDebugMessageControl = (PFNGLDEBUGMESSAGECONTROLPROC)glad_get_proc(load, "glDebugMessageControl");
+    glad_glBufferStorage = (PFNGLBUFFERSTORAGEPROC)glad_get_proc(load, "glBufferStorage");
+    glad_glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)glad_get_proc(load, "glMapBufferRange");
+    glad_glUnmapBuffer = (PFNGLUNMAPBUFFERPROC)glad_get_proc(load, "glUnmapBuffer");
+    glad_glCopyBufferSubData = (PFNGLCOPYBUFFERSUBDATAPROC)glad_get_proc(load, "glCopyBufferSubData");
+    glad_glDrawElementsBaseVertex = (PFNGLDRAWELEMENTSBASEVERTEXPROC)glad_get_proc(load, "glDrawElementsBaseVertex");
+    glad_glMultiDrawElementsIndirect =
+        (PFNGLMULTIDRAWELEMENTSINDIRECTPROC)glad_get_proc(load, "glMultiDrawElementsIndirect");
+    glad_glFenceSync = (PFNGLFENCESYNCPROC)glad_get_proc(load, "glFenceSync");
+    glad_glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)glad_get_proc(load, "glClientWaitSync");
+    glad_glDeleteSync = (PFNGLDELETESYNCPROC)glad_get_proc(load, "glDeleteSync");
+    glad_glTexStorage3D = (PFNGLTEXSTORAGE3DPROC)glad_get_proc(load, "glTexStorage3D");
+    glad_glTexSubImage3D = (PFNGLTEXSUBIMAGE3DPROC)glad_get_proc(load, "glTexSubImage3D");
+    glad_glGenerateMipmap = (PFNGLGENERATEMIPMAPPROC)glad_get_proc(load, "glGenerateMipmap");
+    glad_glVertexAttribIPointer = (PFNGLVERTEXATTRIBIPOINTERPROC)glad_get_proc(load, "glVertexAttribIPointer");
 
     if (!glad_glGetString || !glad_glClearColor || !glad_glClear || !glad_glEnable || !glad_glDisable ||
         !glad_glGetError || !glad_glCullFace ||
@@ -151,7 +178,10 @@ int gladLoadGLLoader(GLADloadproc load) {
         !glad_glDeleteRenderbuffers || !glad_glDeleteFramebuffers || !glad_glFinish || !glad_glPixelStorei ||
         !glad_glReadBuffer || !glad_glReadPixels || !glad_glActiveTexture || !glad_glDeleteVertexArrays ||
         !glad_glDeleteBuffers ||
-        !glad_glGetIntegerv) {
+        !glad_glGetIntegerv || !glad_glBufferStorage || !glad_glMapBufferRange || !glad_glUnmapBuffer ||
+        !glad_glCopyBufferSubData || !glad_glDrawElementsBaseVertex || !glad_glFenceSync ||
+        !glad_glClientWaitSync || !glad_glDeleteSync || !glad_glMultiDrawElementsIndirect ||
+        !glad_glTexStorage3D || !glad_glTexSubImage3D || !glad_glGenerateMipmap || !glad_glVertexAttribIPointer) {
         fprintf(stderr, "[glad] Failed to load one or more OpenGL functions.\n");
         return 0;
     }